@@ -16,17 +16,21 @@ COMPILE_ARGS = ("-Wall -g -O2 -shared -fPIC"
                 " -flto -fwhole-program -fno-use-linker-plugin"
                 " -o %s %s")
 SSE_FLAGS = "-mfpmath=sse -msse2"
+AVX2_FLAGS = "-mavx2"
 SOURCE_FILES = [
     'pyhelper.c', 'serialqueue.c', 'stepcompress.c', 'steppersync.c',
-    'itersolve.c', 'trapq.c', 'pollreactor.c', 'msgblock.c', 'trdispatch.c',
-    'kin_cartesian.c', 'kin_corexy.c', 'kin_corexz.c', 'kin_delta.c',
-    'kin_deltesian.c', 'kin_polar.c', 'kin_rotary_delta.c', 'kin_winch.c',
-    'kin_extruder.c', 'kin_shaper.c', 'kin_idex.c', 'kin_generic.c'
+    'itersolve.c', 'trapq.c', 'pollreactor.c', 'msgblock.c', 'mempool.c',
+    'trdispatch.c', 'kin_cartesian.c', 'kin_corexy.c', 'kin_corexz.c',
+    'kin_delta.c', 'kin_deltesian.c', 'kin_polar.c', 'kin_rotary_delta.c',
+    'kin_winch.c', 'kin_extruder.c', 'kin_shaper.c', 'kin_idex.c',
+    'kin_generic.c', 'bulkqueue.c', 'lookahead.c', 'gcodeparse.c',
+    'filereader.c', 'gcodecache.c',
 ]
 DEST_LIB = "c_helper.so"
 OTHER_FILES = [
     'list.h', 'serialqueue.h', 'stepcompress.h', 'steppersync.h',
-    'itersolve.h', 'pyhelper.h', 'trapq.h', 'pollreactor.h', 'msgblock.h'
+    'itersolve.h', 'pyhelper.h', 'trapq.h', 'pollreactor.h', 'msgblock.h',
+    'mempool.h', 'gcodeparse.h'
 ]
 
 defs_stepcompress = """
@@ -41,6 +45,8 @@ defs_stepcompress = """
         , int32_t set_next_step_dir_msgtag);
     void stepcompress_set_invert_sdir(struct stepcompress *sc
         , uint32_t invert_sdir);
+    void stepcompress_set_incremental(struct stepcompress *sc
+        , uint32_t incremental);
     int stepcompress_reset(struct stepcompress *sc, uint64_t last_step_clock);
     int stepcompress_set_last_position(struct stepcompress *sc
         , uint64_t clock, int64_t last_position);
@@ -67,8 +73,14 @@ defs_steppersync = """
         , double time_offset, double mcu_freq);
     struct steppersyncmgr *steppersyncmgr_alloc(void);
     void steppersyncmgr_free(struct steppersyncmgr *ssm);
+    int steppersyncmgr_setup_workers(struct steppersyncmgr *ssm
+        , int num_workers, int batch);
     struct steppersync *steppersyncmgr_alloc_steppersync(
         struct steppersyncmgr *ssm);
+    void steppersyncmgr_get_stats(struct steppersyncmgr *ssm
+        , char *buf, int len);
+    double steppersyncmgr_get_gen_steps_cpu_time(
+        struct steppersyncmgr *ssm, struct stepper_kinematics *sk);
     int32_t steppersyncmgr_gen_steps(struct steppersyncmgr *ssm
         , double flush_time, double gen_steps_time, double clear_history_time);
 """
@@ -87,6 +99,7 @@ defs_itersolve = """
     double itersolve_get_commanded_pos(struct stepper_kinematics *sk);
     double itersolve_get_gen_steps_pre_active(struct stepper_kinematics *sk);
     double itersolve_get_gen_steps_post_active(struct stepper_kinematics *sk);
+    void itersolve_set_analytic(struct stepper_kinematics *sk, int enable);
 """
 
 defs_trapq = """
@@ -160,14 +173,20 @@ defs_kin_extruder = """
     void extruder_stepper_free(struct stepper_kinematics *sk);
     void extruder_set_pressure_advance(struct stepper_kinematics *sk
         , double print_time, double pressure_advance, double smooth_time);
+    void extruder_set_integral_cache(struct stepper_kinematics *sk
+        , int enable);
 """
 
 defs_kin_shaper = """
     int input_shaper_set_shaper_params(struct stepper_kinematics *sk, char axis
         , int n, double a[], double t[]);
+    int input_shaper_set_smoother_params(struct stepper_kinematics *sk
+        , char axis, int n, double c[], double t_sm);
     int input_shaper_set_sk(struct stepper_kinematics *sk
         , struct stepper_kinematics *orig_sk);
     void input_shaper_update_sk(struct stepper_kinematics *sk);
+    void input_shaper_set_segments(struct stepper_kinematics *sk
+        , int enable);
     struct stepper_kinematics * input_shaper_alloc(void);
 """
 
@@ -181,11 +200,17 @@ defs_kin_idex = """
 
 defs_serialqueue = """
     #define MESSAGE_MAX 64
+    #define MSGPARSER_MAX_PARAMS 16
+    struct msgparser_record {
+        int32_t msgid, param_count;
+        int64_t values[MSGPARSER_MAX_PARAMS];
+    };
     struct pull_queue_message {
         uint8_t msg[MESSAGE_MAX];
         int len;
         double sent_time, receive_time;
         uint64_t notify_id;
+        struct msgparser_record rec;
     };
 
     struct serialqueue *serialqueue_alloc(int serial_fd, char serial_fd_type
@@ -197,12 +222,17 @@ defs_serialqueue = """
     void serialqueue_send(struct serialqueue *sq, struct command_queue *cq
         , uint8_t *msg, int len, uint64_t min_clock, uint64_t req_clock
         , uint64_t notify_id);
+    void serialqueue_set_msgparser(struct serialqueue *sq
+        , struct msgparser *mp);
+    int serialqueue_pull_batch(struct serialqueue *sq
+        , struct pull_queue_message *pqms, int max);
     void serialqueue_pull(struct serialqueue *sq
         , struct pull_queue_message *pqm);
     void serialqueue_set_wire_frequency(struct serialqueue *sq
         , double frequency);
     void serialqueue_set_receive_window(struct serialqueue *sq
         , int receive_window);
+    void serialqueue_set_adaptive(struct serialqueue *sq, int adaptive);
     void serialqueue_set_clock_est(struct serialqueue *sq, double est_freq
         , double conv_time, uint64_t conv_clock, uint64_t last_clock);
     void serialqueue_get_stats(struct serialqueue *sq, char *buf, int len);
@@ -223,6 +253,100 @@ defs_trdispatch = """
         , uint64_t expire_ticks, uint64_t min_extend_ticks);
 """
 
+defs_bulkqueue = """
+    #define MESSAGE_PAYLOAD_MAX 59
+    struct bulkqueue_block {
+        uint16_t sequence;
+        uint8_t data_len;
+        uint8_t data[MESSAGE_PAYLOAD_MAX];
+    };
+
+    struct bulkqueue *bulkqueue_alloc(struct serialqueue *sq, uint32_t msgtag
+        , uint32_t oid, int block_count);
+    void bulkqueue_free(struct bulkqueue *bq);
+    int bulkqueue_peek(struct bulkqueue *bq
+        , struct bulkqueue_block **pblocks);
+    void bulkqueue_release(struct bulkqueue *bq, int count);
+    void bulkqueue_clear(struct bulkqueue *bq);
+    uint32_t bulkqueue_get_dropped(struct bulkqueue *bq);
+"""
+
+defs_lookahead = """
+    struct lookahead_move {
+        double start_pos[3], axes_r[3];
+        double move_d, accel, junction_deviation;
+        double max_cruise_v2, delta_v2, mcr_delta_v2, next_junction_v2;
+        int is_kinematic_move;
+        double max_start_v2, max_mcr_start_v2;
+        double start_v, cruise_v, end_v;
+        double accel_t, cruise_t, decel_t;
+        double flush_start_v2, flush_cruise_v2, flush_next_start_v2;
+    };
+
+    struct lookahead *lookahead_alloc(void);
+    void lookahead_free(struct lookahead *la);
+    void lookahead_reset(struct lookahead *la);
+    int lookahead_add_move(struct lookahead *la
+        , double start_x, double start_y, double start_z
+        , double axes_r_x, double axes_r_y, double axes_r_z
+        , double move_d, double accel, double junction_deviation
+        , double max_cruise_v2, double mcr_delta_v2
+        , int is_kinematic_move, double extra_axes_v2);
+    void lookahead_limit_next_junction(struct lookahead *la, double v2);
+    int lookahead_flush(struct lookahead *la, int lazy);
+    struct lookahead_move *lookahead_get_moves(struct lookahead *la);
+    double lookahead_queue_moves(struct lookahead *la, struct trapq *tq
+        , double print_time);
+"""
+
+defs_gcodeparse = """
+    struct gcode_move_fields {
+        uint32_t mask;
+        double values[26];
+    };
+
+    int gcodeparse_move(const char *line, struct gcode_move_fields *f);
+"""
+
+defs_filereader = """
+    struct filereader *filereader_alloc(int fd, uint64_t pos);
+    void filereader_free(struct filereader *fr);
+    void filereader_seek(struct filereader *fr, uint64_t pos);
+    int filereader_pull(struct filereader *fr, char *data, int size
+        , uint64_t *line_ends, int max_lines);
+"""
+
+defs_gcodecache = """
+    struct gcodecache_entry {
+        uint64_t end_pos;
+        int32_t gnum;
+        uint32_t text_offset, text_len;
+        struct gcode_move_fields fields;
+    };
+
+    struct gcodecache_compile *gcodecache_compile_alloc(int src_fd
+        , int dst_fd);
+    int gcodecache_compile_check(struct gcodecache_compile *cc);
+    void gcodecache_compile_free(struct gcodecache_compile *cc);
+    int gcodecache_check(int fd, int src_fd);
+    struct gcodecache_reader *gcodecache_reader_alloc(int fd, int src_fd);
+    void gcodecache_reader_free(struct gcodecache_reader *gr);
+    int gcodecache_reader_seek(struct gcodecache_reader *gr, uint64_t pos);
+    int gcodecache_reader_pull(struct gcodecache_reader *gr
+        , struct gcodecache_entry *entries, int max_entries
+        , char *text, int text_size);
+"""
+
+defs_msgblock = """
+    uint16_t msgblock_crc16_ccitt(uint8_t *buf, uint8_t len);
+    struct msgparser *msgparser_alloc(void);
+    void msgparser_free(struct msgparser *mp);
+    int msgparser_add_message(struct msgparser *mp, int msgid
+        , char *param_types);
+    int msgparser_parse(struct msgparser *mp, uint8_t *msg, int msg_len
+        , struct msgparser_record *rec);
+"""
+
 defs_pyhelper = """
     void set_python_logging_callback(void (*func)(const char *));
     double get_monotonic(void);
@@ -239,7 +363,8 @@ defs_all = [
     defs_kin_cartesian, defs_kin_corexy, defs_kin_corexz, defs_kin_delta,
     defs_kin_deltesian, defs_kin_polar, defs_kin_rotary_delta, defs_kin_winch,
     defs_kin_extruder, defs_kin_shaper, defs_kin_idex,
-    defs_kin_generic_cartesian,
+    defs_kin_generic_cartesian, defs_msgblock, defs_bulkqueue,
+    defs_lookahead, defs_gcodeparse, defs_filereader, defs_gcodecache,
 ]
 
 # Update filenames to an absolute path
@@ -270,6 +395,25 @@ def check_gcc_option(option):
     res = os.system(cmd)
     return res == 0
 
+# Check if the local cpu reports support for a particular instruction set
+def check_cpu_flag(flag):
+    try:
+        with open("/proc/cpuinfo", "r") as f:
+            for line in f:
+                if line.startswith("flags"):
+                    return flag in line.split()
+    except (IOError, OSError):
+        pass
+    return False
+
+# Determine the cpu specific compiler flags (SSE2 and AVX2 vector support)
+def get_cpu_flags():
+    if not check_gcc_option(SSE_FLAGS):
+        return ""
+    if check_gcc_option(AVX2_FLAGS) and check_cpu_flag("avx2"):
+        return "%s %s" % (SSE_FLAGS, AVX2_FLAGS)
+    return SSE_FLAGS
+
 # Check if the current gcc version supports a particular command-line option
 def do_build_code(cmd):
     res = os.system(cmd)
@@ -288,10 +432,7 @@ def check_build_c_library():
         # Code already built
         return destlib
     # Select command line options
-    if check_gcc_option(SSE_FLAGS):
-        cmd = "%s %s %s" % (GCC_CMD, SSE_FLAGS, COMPILE_ARGS)
-    else:
-        cmd = "%s %s" % (GCC_CMD, COMPILE_ARGS)
+    cmd = "%s %s %s" % (GCC_CMD, get_cpu_flags(), COMPILE_ARGS)
     # Invoke compiler
     logging.info("Building C code module %s", DEST_LIB)
     tempdestlib = get_abs_files(srcdir, ["_temp_" + DEST_LIB])[0]
@@ -326,6 +467,31 @@ def get_ffi():
     return FFI_main, FFI_lib
 
 
+######################################################################
+# Step compression benchmark tool
+######################################################################
+
+BENCH_COMPILE_ARGS = "-Wall -g -O2 -o %s %s -lm"
+BENCH_SOURCE_FILES = [
+    'bench_stepcompress.c', 'stepcompress.c', 'msgblock.c', 'mempool.c',
+    'pyhelper.c'
+]
+BENCH_TARGET = "bench_stepcompress"
+
+# Build the standalone stepcompress benchmark program
+def check_build_bench_stepcompress():
+    srcdir = os.path.dirname(os.path.realpath(__file__))
+    srcfiles = get_abs_files(srcdir, BENCH_SOURCE_FILES)
+    ofiles = get_abs_files(srcdir, OTHER_FILES)
+    destbin = get_abs_files(srcdir, [BENCH_TARGET])[0]
+    if not check_build_code(srcfiles+ofiles+[__file__], destbin):
+        return destbin
+    cmd = "%s %s %s" % (GCC_CMD, get_cpu_flags(), BENCH_COMPILE_ARGS)
+    logging.info("Building C code module %s", BENCH_TARGET)
+    do_build_code(cmd % (destbin, ' '.join(srcfiles)))
+    return destbin
+
+
 ######################################################################
 # hub-ctrl hub power controller
 ######################################################################
@@ -0,0 +1,380 @@
+// Offline benchmark of the stepper pulse schedule compression code
+//
+// Copyright (C) 2026  Kevin O'Connor <kevin@koconnor.net>
+//
+// This file may be distributed under the terms of the GNU GPLv3 license.
+
+// This tool replays the step times found in a batch mode output file
+// (as translated to text by parsedump.py) through the stepcompress.c
+// code and reports on the cost and efficiency of the compression.
+// With the "-c" option it also decodes the generated messages and
+// verifies that every step is scheduled within max_error of its
+// requested time.
+// It is not part of c_helper.so - it is built as a standalone program
+// (see chelper/__init__.py) so it can be run without a printer.
+
+#include <getopt.h> // getopt
+#include <stddef.h> // offsetof
+#include <stdint.h> // uint64_t
+#include <stdio.h> // fprintf
+#include <stdlib.h> // malloc
+#include <string.h> // memset
+#include <time.h> // clock_gettime
+#include "list.h" // list_head
+#include "mempool.h" // mempool_alloc
+#include "msgblock.h" // struct queue_message
+#include "stepcompress.h" // stepcompress_alloc
+
+#define MAX_OIDS 256
+#define QUEUE_STEP_TAG 1
+#define SET_NEXT_STEP_DIR_TAG 2
+
+// Recorded step times for a single stepper
+struct bench_stepper {
+    uint64_t *clocks;
+    uint8_t *dirs, *resets;
+    int count, alloc;
+    // Replay state
+    uint64_t last_clock;
+    int dir;
+    // Results
+    double cpu_time;
+    uint64_t first_clock, end_clock;
+    int queue_steps, dir_msgs, msg_steps;
+    uint32_t digest;
+    // Verification of the generated messages (see check_msg())
+    uint64_t check_clock;
+    int check_dir, check_pos, check_errors;
+    uint32_t check_max_error;
+};
+
+static struct bench_stepper *steppers[MAX_OIDS];
+
+
+/****************************************************************
+ * Input parsing
+ ****************************************************************/
+
+static struct bench_stepper *
+lookup_stepper(unsigned int oid)
+{
+    if (oid >= MAX_OIDS) {
+        fprintf(stderr, "Invalid oid %u\n", oid);
+        exit(1);
+    }
+    struct bench_stepper *bs = steppers[oid];
+    if (!bs) {
+        bs = steppers[oid] = malloc(sizeof(*bs));
+        memset(bs, 0, sizeof(*bs));
+    }
+    return bs;
+}
+
+static void
+add_step(struct bench_stepper *bs, uint64_t clock, int is_reset)
+{
+    if (bs->count >= bs->alloc) {
+        bs->alloc = bs->alloc ? bs->alloc * 2 : 1024;
+        bs->clocks = realloc(bs->clocks, bs->alloc * sizeof(*bs->clocks));
+        bs->dirs = realloc(bs->dirs, bs->alloc * sizeof(*bs->dirs));
+        bs->resets = realloc(bs->resets, bs->alloc * sizeof(*bs->resets));
+    }
+    bs->clocks[bs->count] = clock;
+    bs->dirs[bs->count] = bs->dir;
+    bs->resets[bs->count] = is_reset;
+    bs->count++;
+}
+
+// Expand the queue_step commands found in a parsedump.py text file
+static int
+read_steps(FILE *f)
+{
+    char *line = NULL;
+    size_t len = 0;
+    unsigned int oid, count, dir;
+    unsigned long long clock;
+    uint32_t interval;
+    int add;
+    while (getline(&line, &len, f) >= 0) {
+        if (sscanf(line, "queue_step oid=%u interval=%u count=%u add=%d"
+                   , &oid, &interval, &count, &add) == 4) {
+            struct bench_stepper *bs = lookup_stepper(oid);
+            while (count--) {
+                bs->last_clock += interval;
+                add_step(bs, bs->last_clock, 0);
+                interval += add;
+            }
+        } else if (sscanf(line, "set_next_step_dir oid=%u dir=%u"
+                          , &oid, &dir) == 2) {
+            lookup_stepper(oid)->dir = dir;
+        } else if (sscanf(line, "reset_step_clock oid=%u clock=%llu"
+                          , &oid, &clock) == 2) {
+            struct bench_stepper *bs = lookup_stepper(oid);
+            // Note the reset in the step stream (steps must be at clock)
+            bs->last_clock = clock;
+            add_step(bs, clock, 1);
+        }
+    }
+    free(line);
+    return 0;
+}
+
+
+/****************************************************************
+ * Compression replay
+ ****************************************************************/
+
+static double
+get_cpu_time(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * .000000001;
+}
+
+// Report a step that does not match the requested step stream
+static void
+check_error(struct bench_stepper *bs, const char *msg, uint64_t clock)
+{
+    if (bs->check_errors++ < 10)
+        fprintf(stderr, "check error: %s at step %d (clock %llu)\n"
+                , msg, bs->check_pos, (unsigned long long)clock);
+}
+
+// Decode a message and verify its steps against the requested steps
+static void
+check_msg(struct bench_stepper *bs, struct queue_message *qm
+          , uint32_t max_error)
+{
+    uint8_t *p = qm->msg, *end = &qm->msg[qm->len];
+    int64_t params[5];
+    int i, count = qm->msg[0] == QUEUE_STEP_TAG ? 5 : 3;
+    for (i=0; i<count; i++) {
+        if (msgblock_parse_int(&p, end, &params[i])) {
+            check_error(bs, "malformed message", bs->check_clock);
+            return;
+        }
+    }
+    if (params[0] == SET_NEXT_STEP_DIR_TAG) {
+        bs->check_dir = params[2];
+        return;
+    }
+    uint32_t interval = params[2];
+    int steps = params[3], add = params[4];
+    while (steps--) {
+        bs->check_clock += interval;
+        interval += add;
+        while (bs->check_pos < bs->count && bs->resets[bs->check_pos])
+            bs->check_pos++;
+        if (bs->check_pos >= bs->count) {
+            check_error(bs, "extra step", bs->check_clock);
+            continue;
+        }
+        uint64_t req = bs->clocks[bs->check_pos];
+        if (bs->check_clock > req || bs->check_clock + max_error < req)
+            check_error(bs, "step time out of range", bs->check_clock);
+        else if (req - bs->check_clock > bs->check_max_error)
+            bs->check_max_error = req - bs->check_clock;
+        if (bs->check_dir != bs->dirs[bs->check_pos])
+            check_error(bs, "wrong step direction", bs->check_clock);
+        bs->check_pos++;
+    }
+}
+
+// Account for (and free) the messages generated by stepcompress
+static void
+process_msgs(struct bench_stepper *bs, struct list_head *msg_queue
+             , int check, uint32_t max_error)
+{
+    while (!list_empty(msg_queue)) {
+        struct queue_message *qm = list_first_entry(
+            msg_queue, struct queue_message, node);
+        list_del(&qm->node);
+        if (check)
+            check_msg(bs, qm, max_error);
+        if (qm->msg[0] == QUEUE_STEP_TAG) {
+            // Extract the 'count' field (fourth vlq in the message)
+            uint8_t *p = qm->msg;
+            int field = 0;
+            uint32_t v = 0;
+            while (field < 4) {
+                uint8_t c = *p++;
+                v = (v << 7) | (c & 0x7f);
+                if (!(c & 0x80)) {
+                    field++;
+                    if (field < 4)
+                        v = 0;
+                }
+            }
+            bs->queue_steps++;
+            bs->msg_steps += v;
+        } else if (qm->msg[0] == SET_NEXT_STEP_DIR_TAG) {
+            bs->dir_msgs++;
+        }
+        // FNV-1a digest of the message content
+        int i;
+        for (i=0; i<qm->len; i++)
+            bs->digest = (bs->digest ^ qm->msg[i]) * 16777619;
+        message_free(qm);
+    }
+}
+
+static int
+replay_stepper(struct bench_stepper *bs, int oid, double mcu_freq
+               , uint32_t max_error, double flush_time, int incremental
+               , int check)
+{
+    struct list_head msg_queue;
+    list_init(&msg_queue);
+    struct mempool *msg_pool = mempool_alloc(sizeof(struct queue_message));
+    struct stepcompress *sc = stepcompress_alloc(&msg_queue, msg_pool);
+    stepcompress_fill(sc, oid, max_error, QUEUE_STEP_TAG
+                      , SET_NEXT_STEP_DIR_TAG);
+    stepcompress_set_time(sc, 0., mcu_freq);
+    stepcompress_set_incremental(sc, incremental);
+    bs->digest = 2166136261;
+    bs->check_clock = bs->check_pos = bs->check_errors = 0;
+    bs->check_dir = -1;
+    bs->check_max_error = 0;
+    bs->first_clock = bs->count ? bs->clocks[0] : 0;
+    uint64_t flush_ticks = flush_time * mcu_freq;
+    uint64_t next_flush = bs->first_clock + flush_ticks;
+    double start_time = get_cpu_time();
+    int i, ret = 0;
+    for (i=0; i<bs->count; i++) {
+        uint64_t clock = bs->clocks[i];
+        if (clock >= next_flush) {
+            // Periodically flush (similar to steppersyncmgr_gen_steps)
+            ret = stepcompress_flush(sc, next_flush);
+            if (ret)
+                goto done;
+            process_msgs(bs, &msg_queue, check, max_error);
+            next_flush = clock + flush_ticks;
+        }
+        if (bs->resets[i]) {
+            ret = stepcompress_reset(sc, clock);
+            if (ret)
+                goto done;
+            process_msgs(bs, &msg_queue, check, max_error);
+            bs->check_clock = clock;
+            continue;
+        }
+        ret = stepcompress_append(sc, bs->dirs[i], 0., clock / mcu_freq);
+        if (ret)
+            goto done;
+    }
+    ret = stepcompress_flush(sc, UINT64_MAX);
+    process_msgs(bs, &msg_queue, check, max_error);
+    if (check) {
+        while (bs->check_pos < bs->count && bs->resets[bs->check_pos])
+            bs->check_pos++;
+        if (bs->check_pos < bs->count)
+            check_error(bs, "missing step", bs->check_clock);
+    }
+done:
+    bs->cpu_time += get_cpu_time() - start_time;
+    bs->end_clock = bs->count ? bs->clocks[bs->count-1] : 0;
+    stepcompress_free(sc);
+    message_queue_free(&msg_queue);
+    mempool_free(msg_pool);
+    return ret;
+}
+
+
+/****************************************************************
+ * Startup
+ ****************************************************************/
+
+static void
+usage(const char *prog)
+{
+    fprintf(stderr, "Usage: %s [-f mcu_freq] [-e max_error] [-t flush_time]"
+            " [-r repeat] [-i] [-c] <parsedump output>\n", prog);
+    exit(1);
+}
+
+int
+main(int argc, char **argv)
+{
+    double mcu_freq = 16000000., max_error_time = .000025, flush_time = .050;
+    int repeat = 1, incremental = 0, check = 0, opt;
+    while ((opt = getopt(argc, argv, "f:e:t:r:ic")) != -1) {
+        switch (opt) {
+        case 'f': mcu_freq = atof(optarg); break;
+        case 'e': max_error_time = atof(optarg); break;
+        case 't': flush_time = atof(optarg); break;
+        case 'r': repeat = atoi(optarg); break;
+        case 'i': incremental = 1; break;
+        case 'c': check = 1; break;
+        default: usage(argv[0]);
+        }
+    }
+    if (optind + 1 != argc || mcu_freq <= 0. || repeat < 1)
+        usage(argv[0]);
+    FILE *f = fopen(argv[optind], "r");
+    if (!f) {
+        perror("fopen");
+        return 1;
+    }
+    read_steps(f);
+    fclose(f);
+
+    uint32_t max_error = max_error_time * mcu_freq;
+    printf("mcu_freq=%.0f max_error=%u ticks flush_time=%.3f repeat=%d"
+           " incremental=%d\n"
+           , mcu_freq, max_error, flush_time, repeat, incremental);
+    uint64_t total_steps = 0, total_msgs = 0, total_msg_steps = 0;
+    double total_cpu = 0., max_print_time = 0.;
+    int oid, r, check_errors = 0;
+    for (oid=0; oid<MAX_OIDS; oid++) {
+        struct bench_stepper *bs = steppers[oid];
+        if (!bs || !bs->count)
+            continue;
+        for (r=0; r<repeat; r++) {
+            bs->queue_steps = bs->dir_msgs = bs->msg_steps = 0;
+            int ret = replay_stepper(bs, oid, mcu_freq, max_error, flush_time
+                                     , incremental, check);
+            if (ret) {
+                fprintf(stderr, "stepcompress error %d on oid=%d\n", ret, oid);
+                return 1;
+            }
+        }
+        if (check) {
+            printf("oid=%d check: errors=%d max_step_error=%u ticks\n"
+                   , oid, bs->check_errors, bs->check_max_error);
+            check_errors += bs->check_errors;
+        }
+        double cpu = bs->cpu_time / repeat;
+        double print_time = (bs->end_clock - bs->first_clock) / mcu_freq;
+        if (print_time > max_print_time)
+            max_print_time = print_time;
+        printf("oid=%d steps=%d queue_step=%d set_next_step_dir=%d"
+               " count_avg=%.2f ns_per_step=%.1f digest=%08x\n"
+               , oid, bs->count, bs->queue_steps, bs->dir_msgs
+               , bs->queue_steps ? (double)bs->msg_steps / bs->queue_steps : 0.
+               , cpu * 1000000000. / bs->count, bs->digest);
+        total_steps += bs->count;
+        total_msgs += bs->queue_steps;
+        total_msg_steps += bs->msg_steps;
+        total_cpu += cpu;
+    }
+    if (check_errors) {
+        printf("ERROR: %d steps did not match the requested step times\n"
+               , check_errors);
+        return 1;
+    }
+    if (!total_steps || total_cpu <= 0.) {
+        printf("No steps found\n");
+        return 0;
+    }
+    printf("total: steps=%llu queue_step=%llu count_avg=%.2f\n"
+           , (unsigned long long)total_steps, (unsigned long long)total_msgs
+           , total_msgs ? (double)total_msg_steps / total_msgs : 0.);
+    printf("cpu: %.6fs ns_per_step=%.1f steps/sec=%.0f queue_step/sec=%.0f\n"
+           , total_cpu, total_cpu * 1000000000. / total_steps
+           , total_steps / total_cpu, total_msgs / total_cpu);
+    if (max_print_time > 0.)
+        printf("print time: %.3fs queue_step/sec=%.0f\n"
+               , max_print_time, total_msgs / max_print_time);
+    return 0;
+}
@@ -0,0 +1,164 @@
+// Storage of "sensor_bulk_data" messages in a ring buffer
+//
+// Copyright (C) 2026  Kevin O'Connor <kevin@koconnor.net>
+//
+// This file may be distributed under the terms of the GNU GPLv3 license.
+
+// Bulk sensors may report thousands of measurements per second.  The
+// code here registers a serialqueue fastreader that stores the
+// payload of each matching sensor_bulk_data message directly into a
+// preallocated ring buffer (from the serialqueue background thread).
+// The host python code can then periodically process the stored
+// blocks in place without having to parse each message.  Stored
+// messages are not added to the serialqueue receive queue, so they
+// are also not reported in the "Dumping receive queue" debug output.
+
+#include <pthread.h> // pthread_mutex_lock
+#include <stddef.h> // offsetof
+#include <stdlib.h> // malloc
+#include <string.h> // memset
+#include "compiler.h" // ARRAY_SIZE
+#include "pyhelper.h" // report_errno
+#include "serialqueue.h" // serialqueue_add_fastreader
+
+struct bulkqueue_block {
+    uint16_t sequence;
+    uint8_t data_len;
+    uint8_t data[MESSAGE_PAYLOAD_MAX];
+};
+
+struct bulkqueue {
+    struct fastreader fr;
+    struct serialqueue *sq;
+    struct bulkqueue_block *blocks;
+    uint32_t block_count;
+
+    pthread_mutex_t lock; // protects variables below
+    uint64_t head, tail;
+    uint32_t dropped;
+};
+
+// Handle a sensor_bulk_data message (callback from serialqueue fastreader)
+static void
+handle_bulk_data(struct fastreader *fr, uint8_t *data, int len)
+{
+    struct bulkqueue *bq = container_of(fr, struct bulkqueue, fr);
+
+    // Parse: sensor_bulk_data oid=%c sequence=%hu data=%*s
+    uint8_t *p = &data[MESSAGE_HEADER_SIZE + fr->prefix_len];
+    uint8_t *end = &data[len - MESSAGE_TRAILER_SIZE];
+    int64_t sequence;
+    int ret = msgblock_parse_int(&p, end, &sequence);
+    if (ret || p >= end || p + 1 + *p != end)
+        return;
+    uint8_t data_len = *p++;
+
+    // Store message in ring buffer
+    pthread_mutex_lock(&bq->lock);
+    if (bq->head - bq->tail >= bq->block_count) {
+        bq->dropped++;
+        pthread_mutex_unlock(&bq->lock);
+        return;
+    }
+    uint32_t pos = bq->head % bq->block_count;
+    pthread_mutex_unlock(&bq->lock);
+    // The block at 'pos' is not visible to readers until head advances
+    struct bulkqueue_block *b = &bq->blocks[pos];
+    b->sequence = sequence;
+    b->data_len = data_len;
+    memcpy(b->data, p, data_len);
+    pthread_mutex_lock(&bq->lock);
+    bq->head++;
+    pthread_mutex_unlock(&bq->lock);
+}
+
+// Create a new 'struct bulkqueue' object
+struct bulkqueue * __visible
+bulkqueue_alloc(struct serialqueue *sq, uint32_t msgtag, uint32_t oid
+                , int block_count)
+{
+    struct bulkqueue *bq = malloc(sizeof(*bq));
+    memset(bq, 0, sizeof(*bq));
+    bq->blocks = malloc(sizeof(*bq->blocks) * block_count);
+    bq->block_count = block_count;
+
+    int ret = pthread_mutex_init(&bq->lock, NULL);
+    if (ret) {
+        report_errno("bulkqueue_alloc pthread_mutex_init", ret);
+        free(bq->blocks);
+        free(bq);
+        return NULL;
+    }
+
+    // Setup fastreader to match sensor_bulk_data messages
+    uint32_t prefix[] = {msgtag, oid};
+    struct queue_message *dummy = message_alloc_and_encode(
+        prefix, ARRAY_SIZE(prefix));
+    memcpy(bq->fr.prefix, dummy->msg, dummy->len);
+    bq->fr.prefix_len = dummy->len;
+    free(dummy);
+    bq->fr.func = handle_bulk_data;
+    bq->fr.is_exclusive = 1;
+
+    bq->sq = sq;
+    serialqueue_add_fastreader(sq, &bq->fr);
+    return bq;
+}
+
+// Free all resources associated with a bulkqueue
+void __visible
+bulkqueue_free(struct bulkqueue *bq)
+{
+    if (!bq)
+        return;
+    serialqueue_rm_fastreader(bq->sq, &bq->fr);
+    pthread_mutex_destroy(&bq->lock);
+    free(bq->blocks);
+    free(bq);
+}
+
+// Return the number of stored blocks that are contiguous in memory
+// (along with a pointer to the first block).  The blocks remain valid
+// until they are released with bulkqueue_release().
+int __visible
+bulkqueue_peek(struct bulkqueue *bq, struct bulkqueue_block **pblocks)
+{
+    pthread_mutex_lock(&bq->lock);
+    uint32_t count = bq->head - bq->tail, pos = bq->tail % bq->block_count;
+    pthread_mutex_unlock(&bq->lock);
+    if (count > bq->block_count - pos)
+        count = bq->block_count - pos;
+    *pblocks = &bq->blocks[pos];
+    return count;
+}
+
+// Release blocks previously obtained with bulkqueue_peek()
+void __visible
+bulkqueue_release(struct bulkqueue *bq, int count)
+{
+    pthread_mutex_lock(&bq->lock);
+    if (count < 0 || count > bq->head - bq->tail)
+        count = bq->head - bq->tail;
+    bq->tail += count;
+    pthread_mutex_unlock(&bq->lock);
+}
+
+// Discard all stored blocks and reset the dropped block counter
+void __visible
+bulkqueue_clear(struct bulkqueue *bq)
+{
+    pthread_mutex_lock(&bq->lock);
+    bq->tail = bq->head;
+    bq->dropped = 0;
+    pthread_mutex_unlock(&bq->lock);
+}
+
+// Return the number of messages discarded due to a full ring buffer
+uint32_t __visible
+bulkqueue_get_dropped(struct bulkqueue *bq)
+{
+    pthread_mutex_lock(&bq->lock);
+    uint32_t dropped = bq->dropped;
+    pthread_mutex_unlock(&bq->lock);
+    return dropped;
+}
@@ -0,0 +1,248 @@
+// Background readahead of g-code files
+//
+// Copyright (C) 2026  Kevin O'Connor <kevin@koconnor.net>
+//
+// This file may be distributed under the terms of the GNU GPLv3 license.
+
+// The virtual_sdcard code processes a g-code file one line at a time.
+// The code here reads the file in a background thread, locates the
+// line boundaries, and provides batches of complete lines (along with
+// the file position following each line) to the python code.  This
+// keeps file i/o latency out of the main thread.
+
+#include <errno.h> // errno
+#include <fcntl.h> // posix_fadvise
+#include <pthread.h> // pthread_mutex_lock
+#include <stdint.h> // uint64_t
+#include <stdlib.h> // malloc
+#include <string.h> // memchr
+#include <unistd.h> // pread
+#include "compiler.h" // __visible
+#include "pyhelper.h" // errorf
+
+#define FR_BUFFER_SIZE (1024 * 1024)
+#define FR_READ_SIZE (64 * 1024)
+#define FR_LINE_COUNT 8192
+
+enum { FR_READING, FR_EOF, FR_ERROR };
+
+struct filereader {
+    int fd;
+    pthread_t tid;
+    pthread_mutex_t lock; // protects variables below
+    pthread_cond_t cond;
+    int must_exit, state;
+    uint32_t generation;
+    // Data buffer (a ring indexed by file offset)
+    uint64_t buf_start, buf_end, scan_pos;
+    char buffer[FR_BUFFER_SIZE];
+    // Queue of found lines (file offset after each line's newline)
+    uint64_t line_ends[FR_LINE_COUNT];
+    uint32_t line_head, line_tail;
+};
+
+
+/****************************************************************
+ * Background thread
+ ****************************************************************/
+
+// Locate newlines in data that has been read but not yet scanned
+static void
+scan_lines(struct filereader *fr)
+{
+    int found = 0;
+    while (fr->scan_pos < fr->buf_end
+           && fr->line_head - fr->line_tail < FR_LINE_COUNT) {
+        uint32_t offset = fr->scan_pos % FR_BUFFER_SIZE;
+        uint64_t len = fr->buf_end - fr->scan_pos;
+        if (len > FR_BUFFER_SIZE - offset)
+            len = FR_BUFFER_SIZE - offset;
+        char *start = &fr->buffer[offset];
+        char *nl = memchr(start, '\n', len);
+        if (!nl) {
+            fr->scan_pos += len;
+            continue;
+        }
+        fr->scan_pos += nl - start + 1;
+        fr->line_ends[fr->line_head++ % FR_LINE_COUNT] = fr->scan_pos;
+        found = 1;
+    }
+    if (found)
+        pthread_cond_broadcast(&fr->cond);
+}
+
+// Main background thread loop
+static void *
+background_thread(void *data)
+{
+    struct filereader *fr = data;
+    pthread_mutex_lock(&fr->lock);
+    while (!fr->must_exit) {
+        scan_lines(fr);
+        uint64_t used = fr->buf_end - fr->buf_start;
+        if (fr->state != FR_READING || used >= FR_BUFFER_SIZE
+            || fr->line_head - fr->line_tail >= FR_LINE_COUNT) {
+            if (fr->state == FR_READING && used >= FR_BUFFER_SIZE
+                && fr->line_head == fr->line_tail) {
+                errorf("filereader: line too long at position %llu"
+                       , (unsigned long long)fr->buf_start);
+                fr->state = FR_ERROR;
+                pthread_cond_broadcast(&fr->cond);
+            }
+            pthread_cond_wait(&fr->cond, &fr->lock);
+            continue;
+        }
+        // Read more data into the free space of the buffer
+        uint32_t generation = fr->generation;
+        uint64_t pos = fr->buf_end;
+        uint32_t offset = pos % FR_BUFFER_SIZE;
+        uint64_t len = FR_BUFFER_SIZE - used;
+        if (len > FR_BUFFER_SIZE - offset)
+            len = FR_BUFFER_SIZE - offset;
+        if (len > FR_READ_SIZE)
+            len = FR_READ_SIZE;
+        pthread_mutex_unlock(&fr->lock);
+        int ret = pread(fr->fd, &fr->buffer[offset], len, pos);
+        int read_errno = errno;
+        pthread_mutex_lock(&fr->lock);
+        if (generation != fr->generation)
+            // A seek occurred while reading - discard the data
+            continue;
+        if (ret < 0) {
+            if (read_errno == EINTR)
+                continue;
+            errno = read_errno;
+            report_errno("pread", ret);
+            fr->state = FR_ERROR;
+            pthread_cond_broadcast(&fr->cond);
+        } else if (!ret) {
+            fr->state = FR_EOF;
+            pthread_cond_broadcast(&fr->cond);
+        } else {
+            fr->buf_end += ret;
+        }
+    }
+    pthread_mutex_unlock(&fr->lock);
+    return NULL;
+}
+
+
+/****************************************************************
+ * Python interface
+ ****************************************************************/
+
+// Discard buffered data and restart reading at the given file position
+void __visible
+filereader_seek(struct filereader *fr, uint64_t pos)
+{
+    pthread_mutex_lock(&fr->lock);
+    fr->generation++;
+    fr->buf_start = fr->buf_end = fr->scan_pos = pos;
+    fr->line_head = fr->line_tail = 0;
+    fr->state = FR_READING;
+    pthread_cond_broadcast(&fr->cond);
+    pthread_mutex_unlock(&fr->lock);
+}
+
+// Copy the next available lines into 'data'.  The file position
+// following each line is stored in 'line_ends'.  Returns the number
+// of lines, 0 on end of file, or -1 on a read error.  This function
+// blocks until lines are available.
+int __visible
+filereader_pull(struct filereader *fr, char *data, int size
+                , uint64_t *line_ends, int max_lines)
+{
+    pthread_mutex_lock(&fr->lock);
+    while (fr->line_head == fr->line_tail && fr->state == FR_READING)
+        pthread_cond_wait(&fr->cond, &fr->lock);
+    uint64_t start = fr->buf_start;
+    int count = 0;
+    while (count < max_lines && fr->line_tail + count != fr->line_head) {
+        uint32_t idx = (fr->line_tail + count) % FR_LINE_COUNT;
+        uint64_t end = fr->line_ends[idx];
+        if (end - start > size)
+            break;
+        line_ends[count++] = end;
+    }
+    if (!count) {
+        int ret = 0;
+        if (fr->line_head != fr->line_tail) {
+            errorf("filereader: line too long at position %llu"
+                   , (unsigned long long)start);
+            ret = -1;
+        } else if (fr->state == FR_ERROR) {
+            ret = -1;
+        }
+        pthread_mutex_unlock(&fr->lock);
+        return ret;
+    }
+    // Copy the lines (the data may wrap around the end of the buffer)
+    uint64_t len = line_ends[count - 1] - start;
+    uint32_t offset = start % FR_BUFFER_SIZE;
+    uint64_t first = len;
+    if (first > FR_BUFFER_SIZE - offset)
+        first = FR_BUFFER_SIZE - offset;
+    memcpy(data, &fr->buffer[offset], first);
+    memcpy(&data[first], fr->buffer, len - first);
+    fr->buf_start += len;
+    fr->line_tail += count;
+    pthread_cond_broadcast(&fr->cond);
+    pthread_mutex_unlock(&fr->lock);
+    return count;
+}
+
+// Create a new 'struct filereader' object that reads from the given
+// file descriptor (starting at the given file position)
+struct filereader * __visible
+filereader_alloc(int fd, uint64_t pos)
+{
+    struct filereader *fr = malloc(sizeof(*fr));
+    if (!fr) {
+        errorf("filereader_alloc: out of memory");
+        return NULL;
+    }
+    memset(fr, 0, sizeof(*fr));
+    fr->fd = dup(fd);
+    if (fr->fd < 0) {
+        report_errno("dup", fr->fd);
+        free(fr);
+        return NULL;
+    }
+    posix_fadvise(fr->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    fr->buf_start = fr->buf_end = fr->scan_pos = pos;
+    int ret = pthread_mutex_init(&fr->lock, NULL);
+    if (ret)
+        goto fail;
+    ret = pthread_cond_init(&fr->cond, NULL);
+    if (ret)
+        goto fail;
+    ret = pthread_create(&fr->tid, NULL, background_thread, fr);
+    if (ret)
+        goto fail;
+    return fr;
+
+fail:
+    report_errno("init", ret);
+    close(fr->fd);
+    free(fr);
+    return NULL;
+}
+
+// Stop the background thread and free all resources
+void __visible
+filereader_free(struct filereader *fr)
+{
+    if (!fr)
+        return;
+    pthread_mutex_lock(&fr->lock);
+    fr->must_exit = 1;
+    pthread_cond_broadcast(&fr->cond);
+    pthread_mutex_unlock(&fr->lock);
+    int ret = pthread_join(fr->tid, NULL);
+    if (ret)
+        report_errno("pthread_join", ret);
+    close(fr->fd);
+    pthread_cond_destroy(&fr->cond);
+    pthread_mutex_destroy(&fr->lock);
+    free(fr);
+}
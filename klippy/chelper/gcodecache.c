@@ -0,0 +1,607 @@
+// Pre-parsed g-code file cache
+//
+// Copyright (C) 2026  Kevin O'Connor <kevin@koconnor.net>
+//
+// This file may be distributed under the terms of the GNU GPLv3 license.
+
+// A g-code file may be "compiled" into a cache file that contains one
+// record for each line of the original file.  Simple G0/G1 moves are
+// stored as pre-parsed numeric fields (see gcodeparse.c) and all
+// other lines are stored as text.  The length of each original line
+// is also stored so that original file positions are preserved, and
+// a sparse index allows a replay to start at any line of the file.
+// The cache file is stored in host byte order.  The header records
+// the identity of the original file (device, inode, size, and the
+// nanosecond modification and change times) and a cache is only used
+// if the original file still has that identity.  As the change time
+// is updated on every write (and can not be set from userspace), a
+// file that is modified in place is not mistaken for the original.
+
+#include <errno.h> // errno
+#include <pthread.h> // pthread_mutex_lock
+#include <stdint.h> // uint64_t
+#include <stdlib.h> // malloc
+#include <string.h> // memcpy
+#include <sys/stat.h> // fstat
+#include <unistd.h> // pread
+#include "compiler.h" // __visible
+#include "gcodeparse.h" // gcodeparse_move
+#include "pyhelper.h" // errorf
+
+#define GC_MAGIC 0x4343474b // "KGCC"
+#define GC_VERSION 2
+#define GC_INDEX_INTERVAL 1024
+#define GC_IO_SIZE (64 * 1024)
+#define GC_READ_SIZE (512 * 1024)
+#define GC_MAX_TEXT (256 * 1024)
+#define GC_TEXT 0xff
+
+#define FIELD_F_INDEX ('F' - 'A')
+
+struct gcodecache_source {
+    uint64_t dev, ino, size;
+    int64_t mtime_sec, mtime_nsec, ctime_sec, ctime_nsec;
+};
+
+struct gcodecache_header {
+    uint32_t magic, version;
+    struct gcodecache_source src;
+    uint64_t line_count, index_offset, index_count;
+};
+
+struct gcodecache_index {
+    uint64_t src_pos, cache_pos;
+};
+
+// Each record starts with a 'type' byte (G-Code number or GC_TEXT)
+// and a 32bit length of the original line (including its newline).
+// A move then has a 32bit field mask followed by a double for each
+// set bit.  A text record has the line contents (without newline).
+#define GC_RECORD_HEADER 5
+
+// Determine the identity of an original g-code file
+static int
+source_identity(int fd, struct gcodecache_source *src)
+{
+    struct stat st;
+    int ret = fstat(fd, &st);
+    if (ret) {
+        report_errno("fstat", ret);
+        return -1;
+    }
+    memset(src, 0, sizeof(*src));
+    src->dev = st.st_dev;
+    src->ino = st.st_ino;
+    src->size = st.st_size;
+    src->mtime_sec = st.st_mtim.tv_sec;
+    src->mtime_nsec = st.st_mtim.tv_nsec;
+    src->ctime_sec = st.st_ctim.tv_sec;
+    src->ctime_nsec = st.st_ctim.tv_nsec;
+    return 0;
+}
+
+// Read the header of a cache file and check that it is valid for the
+// given original file.  Returns 0 if valid or -1 otherwise.
+static int
+read_header(int fd, int src_fd, struct gcodecache_header *hdr)
+{
+    struct gcodecache_source src;
+    int ret = pread(fd, hdr, sizeof(*hdr), 0);
+    if (ret != sizeof(*hdr) || hdr->magic != GC_MAGIC
+        || hdr->version != GC_VERSION || source_identity(src_fd, &src)
+        || memcmp(&hdr->src, &src, sizeof(src)) || !hdr->index_count
+        || hdr->index_count > hdr->line_count / GC_INDEX_INTERVAL + 1)
+        return -1;
+    return 0;
+}
+
+
+/****************************************************************
+ * Cache creation
+ ****************************************************************/
+
+struct gcodecache_compile {
+    int src_fd, dst_fd;
+    struct gcodecache_source src;
+    pthread_t tid;
+    pthread_mutex_t lock; // protects variables below
+    int must_exit, result;
+    // Variables below are only used by the background thread
+    char *line;
+    uint32_t line_len, line_alloc;
+    uint64_t src_pos, line_count;
+    char out[GC_IO_SIZE];
+    uint32_t out_len;
+    uint64_t out_pos;
+    struct gcodecache_index *index;
+    uint64_t index_count, index_alloc;
+};
+
+// Write all data to the output file
+static int
+write_all(int fd, const char *data, uint64_t len, uint64_t pos)
+{
+    while (len) {
+        int ret = pwrite(fd, data, len, pos);
+        if (ret < 0) {
+            if (errno == EINTR)
+                continue;
+            report_errno("pwrite", ret);
+            return -1;
+        }
+        data += ret;
+        len -= ret;
+        pos += ret;
+    }
+    return 0;
+}
+
+// Flush buffered output
+static int
+out_flush(struct gcodecache_compile *cc)
+{
+    int ret = write_all(cc->dst_fd, cc->out, cc->out_len
+                        , cc->out_pos - cc->out_len);
+    cc->out_len = 0;
+    return ret;
+}
+
+// Add data to the output file
+static int
+out_append(struct gcodecache_compile *cc, const void *data, uint32_t len)
+{
+    if (cc->out_len + len > sizeof(cc->out)) {
+        if (out_flush(cc))
+            return -1;
+        if (len > sizeof(cc->out)) {
+            int ret = write_all(cc->dst_fd, data, len, cc->out_pos);
+            cc->out_pos += len;
+            return ret;
+        }
+    }
+    memcpy(&cc->out[cc->out_len], data, len);
+    cc->out_len += len;
+    cc->out_pos += len;
+    return 0;
+}
+
+// Store the record for a single line of the original file
+static int
+compile_line(struct gcodecache_compile *cc)
+{
+    if (!(cc->line_count % GC_INDEX_INTERVAL)) {
+        if (cc->index_count >= cc->index_alloc) {
+            uint64_t new_alloc = cc->index_alloc ? cc->index_alloc * 2 : 64;
+            void *ni = realloc(cc->index, new_alloc * sizeof(cc->index[0]));
+            if (!ni) {
+                errorf("gcodecache: out of memory");
+                return -1;
+            }
+            cc->index = ni;
+            cc->index_alloc = new_alloc;
+        }
+        struct gcodecache_index *gi = &cc->index[cc->index_count++];
+        gi->src_pos = cc->src_pos;
+        gi->cache_pos = cc->out_pos;
+    }
+    cc->line_count++;
+    uint32_t line_len = cc->line_len + 1;
+    cc->src_pos += line_len;
+    // Check if the line is a simple move
+    struct gcode_move_fields f;
+    int gnum = -1;
+    if (!memchr(cc->line, '\0', cc->line_len)) {
+        gnum = gcodeparse_move(cc->line, &f);
+        if (gnum > 1 || (gnum >= 0 && f.mask & (1 << FIELD_F_INDEX)
+                         && !(f.values[FIELD_F_INDEX] > 0.)))
+            // Only G0/G1 with valid speeds are stored pre-parsed
+            gnum = -1;
+    }
+    uint8_t type = gnum < 0 ? GC_TEXT : gnum;
+    if (out_append(cc, &type, sizeof(type))
+        || out_append(cc, &line_len, sizeof(line_len)))
+        return -1;
+    if (gnum < 0)
+        return out_append(cc, cc->line, cc->line_len);
+    if (out_append(cc, &f.mask, sizeof(f.mask)))
+        return -1;
+    int i;
+    for (i = 0; i < 26; i++)
+        if (f.mask & (1 << i) && out_append(cc, &f.values[i]
+                                            , sizeof(f.values[i])))
+            return -1;
+    return 0;
+}
+
+// Add data to the pending line
+static int
+line_append(struct gcodecache_compile *cc, const char *data, uint32_t len)
+{
+    if (cc->line_len + len >= GC_MAX_TEXT) {
+        errorf("gcodecache: line too long at position %llu"
+               , (unsigned long long)cc->src_pos);
+        return -1;
+    }
+    if (cc->line_len + len + 1 > cc->line_alloc) {
+        uint32_t new_alloc = cc->line_alloc ? cc->line_alloc : 256;
+        while (cc->line_len + len + 1 > new_alloc)
+            new_alloc *= 2;
+        char *nl = realloc(cc->line, new_alloc);
+        if (!nl) {
+            errorf("gcodecache: out of memory");
+            return -1;
+        }
+        cc->line = nl;
+        cc->line_alloc = new_alloc;
+    }
+    memcpy(&cc->line[cc->line_len], data, len);
+    cc->line_len += len;
+    cc->line[cc->line_len] = '\0';
+    return 0;
+}
+
+// Compile the full file
+static int
+compile_file(struct gcodecache_compile *cc)
+{
+    struct gcodecache_header hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    cc->out_pos = sizeof(hdr);
+    char buf[GC_IO_SIZE];
+    uint64_t read_pos = 0;
+    while (read_pos < cc->src.size) {
+        pthread_mutex_lock(&cc->lock);
+        int must_exit = cc->must_exit;
+        pthread_mutex_unlock(&cc->lock);
+        if (must_exit)
+            return -1;
+        uint64_t len = cc->src.size - read_pos;
+        if (len > sizeof(buf))
+            len = sizeof(buf);
+        int ret = pread(cc->src_fd, buf, len, read_pos);
+        if (ret < 0) {
+            if (errno == EINTR)
+                continue;
+            report_errno("pread", ret);
+            return -1;
+        }
+        if (!ret)
+            // File truncated (its identity check below will fail)
+            break;
+        read_pos += ret;
+        char *p = buf, *end = &buf[ret];
+        while (p < end) {
+            char *nl = memchr(p, '\n', end - p);
+            if (!nl)
+                nl = end;
+            if (line_append(cc, p, nl - p))
+                return -1;
+            if (nl == end)
+                break;
+            if (compile_line(cc))
+                return -1;
+            cc->line_len = 0;
+            p = nl + 1;
+        }
+    }
+    // Don't store a cache if the file was changed while reading it
+    struct gcodecache_source src;
+    if (source_identity(cc->src_fd, &src))
+        return -1;
+    if (read_pos != cc->src.size || memcmp(&src, &cc->src, sizeof(src))) {
+        errorf("gcodecache: file changed during compile");
+        return -1;
+    }
+    // Write index and then header
+    hdr.index_offset = cc->out_pos;
+    hdr.index_count = cc->index_count;
+    if (out_append(cc, cc->index, cc->index_count * sizeof(cc->index[0]))
+        || out_flush(cc))
+        return -1;
+    hdr.magic = GC_MAGIC;
+    hdr.version = GC_VERSION;
+    hdr.src = cc->src;
+    hdr.line_count = cc->line_count;
+    return write_all(cc->dst_fd, (void*)&hdr, sizeof(hdr), 0);
+}
+
+// Main background thread
+static void *
+compile_thread(void *data)
+{
+    struct gcodecache_compile *cc = data;
+    int ret = compile_file(cc);
+    pthread_mutex_lock(&cc->lock);
+    cc->result = ret ? -1 : 1;
+    pthread_mutex_unlock(&cc->lock);
+    return NULL;
+}
+
+// Start compiling the g-code file 'src_fd' into the cache file 'dst_fd'
+struct gcodecache_compile * __visible
+gcodecache_compile_alloc(int src_fd, int dst_fd)
+{
+    struct gcodecache_compile *cc = malloc(sizeof(*cc));
+    if (!cc) {
+        errorf("gcodecache_compile_alloc: out of memory");
+        return NULL;
+    }
+    memset(cc, 0, sizeof(*cc));
+    cc->src_fd = dup(src_fd);
+    cc->dst_fd = dup(dst_fd);
+    int ret = -1;
+    if (cc->src_fd < 0 || cc->dst_fd < 0 || source_identity(src_fd, &cc->src))
+        goto fail;
+    ret = pthread_mutex_init(&cc->lock, NULL);
+    if (ret)
+        goto fail;
+    ret = pthread_create(&cc->tid, NULL, compile_thread, cc);
+    if (ret)
+        goto fail;
+    return cc;
+
+fail:
+    report_errno("init", ret);
+    if (cc->src_fd >= 0)
+        close(cc->src_fd);
+    if (cc->dst_fd >= 0)
+        close(cc->dst_fd);
+    free(cc);
+    return NULL;
+}
+
+// Check if a compile is complete.  Returns 0 if the compile is still
+// running, 1 if it completed successfully, or -1 on an error.
+int __visible
+gcodecache_compile_check(struct gcodecache_compile *cc)
+{
+    pthread_mutex_lock(&cc->lock);
+    int result = cc->result;
+    pthread_mutex_unlock(&cc->lock);
+    return result;
+}
+
+// Stop the compile (if still running) and free all resources
+void __visible
+gcodecache_compile_free(struct gcodecache_compile *cc)
+{
+    if (!cc)
+        return;
+    pthread_mutex_lock(&cc->lock);
+    cc->must_exit = 1;
+    pthread_mutex_unlock(&cc->lock);
+    int ret = pthread_join(cc->tid, NULL);
+    if (ret)
+        report_errno("pthread_join", ret);
+    close(cc->src_fd);
+    close(cc->dst_fd);
+    pthread_mutex_destroy(&cc->lock);
+    free(cc->line);
+    free(cc->index);
+    free(cc);
+}
+
+
+/****************************************************************
+ * Cache replay
+ ****************************************************************/
+
+struct gcodecache_entry {
+    uint64_t end_pos;
+    int32_t gnum;
+    uint32_t text_offset, text_len;
+    struct gcode_move_fields fields;
+};
+
+struct gcodecache_reader {
+    int fd;
+    struct gcodecache_header hdr;
+    struct gcodecache_index *index;
+    // Current position
+    uint64_t src_pos, cache_pos;
+    // Read buffer
+    uint64_t buf_pos;
+    uint32_t buf_len;
+    char buf[GC_READ_SIZE];
+};
+
+// Make sure 'len' bytes at the current position are in the buffer
+static char *
+reader_data(struct gcodecache_reader *gr, uint32_t len)
+{
+    if (gr->cache_pos + len > gr->hdr.index_offset) {
+        errorf("gcodecache: truncated record at %llu"
+               , (unsigned long long)gr->cache_pos);
+        return NULL;
+    }
+    if (gr->cache_pos >= gr->buf_pos
+        && gr->cache_pos + len <= gr->buf_pos + gr->buf_len)
+        return &gr->buf[gr->cache_pos - gr->buf_pos];
+    gr->buf_pos = gr->cache_pos;
+    gr->buf_len = 0;
+    while (gr->buf_len < len) {
+        int ret = pread(gr->fd, &gr->buf[gr->buf_len]
+                        , sizeof(gr->buf) - gr->buf_len
+                        , gr->buf_pos + gr->buf_len);
+        if (ret < 0) {
+            if (errno == EINTR)
+                continue;
+            report_errno("pread", ret);
+            return NULL;
+        }
+        if (!ret) {
+            errorf("gcodecache: unexpected end of file");
+            return NULL;
+        }
+        gr->buf_len += ret;
+    }
+    return gr->buf;
+}
+
+// Return the size of the record at the current position (or 0 on error)
+static uint32_t
+reader_record(struct gcodecache_reader *gr, uint8_t *ptype
+              , uint32_t *pline_len)
+{
+    char *d = reader_data(gr, GC_RECORD_HEADER);
+    if (!d)
+        return 0;
+    uint8_t type = *ptype = d[0];
+    uint32_t line_len;
+    memcpy(&line_len, &d[1], sizeof(line_len));
+    *pline_len = line_len;
+    if (type == GC_TEXT) {
+        if (!line_len || line_len > GC_MAX_TEXT)
+            goto fail;
+        return GC_RECORD_HEADER + line_len - 1;
+    }
+    if (type > 1)
+        goto fail;
+    d = reader_data(gr, GC_RECORD_HEADER + sizeof(uint32_t));
+    if (!d)
+        return 0;
+    uint32_t mask;
+    memcpy(&mask, &d[GC_RECORD_HEADER], sizeof(mask));
+    return (GC_RECORD_HEADER + sizeof(mask)
+            + __builtin_popcount(mask) * sizeof(double));
+fail:
+    errorf("gcodecache: invalid record at %llu"
+           , (unsigned long long)gr->cache_pos);
+    return 0;
+}
+
+// Check if the cache file 'fd' is valid for the g-code file 'src_fd'.
+// Returns 1 if it is valid or 0 otherwise.
+int __visible
+gcodecache_check(int fd, int src_fd)
+{
+    struct gcodecache_header hdr;
+    return !read_header(fd, src_fd, &hdr);
+}
+
+// Open a cache file.  Returns NULL if the cache is not valid for the
+// g-code file 'src_fd'.
+struct gcodecache_reader * __visible
+gcodecache_reader_alloc(int fd, int src_fd)
+{
+    struct gcodecache_reader *gr = malloc(sizeof(*gr));
+    if (!gr) {
+        errorf("gcodecache_reader_alloc: out of memory");
+        return NULL;
+    }
+    memset(gr, 0, sizeof(*gr));
+    struct gcodecache_header *hdr = &gr->hdr;
+    if (read_header(fd, src_fd, hdr))
+        goto fail;
+    uint64_t index_size = hdr->index_count * sizeof(gr->index[0]);
+    gr->index = malloc(index_size);
+    if (!gr->index)
+        goto fail;
+    int ret = pread(fd, gr->index, index_size, hdr->index_offset);
+    if (ret != index_size)
+        goto fail;
+    gr->fd = dup(fd);
+    if (gr->fd < 0)
+        goto fail;
+    gr->cache_pos = gr->index[0].cache_pos;
+    return gr;
+
+fail:
+    free(gr->index);
+    free(gr);
+    return NULL;
+}
+
+// Free all resources associated with a cache reader
+void __visible
+gcodecache_reader_free(struct gcodecache_reader *gr)
+{
+    if (!gr)
+        return;
+    close(gr->fd);
+    free(gr->index);
+    free(gr);
+}
+
+// Position the reader at the line starting at the given position of
+// the original file.  Returns 0 on success or -1 if 'pos' is not the
+// start of a line.
+int __visible
+gcodecache_reader_seek(struct gcodecache_reader *gr, uint64_t pos)
+{
+    // Find the last index entry at or before the requested position
+    uint64_t lo = 0, hi = gr->hdr.index_count;
+    while (hi - lo > 1) {
+        uint64_t mid = (lo + hi) / 2;
+        if (gr->index[mid].src_pos <= pos)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    gr->src_pos = gr->index[lo].src_pos;
+    gr->cache_pos = gr->index[lo].cache_pos;
+    // Skip records until the requested position is reached
+    while (gr->src_pos < pos && gr->cache_pos < gr->hdr.index_offset) {
+        uint8_t type;
+        uint32_t line_len, size = reader_record(gr, &type, &line_len);
+        if (!size)
+            return -1;
+        gr->src_pos += line_len;
+        gr->cache_pos += size;
+    }
+    return gr->src_pos == pos ? 0 : -1;
+}
+
+// Read the next records from the cache.  The text of non-move lines
+// is stored in 'text'.  Returns the number of entries, 0 at the end
+// of the file, or -1 on an error.
+int __visible
+gcodecache_reader_pull(struct gcodecache_reader *gr
+                       , struct gcodecache_entry *entries, int max_entries
+                       , char *text, int text_size)
+{
+    int count = 0;
+    uint32_t text_used = 0;
+    while (count < max_entries && gr->cache_pos < gr->hdr.index_offset) {
+        uint8_t type;
+        uint32_t line_len, size = reader_record(gr, &type, &line_len);
+        if (!size)
+            return -1;
+        if (type == GC_TEXT && text_used + line_len - 1 > text_size) {
+            if (!count) {
+                errorf("gcodecache: line too long for buffer");
+                return -1;
+            }
+            break;
+        }
+        char *d = reader_data(gr, size);
+        if (!d)
+            return -1;
+        struct gcodecache_entry *e = &entries[count++];
+        gr->src_pos += line_len;
+        gr->cache_pos += size;
+        e->end_pos = gr->src_pos;
+        if (type == GC_TEXT) {
+            e->gnum = -1;
+            e->text_offset = text_used;
+            e->text_len = line_len - 1;
+            memcpy(&text[text_used], &d[GC_RECORD_HEADER], line_len - 1);
+            text_used += line_len - 1;
+            continue;
+        }
+        e->gnum = type;
+        uint32_t mask;
+        d += GC_RECORD_HEADER;
+        memcpy(&mask, d, sizeof(mask));
+        d += sizeof(mask);
+        e->fields.mask = mask;
+        int i;
+        for (i = 0; i < 26; i++) {
+            if (mask & (1 << i)) {
+                memcpy(&e->fields.values[i], d, sizeof(double));
+                d += sizeof(double);
+            }
+        }
+    }
+    return count;
+}
@@ -0,0 +1,120 @@
+// Fast path tokenizer for G-Code movement commands
+//
+// Copyright (C) 2026  Kevin O'Connor <kevin@koconnor.net>
+//
+// This file may be distributed under the terms of the GNU GPLv3 license.
+
+// The python G-Code parser (gcode.py) splits each line into a
+// dictionary of parameter strings.  For the very common G0/G1/G2/G3
+// lines, the code here extracts the parameters directly into numeric
+// fields.  Only lines that have a simple format are handled - a line
+// with any unusual content (line numbers, checksums, multi-letter
+// parameters, non-decimal values, etc.) is rejected so that the
+// python code can process it (and report any errors) as before.
+
+#include <stdlib.h> // strtod
+#include <string.h> // memcpy
+#include "compiler.h" // __visible
+#include "gcodeparse.h" // gcode_move_fields
+
+#define NUMBER_MAX 64
+
+static inline int
+is_space(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n'
+        || c == '\v' || c == '\f';
+}
+
+static inline int
+is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+// Return the index (0-25) of an ascii letter or -1 if not a letter
+static inline int
+letter_index(char c)
+{
+    if (c >= 'A' && c <= 'Z')
+        return c - 'A';
+    if (c >= 'a' && c <= 'z')
+        return c - 'a';
+    return -1;
+}
+
+// Parse a decimal number of the form [+-]digits[.digits]
+static int
+parse_number(const char *s, const char *end, double *pv)
+{
+    int len = end - s;
+    if (len <= 0 || len >= NUMBER_MAX)
+        return -1;
+    const char *p = s;
+    if (*p == '+' || *p == '-')
+        p++;
+    int digits = 0;
+    while (p < end && is_digit(*p))
+        p++, digits++;
+    if (p < end && *p == '.') {
+        p++;
+        while (p < end && is_digit(*p))
+            p++, digits++;
+    }
+    if (p != end || !digits)
+        return -1;
+    char buf[NUMBER_MAX];
+    memcpy(buf, s, len);
+    buf[len] = '\0';
+    *pv = strtod(buf, NULL);
+    return 0;
+}
+
+// Tokenize a G0, G1, G2, or G3 line.  Returns the G-Code command
+// number on success, or -1 if the line must be handled by the
+// general purpose parser.
+int __visible
+gcodeparse_move(const char *line, struct gcode_move_fields *f)
+{
+    const char *p = line;
+    while (is_space(*p))
+        p++;
+    // Command must be "G" followed by a single digit from 0 to 3
+    if ((p[0] != 'G' && p[0] != 'g') || p[1] < '0' || p[1] > '3')
+        return -1;
+    int cmd = p[1] - '0';
+    p += 2;
+    if (*p && *p != ';' && !is_space(*p) && letter_index(*p) < 0)
+        return -1;
+    f->mask = 0;
+    for (;;) {
+        while (is_space(*p))
+            p++;
+        if (!*p || *p == ';')
+            break;
+        // Parameter must be a single letter followed by a number
+        int idx = letter_index(*p);
+        if (idx < 0)
+            return -1;
+        p++;
+        while (is_space(*p))
+            p++;
+        const char *start = p;
+        while (*p && *p != ';' && !is_space(*p) && letter_index(*p) < 0) {
+            if ((uint8_t)*p < 0x20 || (uint8_t)*p >= 0x7f
+                || *p == '_' || *p == '*')
+                return -1;
+            p++;
+        }
+        const char *end = p;
+        while (is_space(*p))
+            p++;
+        if (*p && *p != ';' && letter_index(*p) < 0)
+            // Whitespace within a parameter value
+            return -1;
+        if (parse_number(start, end, &f->values[idx]))
+            return -1;
+        f->mask |= 1 << idx;
+    }
+    return cmd;
+}
@@ -0,0 +1,13 @@
+#ifndef GCODEPARSE_H
+#define GCODEPARSE_H
+
+#include <stdint.h> // uint32_t
+
+struct gcode_move_fields {
+    uint32_t mask;
+    double values[26];
+};
+
+int gcodeparse_move(const char *line, struct gcode_move_fields *f);
+
+#endif // gcodeparse.h
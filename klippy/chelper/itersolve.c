@@ -26,8 +26,8 @@ struct timepos {
 
 // Generate step times for a portion of a move
 static int32_t
-itersolve_gen_steps_range(struct stepper_kinematics *sk, struct stepcompress *sc
-                          , struct move *m, double abs_start, double abs_end)
+itersolve_gen_steps_iter(struct stepper_kinematics *sk, struct stepcompress *sc
+                         , struct move *m, double abs_start, double abs_end)
 {
     sk_calc_callback calc_position_cb = sk->calc_position_cb;
     double half_step = .5 * sk->step_dist;
@@ -128,6 +128,105 @@ itersolve_gen_steps_range(struct stepper_kinematics *sk, struct stepcompress *sc
 }
 
 
+/****************************************************************
+ * Analytic solver for linear kinematics
+ ****************************************************************/
+
+// On kinematics where the stepper position is a linear combination of
+// the cartesian coordinates (eg, cartesian and corexy) the position is
+// a quadratic function of time within a move.  As long as the stepper
+// does not change direction during the move, each step time can be
+// calculated directly instead of searched for.
+
+// Check if the position has reached the last step position (in sdir)
+static inline int
+linear_check_commit(struct stepper_kinematics *sk, int sdir, double pos)
+{
+    return sdir ? pos >= sk->commanded_pos : pos <= sk->commanded_pos;
+}
+
+// Generate step times for a portion of a move on a linear stepper
+static int32_t
+itersolve_gen_steps_linear(struct stepper_kinematics *sk
+                           , struct stepcompress *sc, struct move *m
+                           , double abs_start, double abs_end)
+{
+    double start = abs_start - m->print_time, end = abs_end - m->print_time;
+    if (start < 0.)
+        start = 0.;
+    if (end > m->move_t)
+        end = m->move_t;
+    double ratio = (sk->linear_x * m->axes_r.x + sk->linear_y * m->axes_r.y
+                    + sk->linear_z * m->axes_r.z);
+    double start_v = ratio * (m->start_v + 2. * m->half_accel * start);
+    double end_v = ratio * (m->start_v + 2. * m->half_accel * end);
+    if (start_v * end_v < 0.)
+        // Stepper changes direction during move - use iterative solver
+        return itersolve_gen_steps_iter(sk, sc, m, abs_start, abs_end);
+    double base = (sk->linear_x * m->start_pos.x + sk->linear_y * m->start_pos.y
+                   + sk->linear_z * m->start_pos.z);
+    double start_pos = base + ratio * move_get_distance(m, start);
+    double end_pos = base + ratio * move_get_distance(m, end);
+    int sdir = stepcompress_get_step_dir(sc);
+    if (linear_check_commit(sk, sdir, start_pos)) {
+        // Avoid rollback if stepper fully reaches step position
+        int ret = stepcompress_commit(sc);
+        if (ret)
+            return ret;
+    }
+    if (end_pos != start_pos) {
+        int dir = end_pos > start_pos;
+        double half_step = .5 * sk->step_dist;
+        double step = dir ? sk->step_dist : -sk->step_dist;
+        double target = sk->commanded_pos + (dir ? half_step : -half_step);
+        // Position relative to start_pos (in direction of travel) is
+        // "half_accel*t^2 + v*t" where t is the time since start
+        double v = dir ? start_v : -start_v;
+        double half_accel = (dir ? ratio : -ratio) * m->half_accel;
+        for (;;) {
+            double rel_dist = dir ? end_pos - target : target - end_pos;
+            if (rel_dist < -.000000001)
+                break;
+            // Solve quadratic (in a form that avoids cancellation errors)
+            double dist = dir ? target - start_pos : start_pos - target;
+            double step_time = start;
+            if (dist > 0.) {
+                double disc = v*v + 4. * half_accel * dist;
+                double denom = v + sqrt(disc > 0. ? disc : 0.);
+                step_time = denom > 0. ? start + 2. * dist / denom : end;
+                if (step_time > end)
+                    step_time = end;
+            }
+            // Found next step - submit it
+            int ret = stepcompress_append(sc, dir, m->print_time, step_time);
+            if (ret)
+                return ret;
+            target += step;
+            sdir = dir;
+        }
+        sk->commanded_pos = target - (dir ? half_step : -half_step);
+    }
+    if (linear_check_commit(sk, sdir, end_pos)) {
+        int ret = stepcompress_commit(sc);
+        if (ret)
+            return ret;
+    }
+    if (sk->post_cb)
+        sk->post_cb(sk);
+    return 0;
+}
+
+// Generate step times for a portion of a move
+static int32_t
+itersolve_gen_steps_range(struct stepper_kinematics *sk, struct stepcompress *sc
+                          , struct move *m, double abs_start, double abs_end)
+{
+    if (sk->is_linear)
+        return itersolve_gen_steps_linear(sk, sc, m, abs_start, abs_end);
+    return itersolve_gen_steps_iter(sk, sc, m, abs_start, abs_end);
+}
+
+
 /****************************************************************
  * Interface functions
  ****************************************************************/
@@ -142,75 +241,155 @@ check_active(struct stepper_kinematics *sk, struct move *m)
             || (af & AF_Z && m->axes_r.z != 0.));
 }
 
-// Generate step times for a range of moves on the trapq
-int32_t
-itersolve_generate_steps(struct stepper_kinematics *sk, struct stepcompress *sc
-                         , double flush_time)
+// Step generation state of a stepper while scanning the trapq
+struct gen_steps_state {
+    struct stepper_kinematics *sk;
+    struct stepcompress *sc;
+    double last_flush_time, force_steps_time;
+    int skip_count, done;
+};
+
+// Generate steps for one stepper on the given move
+static int32_t
+gen_steps_move(struct gen_steps_state *gs, struct move *m, double flush_time)
 {
-    double last_flush_time = sk->last_flush_time;
-    sk->last_flush_time = flush_time;
-    if (!sk->tq)
+    struct stepper_kinematics *sk = gs->sk;
+    struct stepcompress *sc = gs->sc;
+    double move_start = m->print_time, move_end = move_start + m->move_t;
+    if (check_active(sk, m)) {
+        if (gs->skip_count && sk->gen_steps_pre_active) {
+            // Must generate steps leading up to stepper activity
+            double abs_start = move_start - sk->gen_steps_pre_active;
+            if (abs_start < gs->last_flush_time)
+                abs_start = gs->last_flush_time;
+            if (abs_start < gs->force_steps_time)
+                abs_start = gs->force_steps_time;
+            struct move *pm = list_prev_entry(m, node);
+            while (--gs->skip_count && pm->print_time > abs_start)
+                pm = list_prev_entry(pm, node);
+            do {
+                int32_t ret = itersolve_gen_steps_range(
+                    sk, sc, pm, abs_start, flush_time);
+                if (ret)
+                    return ret;
+                pm = list_next_entry(pm, node);
+            } while (pm != m);
+        }
+        // Generate steps for this move
+        int32_t ret = itersolve_gen_steps_range(sk, sc, m, gs->last_flush_time
+                                                , flush_time);
+        if (ret)
+            return ret;
+        if (move_end >= flush_time) {
+            sk->last_move_time = flush_time;
+            gs->done = 1;
+            return 0;
+        }
+        gs->skip_count = 0;
+        sk->last_move_time = move_end;
+        gs->force_steps_time = sk->last_move_time + sk->gen_steps_post_active;
+    } else {
+        if (move_start < gs->force_steps_time) {
+            // Must generates steps just past stepper activity
+            double abs_end = gs->force_steps_time;
+            if (abs_end > flush_time)
+                abs_end = flush_time;
+            int32_t ret = itersolve_gen_steps_range(
+                sk, sc, m, gs->last_flush_time, abs_end);
+            if (ret)
+                return ret;
+            gs->skip_count = 1;
+        } else {
+            // This move doesn't impact this stepper - skip it
+            gs->skip_count++;
+        }
+        if (flush_time + sk->gen_steps_pre_active <= move_end)
+            gs->done = 1;
+    }
+    return 0;
+}
+
+// Generate step times for a range of moves on a trapq shared by
+// several steppers.  The trapq is traversed once and each move is
+// evaluated for all the steppers before advancing to the next move.
+static int32_t
+gen_steps_batch(struct stepper_kinematics **sks, struct stepcompress **scs
+                , int count, double flush_time)
+{
+    struct gen_steps_state states[ITERSOLVE_MAX_BATCH];
+    struct trapq *tq = NULL;
+    double min_flush_time = 0.;
+    int num_states = 0, i;
+    for (i=0; i<count; i++) {
+        struct stepper_kinematics *sk = sks[i];
+        double last_flush_time = sk->last_flush_time;
+        sk->last_flush_time = flush_time;
+        sk->gen_seq++;
+        if (!sk->tq)
+            continue;
+        if (tq && sk->tq != tq) {
+            errorf("itersolve batch with multiple trapq");
+            return -1;
+        }
+        tq = sk->tq;
+        if (!num_states || last_flush_time < min_flush_time)
+            min_flush_time = last_flush_time;
+        struct gen_steps_state *gs = &states[num_states++];
+        gs->sk = sk;
+        gs->sc = scs[i];
+        gs->last_flush_time = last_flush_time;
+        gs->force_steps_time = sk->last_move_time + sk->gen_steps_post_active;
+        gs->skip_count = gs->done = 0;
+    }
+    if (!num_states)
         return 0;
-    struct move *m = list_first_entry(&sk->tq->moves, struct move, node);
-    while (last_flush_time >= m->print_time + m->move_t)
+    struct move *m = list_first_entry(&tq->moves, struct move, node);
+    while (min_flush_time >= m->print_time + m->move_t)
         m = list_next_entry(m, node);
-    double force_steps_time = sk->last_move_time + sk->gen_steps_post_active;
-    int skip_count = 0;
+    int remaining = num_states;
     for (;;) {
-        double move_start = m->print_time, move_end = move_start + m->move_t;
-        if (check_active(sk, m)) {
-            if (skip_count && sk->gen_steps_pre_active) {
-                // Must generate steps leading up to stepper activity
-                double abs_start = move_start - sk->gen_steps_pre_active;
-                if (abs_start < last_flush_time)
-                    abs_start = last_flush_time;
-                if (abs_start < force_steps_time)
-                    abs_start = force_steps_time;
-                struct move *pm = list_prev_entry(m, node);
-                while (--skip_count && pm->print_time > abs_start)
-                    pm = list_prev_entry(pm, node);
-                do {
-                    int32_t ret = itersolve_gen_steps_range(
-                        sk, sc, pm, abs_start, flush_time);
-                    if (ret)
-                        return ret;
-                    pm = list_next_entry(pm, node);
-                } while (pm != m);
-            }
-            // Generate steps for this move
-            int32_t ret = itersolve_gen_steps_range(sk, sc, m, last_flush_time
-                                                    , flush_time);
+        double move_end = m->print_time + m->move_t;
+        for (i=0; i<num_states; i++) {
+            struct gen_steps_state *gs = &states[i];
+            if (gs->done || gs->last_flush_time >= move_end)
+                continue;
+            int32_t ret = gen_steps_move(gs, m, flush_time);
             if (ret)
                 return ret;
-            if (move_end >= flush_time) {
-                sk->last_move_time = flush_time;
-                return 0;
-            }
-            skip_count = 0;
-            sk->last_move_time = move_end;
-            force_steps_time = sk->last_move_time + sk->gen_steps_post_active;
-        } else {
-            if (move_start < force_steps_time) {
-                // Must generates steps just past stepper activity
-                double abs_end = force_steps_time;
-                if (abs_end > flush_time)
-                    abs_end = flush_time;
-                int32_t ret = itersolve_gen_steps_range(
-                    sk, sc, m, last_flush_time, abs_end);
-                if (ret)
-                    return ret;
-                skip_count = 1;
-            } else {
-                // This move doesn't impact this stepper - skip it
-                skip_count++;
-            }
-            if (flush_time + sk->gen_steps_pre_active <= move_end)
+            if (gs->done && !--remaining)
                 return 0;
         }
         m = list_next_entry(m, node);
     }
 }
 
+int32_t
+itersolve_generate_steps_batch(struct stepper_kinematics **sks
+                               , struct stepcompress **scs, int count
+                               , double flush_time)
+{
+    if (count < 1 || count > ITERSOLVE_MAX_BATCH) {
+        errorf("Invalid itersolve batch size (%d)", count);
+        return -1;
+    }
+    double start_time = get_thread_cpu_time();
+    int32_t ret = gen_steps_batch(sks, scs, count, flush_time);
+    // Account the cpu time evenly to the steppers in the batch
+    double cpu_time = (get_thread_cpu_time() - start_time) / count;
+    int i;
+    for (i=0; i<count; i++)
+        sks[i]->gen_steps_cpu_time += cpu_time;
+    return ret;
+}
+
+// Generate step times for a range of moves on the trapq
+int32_t
+itersolve_generate_steps(struct stepper_kinematics *sk, struct stepcompress *sc
+                         , double flush_time)
+{
+    return itersolve_generate_steps_batch(&sk, &sc, 1, flush_time);
+}
+
 // Check if the given stepper is likely to be active in the given time range
 double __visible
 itersolve_check_active(struct stepper_kinematics *sk, double flush_time)
@@ -263,6 +442,7 @@ itersolve_calc_position_from_coord(struct stepper_kinematics *sk
     m.start_pos.y = y;
     m.start_pos.z = z;
     m.move_t = 1000.;
+    sk->gen_seq++;
     return sk->calc_position_cb(sk, &m, 500.);
 }
 
@@ -290,3 +470,28 @@ itersolve_get_gen_steps_post_active(struct stepper_kinematics *sk)
 {
     return sk->gen_steps_post_active;
 }
+
+double
+itersolve_get_gen_steps_cpu_time(struct stepper_kinematics *sk)
+{
+    return sk->gen_steps_cpu_time;
+}
+
+// Note that the stepper position is a linear combination of x, y, and z
+// (the analytic solver is only used after itersolve_set_analytic())
+void
+itersolve_set_linear(struct stepper_kinematics *sk
+                     , double a_x, double a_y, double a_z)
+{
+    sk->has_linear = 1;
+    sk->linear_x = a_x;
+    sk->linear_y = a_y;
+    sk->linear_z = a_z;
+}
+
+// Enable or disable the analytic solver (if supported by the kinematics)
+void __visible
+itersolve_set_analytic(struct stepper_kinematics *sk, int enable)
+{
+    sk->is_linear = sk->has_linear && enable;
+}
@@ -18,13 +18,26 @@ struct stepper_kinematics {
 
     double last_flush_time, last_move_time;
     struct trapq *tq;
+    // Incremented on each request that may invoke calc_position_cb
+    uint32_t gen_seq;
     int active_flags;
     double gen_steps_pre_active, gen_steps_post_active;
+    // Total cpu time spent generating steps
+    double gen_steps_cpu_time;
 
     sk_calc_callback calc_position_cb;
     sk_post_callback post_cb;
+
+    // Stepper position is a linear combination of cartesian coordinates
+    int has_linear, is_linear;
+    double linear_x, linear_y, linear_z;
 };
 
+#define ITERSOLVE_MAX_BATCH 16
+
+int32_t itersolve_generate_steps_batch(struct stepper_kinematics **sks
+                                       , struct stepcompress **scs, int count
+                                       , double flush_time);
 int32_t itersolve_generate_steps(struct stepper_kinematics *sk
                                  , struct stepcompress *sc, double flush_time);
 double itersolve_check_active(struct stepper_kinematics *sk, double flush_time);
@@ -39,5 +52,9 @@ void itersolve_set_position(struct stepper_kinematics *sk
 double itersolve_get_commanded_pos(struct stepper_kinematics *sk);
 double itersolve_get_gen_steps_pre_active(struct stepper_kinematics *sk);
 double itersolve_get_gen_steps_post_active(struct stepper_kinematics *sk);
+void itersolve_set_linear(struct stepper_kinematics *sk
+                          , double a_x, double a_y, double a_z);
+void itersolve_set_analytic(struct stepper_kinematics *sk, int enable);
+double itersolve_get_gen_steps_cpu_time(struct stepper_kinematics *sk);
 
 #endif // itersolve.h
@@ -56,6 +56,21 @@ extruder_integrate_time(double base, double start_v, double half_accel
     return ei - si;
 }
 
+// Determine the pressure_advance value in effect for a given move
+static double
+pa_lookup(struct move *m, struct list_head *pa_list)
+{
+    int can_pressure_advance = m->axes_r.y != 0.;
+    if (!can_pressure_advance)
+        return 0.;
+    struct pa_params *pa = list_last_entry(pa_list, struct pa_params, node);
+    while (unlikely(pa->active_print_time > m->print_time) &&
+            !list_is_first(&pa->node, pa_list)) {
+        pa = list_prev_entry(pa, node);
+    }
+    return pa->pressure_advance;
+}
+
 // Calculate the definitive integral of extruder for a given move
 static double
 pa_move_integrate(struct move *m, struct list_head *pa_list
@@ -65,17 +80,7 @@ pa_move_integrate(struct move *m, struct list_head *pa_list
         start = 0.;
     if (end > m->move_t)
         end = m->move_t;
-    // Determine pressure_advance value
-    int can_pressure_advance = m->axes_r.y != 0.;
-    double pressure_advance = 0.;
-    if (can_pressure_advance) {
-        struct pa_params *pa = list_last_entry(pa_list, struct pa_params, node);
-        while (unlikely(pa->active_print_time > m->print_time) &&
-                !list_is_first(&pa->node, pa_list)) {
-            pa = list_prev_entry(pa, node);
-        }
-        pressure_advance = pa->pressure_advance;
-    }
+    double pressure_advance = pa_lookup(m, pa_list);
     // Calculate base position and velocity with pressure advance
     base += pressure_advance * m->start_v;
     double start_v = m->start_v + pressure_advance * 2. * m->half_accel;
@@ -115,12 +120,146 @@ pa_range_integrate(struct move *m, double move_time
     return res;
 }
 
+
+/****************************************************************
+ * Cached prefix integrals
+ ****************************************************************/
+
+// The smoothed position can also be written in terms of the integrals
+// of the pressure advance position from a fixed origin:
+//     P1(t) = integral(pa_position(x) * dx, from=origin, to=t)
+//     Q(t) = integral(pa_position(x) * (x - tc) * dx, from=origin, to=t)
+//     area = (hst * (P1(tc+hst) - P1(tc-hst))
+//             + 2 * Q(tc) - Q(tc-hst) - Q(tc+hst))
+// The integrals up to the start of each move are calculated once per
+// step generation request, so each solver evaluation only needs to
+// integrate within three moves no matter how many moves are in the
+// smoothing window.
+
+#define PA_CACHE_SIZE 256
+
+struct pa_move_integral {
+    struct move *m;
+    // Move parameters (relative to the cache origin) with pressure advance
+    double start_time, base, start_v, half_accel;
+    // Integrals of position and time weighted position up to start_time
+    double int_pos, int_time_pos;
+};
+
 struct extruder_stepper {
     struct stepper_kinematics sk;
     struct list_head pa_list;
     double half_smooth_time, inv_half_smooth_time2;
+    // Prefix integral cache (only valid during one step generation request)
+    int use_cache;
+    uint32_t cache_seq;
+    int cache_count, cache_pos;
+    double origin_time, origin_pos;
+    struct pa_move_integral cache[PA_CACHE_SIZE];
 };
 
+static void
+pa_cache_fill(struct extruder_stepper *es, struct pa_move_integral *e
+              , struct move *m)
+{
+    double pressure_advance = pa_lookup(m, &es->pa_list);
+    e->m = m;
+    e->start_time = m->print_time - es->origin_time;
+    e->base = (m->start_pos.x - es->origin_pos
+               + pressure_advance * m->start_v);
+    e->start_v = m->start_v + pressure_advance * 2. * m->half_accel;
+    e->half_accel = m->half_accel;
+}
+
+// Start a new cache with its origin at the move containing 'move_time'
+static void
+pa_cache_reset(struct extruder_stepper *es, struct move *m, double move_time)
+{
+    while (unlikely(move_time < 0.)) {
+        m = list_prev_entry(m, node);
+        move_time += m->move_t;
+    }
+    es->origin_time = m->print_time;
+    es->origin_pos = m->start_pos.x;
+    struct pa_move_integral *e = &es->cache[0];
+    pa_cache_fill(es, e, m);
+    e->int_pos = e->int_time_pos = 0.;
+    es->cache_count = 1;
+    es->cache_pos = 0;
+    es->cache_seq = es->sk.gen_seq;
+}
+
+// Find the cache entry for the move containing 'time' (relative to the
+// cache origin) - returns NULL if it is not in the cache and can't be added
+static struct pa_move_integral *
+pa_cache_find(struct extruder_stepper *es, double time)
+{
+    int pos = es->cache_pos;
+    struct pa_move_integral *e = &es->cache[pos];
+    while (time < e->start_time) {
+        if (!pos)
+            return NULL;
+        e = &es->cache[--pos];
+    }
+    while (time > e->start_time + e->m->move_t) {
+        if (++pos >= es->cache_count) {
+            // Add the next move to the cache
+            if (pos >= PA_CACHE_SIZE)
+                return NULL;
+            struct pa_move_integral *next = &es->cache[pos];
+            double move_t = e->m->move_t, st = e->start_time;
+            double iext = extruder_integrate(e->base, e->start_v
+                                             , e->half_accel, 0., move_t);
+            double wgt_ext = extruder_integrate_time(
+                e->base, e->start_v, e->half_accel, 0., move_t);
+            pa_cache_fill(es, next, list_next_entry(e->m, node));
+            next->int_pos = e->int_pos + iext;
+            next->int_time_pos = e->int_time_pos + st * iext + wgt_ext;
+            es->cache_count = pos + 1;
+        }
+        e = &es->cache[pos];
+    }
+    es->cache_pos = pos;
+    return e;
+}
+
+// Calculate P1(time) and Q(time) (see above) from the cache
+static int
+pa_cache_integrate(struct extruder_stepper *es, double time, double tc
+                   , double *p1, double *q)
+{
+    struct pa_move_integral *e = pa_cache_find(es, time);
+    if (!e)
+        return -1;
+    double mt = time - e->start_time;
+    double iext = extruder_integrate(e->base, e->start_v, e->half_accel
+                                     , 0., mt);
+    double wgt_ext = extruder_integrate_time(e->base, e->start_v
+                                             , e->half_accel, 0., mt);
+    *p1 = e->int_pos + iext;
+    *q = (e->int_time_pos + e->start_time * iext + wgt_ext) - tc * *p1;
+    return 0;
+}
+
+// Calculate the smoothed area (relative to the cache origin) from the cache
+static int
+pa_cache_area(struct extruder_stepper *es, double tc, double hst
+              , double *area)
+{
+    double p1_start, q_start, p1_mid, q_mid, p1_end, q_end;
+    if (pa_cache_integrate(es, tc - hst, tc, &p1_start, &q_start)
+        || pa_cache_integrate(es, tc, tc, &p1_mid, &q_mid)
+        || pa_cache_integrate(es, tc + hst, tc, &p1_end, &q_end))
+        return -1;
+    *area = hst * (p1_end - p1_start) + 2. * q_mid - q_start - q_end;
+    return 0;
+}
+
+
+/****************************************************************
+ * Extruder kinematics
+ ****************************************************************/
+
 static double
 extruder_calc_position(struct stepper_kinematics *sk, struct move *m
                        , double move_time)
@@ -131,10 +270,32 @@ extruder_calc_position(struct stepper_kinematics *sk, struct move *m
         // Pressure advance not enabled
         return m->start_pos.x + move_get_distance(m, move_time);
     // Apply pressure advance and average over smooth_time
-    double area = pa_range_integrate(m, move_time, &es->pa_list, hst);
+    double tc = m->print_time + move_time - es->origin_time, area;
+    if (unlikely(es->cache_seq != sk->gen_seq)
+        || pa_cache_area(es, tc, hst, &area)) {
+        if (!es->use_cache)
+            goto direct;
+        pa_cache_reset(es, m, move_time - hst);
+        tc = m->print_time + move_time - es->origin_time;
+        if (pa_cache_area(es, tc, hst, &area))
+            // Too many moves in the smoothing window - integrate directly
+            goto direct;
+    }
+    return es->origin_pos + area * es->inv_half_smooth_time2;
+direct:
+    area = pa_range_integrate(m, move_time, &es->pa_list, hst);
     return m->start_pos.x + area * es->inv_half_smooth_time2;
 }
 
+// Enable or disable the prefix integral cache (for testing)
+void __visible
+extruder_set_integral_cache(struct stepper_kinematics *sk, int enable)
+{
+    struct extruder_stepper *es = container_of(sk, struct extruder_stepper, sk);
+    es->use_cache = enable;
+    es->cache_seq = es->sk.gen_seq - 1;
+}
+
 void __visible
 extruder_set_pressure_advance(struct stepper_kinematics *sk, double print_time
                               , double pressure_advance, double smooth_time)
@@ -142,6 +303,7 @@ extruder_set_pressure_advance(struct stepper_kinematics *sk, double print_time
     struct extruder_stepper *es = container_of(sk, struct extruder_stepper, sk);
     double hst = smooth_time * .5, old_hst = es->half_smooth_time;
     es->half_smooth_time = hst;
+    es->cache_seq = es->sk.gen_seq - 1;
     es->sk.gen_steps_pre_active = es->sk.gen_steps_post_active = hst;
 
     // Cleanup old pressure advance parameters
@@ -179,6 +341,8 @@ extruder_stepper_alloc(void)
     memset(es, 0, sizeof(*es));
     es->sk.calc_position_cb = extruder_calc_position;
     es->sk.active_flags = AF_X;
+    es->use_cache = 1;
+    es->cache_seq = es->sk.gen_seq - 1;
     list_init(&es->pa_list);
     struct pa_params *pa = malloc(sizeof(*pa));
     memset(pa, 0, sizeof(*pa));
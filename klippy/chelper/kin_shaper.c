@@ -20,11 +20,13 @@
 
 static const int KIN_FLAGS[3] = { AF_X, AF_Y, AF_Z };
 
+#define MAX_SHAPER_PULSES 32
+
 struct shaper_pulses {
     int num_pulses;
     struct {
         double t, a;
-    } pulses[5];
+    } pulses[MAX_SHAPER_PULSES];
 };
 
 // Shift pulses around 'mid-point' t=0 so that the input shaper is an identity
@@ -62,6 +64,71 @@ init_shaper(int n, double a[], double t[], struct shaper_pulses *sp)
     return 0;
 }
 
+// A smoother is a continuous polynomial kernel w(u) = c[0] + c[1]*u + ...
+// defined for u in [-hst, hst].  The moments of the kernel are stored
+// as the polynomial coefficients of the integrals of u^j * w(u).
+#define MAX_KERNEL_COEFFS 16
+#define KERNEL_MOMENTS 3
+
+struct shaper_kernel {
+    int num_coeffs;
+    double hst, ts;
+    double c[MAX_KERNEL_COEFFS];
+    double moments[KERNEL_MOMENTS][MAX_KERNEL_COEFFS];
+};
+
+// Evaluate the antiderivative of u^j * w(u) at the given time
+static inline double
+kernel_moment(struct shaper_kernel *k, int j, double u)
+{
+    double *mc = k->moments[j], res = 0.;
+    int i;
+    for (i = k->num_coeffs-1; i >= 0; --i)
+        res = res * u + mc[i];
+    for (i = 0; i <= j; ++i)
+        res *= u;
+    return res;
+}
+
+static void
+calc_kernel_moments(struct shaper_kernel *k)
+{
+    int i, j;
+    for (j = 0; j < KERNEL_MOMENTS; ++j)
+        for (i = 0; i < k->num_coeffs; ++i)
+            k->moments[j][i] = k->c[i] / (i + j + 1);
+}
+
+static int
+init_kernel(int n, double c[], double t_sm, struct shaper_kernel *k)
+{
+    if (n < 0 || n > ARRAY_SIZE(k->c) || (n && t_sm <= 0.)) {
+        k->num_coeffs = 0;
+        return -1;
+    }
+    k->num_coeffs = n;
+    if (!n)
+        return 0;
+    double hst = k->hst = .5 * t_sm;
+    // Reverse the kernel vs its traditional definition
+    int i;
+    for (i = 0; i < n; ++i)
+        k->c[i] = i & 1 ? -c[i] : c[i];
+    calc_kernel_moments(k);
+    double sum_w = kernel_moment(k, 0, hst) - kernel_moment(k, 0, -hst);
+    if (!(sum_w > 0.)) {
+        k->num_coeffs = 0;
+        return -1;
+    }
+    for (i = 0; i < n; ++i)
+        k->c[i] /= sum_w;
+    calc_kernel_moments(k);
+    // Time offset that makes the smoother an identity transformation for
+    // constant-speed motion (the equivalent of shift_pulses())
+    k->ts = kernel_moment(k, 1, hst) - kernel_moment(k, 1, -hst);
+    return 0;
+}
+
 
 /****************************************************************
  * Generic position calculation via shaper convolution
@@ -76,35 +143,146 @@ get_axis_position(struct move *m, int axis, double move_time)
     return start_pos + axis_r * move_dist;
 }
 
-static inline double
-get_axis_position_across_moves(struct move *m, int axis, double time)
+// Find the move at a time relative to move 'm' (and update 'time' to be
+// relative to the returned move).  The search starts from the move in
+// 'cursor' (the move last found for the pulse) as the solver evaluates
+// nearby times on successive calls.
+static inline struct move *
+find_move_across_moves(struct move *m, struct move **cursor, double *ptime)
 {
+    struct move *cm = *cursor;
+    double time = *ptime;
+    if (cm != m)
+        time += m->print_time - cm->print_time;
     while (likely(time < 0.)) {
-        m = list_prev_entry(m, node);
-        time += m->move_t;
+        cm = list_prev_entry(cm, node);
+        time += cm->move_t;
     }
-    while (likely(time > m->move_t)) {
-        time -= m->move_t;
-        m = list_next_entry(m, node);
+    while (likely(time > cm->move_t)) {
+        time -= cm->move_t;
+        cm = list_next_entry(cm, node);
     }
-    return get_axis_position(m, axis, time);
+    *cursor = cm;
+    *ptime = time;
+    return cm;
+}
+
+static inline double
+get_axis_position_across_moves(struct move *m, struct move **cursor
+                               , int axis, double time)
+{
+    struct move *cm = find_move_across_moves(m, cursor, &time);
+    return get_axis_position(cm, axis, time);
 }
 
 // Calculate the position from the convolution of the shaper with input signal
 static inline double
 calc_position(struct move *m, int axis, double move_time
-              , struct shaper_pulses *sp)
+              , struct shaper_pulses *sp, struct move **cursors)
 {
     double res = 0.;
     int num_pulses = sp->num_pulses, i;
     for (i = 0; i < num_pulses; ++i) {
         double t = sp->pulses[i].t, a = sp->pulses[i].a;
-        res += a * get_axis_position_across_moves(m, axis, move_time + t);
+        res += a * get_axis_position_across_moves(m, &cursors[i], axis
+                                                  , move_time + t);
+    }
+    return res;
+}
+
+
+// Calculate the position from the convolution of a polynomial kernel
+// with the input signal.  Each move is a quadratic in time, so its
+// contribution is a weighted sum of the kernel moments over the part
+// of the kernel that overlaps the move.
+static inline double
+calc_kernel_position(struct move *m, int axis, double move_time
+                     , struct shaper_kernel *k, struct move **cursor)
+{
+    double hst = k->hst, time = move_time - k->ts - hst;
+    struct move *cm = find_move_across_moves(m, cursor, &time);
+    double d = time + hst, res = 0.;
+    for (;;) {
+        double axis_r = cm->axes_r.axis[axis - 'x'];
+        double lo = -d > -hst ? -d : -hst;
+        double hi = cm->move_t - d < hst ? cm->move_t - d : hst;
+        double m0 = kernel_moment(k, 0, hi) - kernel_moment(k, 0, lo);
+        double m1 = kernel_moment(k, 1, hi) - kernel_moment(k, 1, lo);
+        double m2 = kernel_moment(k, 2, hi) - kernel_moment(k, 2, lo);
+        res += (get_axis_position(cm, axis, d) * m0
+                + axis_r * (cm->start_v + 2. * cm->half_accel * d) * m1
+                + axis_r * cm->half_accel * m2);
+        if (hi >= hst)
+            break;
+        d -= cm->move_t;
+        cm = list_next_entry(cm, node);
     }
     return res;
 }
 
 
+/****************************************************************
+ * Shaped position via piecewise quadratic segments
+ ****************************************************************/
+
+// The shaped position is a weighted sum of time shifted quadratic
+// moves, so it is itself a quadratic function of time between any two
+// move boundaries (shifted by the pulse times).  Rather than repeating
+// the convolution on every solver iteration, the quadratic segment
+// containing the requested time is calculated once and then evaluated
+// directly until the solver leaves that segment.
+
+#define NEVER_SEGMENT_TIME 9999999999999999.9
+
+struct shaper_segment {
+    double base_time, start_time, end_time;
+    double c0, c1, c2;
+};
+
+// Calculate the shaped quadratic segment at the given move time
+static void
+build_segment(struct shaper_segment *seg, struct move *m, int axis
+              , double move_time, struct shaper_pulses *sp
+              , struct move **cursors)
+{
+    double base_time = m->print_time + move_time;
+    double start_time = -NEVER_SEGMENT_TIME, end_time = NEVER_SEGMENT_TIME;
+    double c0 = 0., c1 = 0., c2 = 0.;
+    int num_pulses = sp->num_pulses, i;
+    for (i = 0; i < num_pulses; ++i) {
+        double t = move_time + sp->pulses[i].t, a = sp->pulses[i].a;
+        struct move *cm = find_move_across_moves(m, &cursors[i], &t);
+        double axis_r = cm->axes_r.axis[axis - 'x'];
+        c0 += a * get_axis_position(cm, axis, t);
+        c1 += a * axis_r * (cm->start_v + 2. * cm->half_accel * t);
+        c2 += a * axis_r * cm->half_accel;
+        if (base_time - t > start_time)
+            start_time = base_time - t;
+        if (base_time + cm->move_t - t < end_time)
+            end_time = base_time + cm->move_t - t;
+    }
+    seg->base_time = base_time;
+    seg->start_time = start_time;
+    seg->end_time = end_time;
+    seg->c0 = c0;
+    seg->c1 = c1;
+    seg->c2 = c2;
+}
+
+// Calculate the shaped position using the cached quadratic segment
+static inline double
+calc_segment_position(struct shaper_segment *seg, struct move *m, int axis
+                      , double move_time, struct shaper_pulses *sp
+                      , struct move **cursors)
+{
+    double time = m->print_time + move_time;
+    if (unlikely(time < seg->start_time || time > seg->end_time))
+        build_segment(seg, m, axis, move_time, sp, cursors);
+    double t = time - seg->base_time;
+    return seg->c0 + (seg->c1 + seg->c2 * t) * t;
+}
+
+
 /****************************************************************
  * Kinematics-related shaper code
  ****************************************************************/
@@ -116,18 +294,67 @@ struct input_shaper {
     struct stepper_kinematics *orig_sk;
     struct move m;
     struct shaper_pulses sp[3];
+    struct shaper_kernel kernels[3];
+    // Last move found for each pulse (only valid during one request)
+    uint32_t cursor_seq;
+    struct move *cursors[3][MAX_SHAPER_PULSES];
+    // Cached shaped position segments (if enabled)
+    int use_segments;
+    struct shaper_segment segments[3];
 };
 
+// Reset the pulse move cursors at the start of each itersolve request
+static inline struct move **
+get_cursors(struct input_shaper *is, struct move *m, int axis)
+{
+    if (unlikely(is->cursor_seq != is->sk.gen_seq)) {
+        is->cursor_seq = is->sk.gen_seq;
+        int i, j;
+        for (i = 0; i < ARRAY_SIZE(is->cursors); ++i)
+            for (j = 0; j < ARRAY_SIZE(is->cursors[i]); ++j)
+                is->cursors[i][j] = m;
+        // The trapq may have changed - discard cached segments
+        for (i = 0; i < ARRAY_SIZE(is->segments); ++i) {
+            is->segments[i].start_time = NEVER_SEGMENT_TIME;
+            is->segments[i].end_time = -NEVER_SEGMENT_TIME;
+        }
+    }
+    return is->cursors[axis - 'x'];
+}
+
+// Check if the axis has a shaper or a smoother configured
+static inline int
+shaper_axis_active(struct input_shaper *is, int axis_ind)
+{
+    return is->sp[axis_ind].num_pulses || is->kernels[axis_ind].num_coeffs;
+}
+
+// Calculate the shaped position of an axis
+static inline double
+shaper_calc_axis(struct input_shaper *is, struct move *m, int axis
+                 , double move_time)
+{
+    int axis_ind = axis - 'x';
+    struct shaper_pulses *sp = &is->sp[axis_ind];
+    struct move **cursors = get_cursors(is, m, axis);
+    struct shaper_kernel *k = &is->kernels[axis_ind];
+    if (k->num_coeffs)
+        return calc_kernel_position(m, axis, move_time, k, cursors);
+    if (is->use_segments)
+        return calc_segment_position(&is->segments[axis_ind], m, axis
+                                     , move_time, sp, cursors);
+    return calc_position(m, axis, move_time, sp, cursors);
+}
+
 // Optimized calc_position when only x axis is needed
 static double
 shaper_x_calc_position(struct stepper_kinematics *sk, struct move *m
                        , double move_time)
 {
     struct input_shaper *is = container_of(sk, struct input_shaper, sk);
-    struct shaper_pulses *sx = &is->sp[0];
-    if (!sx->num_pulses)
+    if (!shaper_axis_active(is, 0))
         return is->orig_sk->calc_position_cb(is->orig_sk, m, move_time);
-    is->m.start_pos.x = calc_position(m, 'x', move_time, sx);
+    is->m.start_pos.x = shaper_calc_axis(is, m, 'x', move_time);
     return is->orig_sk->calc_position_cb(is->orig_sk, &is->m, DUMMY_T);
 }
 
@@ -137,10 +364,9 @@ shaper_y_calc_position(struct stepper_kinematics *sk, struct move *m
                        , double move_time)
 {
     struct input_shaper *is = container_of(sk, struct input_shaper, sk);
-    struct shaper_pulses *sy = &is->sp[1];
-    if (!sy->num_pulses)
+    if (!shaper_axis_active(is, 1))
         return is->orig_sk->calc_position_cb(is->orig_sk, m, move_time);
-    is->m.start_pos.y = calc_position(m, 'y', move_time, sy);
+    is->m.start_pos.y = shaper_calc_axis(is, m, 'y', move_time);
     return is->orig_sk->calc_position_cb(is->orig_sk, &is->m, DUMMY_T);
 }
 
@@ -150,10 +376,9 @@ shaper_z_calc_position(struct stepper_kinematics *sk, struct move *m
                        , double move_time)
 {
     struct input_shaper *is = container_of(sk, struct input_shaper, sk);
-    struct shaper_pulses *sz = &is->sp[2];
-    if (!sz->num_pulses)
+    if (!shaper_axis_active(is, 2))
         return is->orig_sk->calc_position_cb(is->orig_sk, m, move_time);
-    is->m.start_pos.z = calc_position(m, 'z', move_time, sz);
+    is->m.start_pos.z = shaper_calc_axis(is, m, 'z', move_time);
     return is->orig_sk->calc_position_cb(is->orig_sk, &is->m, DUMMY_T);
 }
 
@@ -163,15 +388,16 @@ shaper_xyz_calc_position(struct stepper_kinematics *sk, struct move *m
                          , double move_time)
 {
     struct input_shaper *is = container_of(sk, struct input_shaper, sk);
-    if (!is->sp[0].num_pulses && !is->sp[1].num_pulses && !is->sp[2].num_pulses)
+    if (!shaper_axis_active(is, 0) && !shaper_axis_active(is, 1)
+        && !shaper_axis_active(is, 2))
         return is->orig_sk->calc_position_cb(is->orig_sk, m, move_time);
     is->m.start_pos = move_get_coord(m, move_time);
-    if (is->sp[0].num_pulses)
-        is->m.start_pos.x = calc_position(m, 'x', move_time, &is->sp[0]);
-    if (is->sp[1].num_pulses)
-        is->m.start_pos.y = calc_position(m, 'y', move_time, &is->sp[1]);
-    if (is->sp[2].num_pulses)
-        is->m.start_pos.z = calc_position(m, 'z', move_time, &is->sp[2]);
+    if (shaper_axis_active(is, 0))
+        is->m.start_pos.x = shaper_calc_axis(is, m, 'x', move_time);
+    if (shaper_axis_active(is, 1))
+        is->m.start_pos.y = shaper_calc_axis(is, m, 'y', move_time);
+    if (shaper_axis_active(is, 2))
+        is->m.start_pos.z = shaper_calc_axis(is, m, 'z', move_time);
     return is->orig_sk->calc_position_cb(is->orig_sk, &is->m, DUMMY_T);
 }
 
@@ -189,24 +415,22 @@ static void
 shaper_note_generation_time(struct input_shaper *is)
 {
     double pre_active = 0., post_active = 0.;
-    struct shaper_pulses *sx = &is->sp[0];
-    if ((is->sk.active_flags & AF_X) && sx->num_pulses) {
-        pre_active = sx->pulses[sx->num_pulses-1].t;
-        post_active = -sx->pulses[0].t;
-    }
-    struct shaper_pulses *sy = &is->sp[1];
-    if ((is->sk.active_flags & AF_Y) && sy->num_pulses) {
-        pre_active = sy->pulses[sy->num_pulses-1].t > pre_active
-            ? sy->pulses[sy->num_pulses-1].t : pre_active;
-        post_active = -sy->pulses[0].t > post_active
-            ? -sy->pulses[0].t : post_active;
-    }
-    struct shaper_pulses *sz = &is->sp[2];
-    if ((is->sk.active_flags & AF_Z) && sz->num_pulses) {
-        pre_active = sz->pulses[sz->num_pulses-1].t > pre_active
-            ? sz->pulses[sz->num_pulses-1].t : pre_active;
-        post_active = -sz->pulses[0].t > post_active
-            ? -sz->pulses[0].t : post_active;
+    int i;
+    for (i = 0; i < ARRAY_SIZE(KIN_FLAGS); ++i) {
+        if (!(is->sk.active_flags & KIN_FLAGS[i]))
+            continue;
+        double pre = 0., post = 0.;
+        struct shaper_pulses *sp = &is->sp[i];
+        struct shaper_kernel *k = &is->kernels[i];
+        if (sp->num_pulses) {
+            pre = sp->pulses[sp->num_pulses-1].t;
+            post = -sp->pulses[0].t;
+        } else if (k->num_coeffs) {
+            pre = k->hst - k->ts;
+            post = k->hst + k->ts;
+        }
+        pre_active = pre > pre_active ? pre : pre_active;
+        post_active = post > post_active ? post : post_active;
     }
     is->sk.gen_steps_pre_active = pre_active;
     is->sk.gen_steps_post_active = post_active;
@@ -268,16 +492,51 @@ input_shaper_set_shaper_params(struct stepper_kinematics *sk, char axis
     // Ignore input shaper update if the axis is not active
     if (is->orig_sk->active_flags & KIN_FLAGS[axis_ind]) {
         status = init_shaper(n, a, t, sp);
+        is->kernels[axis_ind].num_coeffs = 0;
+        shaper_note_generation_time(is);
+    }
+    // Discard cached segments
+    is->cursor_seq = is->sk.gen_seq - 1;
+    return status;
+}
+
+// Configure a smoother given by the polynomial coefficients 'c' of its
+// kernel over the time range [-t_sm/2, t_sm/2] (replaces any shaper)
+int __visible
+input_shaper_set_smoother_params(struct stepper_kinematics *sk, char axis
+                                 , int n, double c[], double t_sm)
+{
+    int axis_ind = axis-'x';
+    if (axis_ind < 0 || axis_ind >= ARRAY_SIZE(KIN_FLAGS))
+        return -1;
+    struct input_shaper *is = container_of(sk, struct input_shaper, sk);
+    struct shaper_kernel *k = &is->kernels[axis_ind];
+    int status = 0;
+    // Ignore smoother update if the axis is not active
+    if (is->orig_sk->active_flags & KIN_FLAGS[axis_ind]) {
+        status = init_kernel(n, c, t_sm, k);
+        is->sp[axis_ind].num_pulses = 0;
         shaper_note_generation_time(is);
     }
+    is->cursor_seq = is->sk.gen_seq - 1;
     return status;
 }
 
+// Calculate the shaped position from cached piecewise quadratic segments
+void __visible
+input_shaper_set_segments(struct stepper_kinematics *sk, int enable)
+{
+    struct input_shaper *is = container_of(sk, struct input_shaper, sk);
+    is->use_segments = enable;
+    is->cursor_seq = is->sk.gen_seq - 1;
+}
+
 struct stepper_kinematics * __visible
 input_shaper_alloc(void)
 {
     struct input_shaper *is = malloc(sizeof(*is));
     memset(is, 0, sizeof(*is));
     is->m.move_t = 2. * DUMMY_T;
+    is->cursor_seq = is->sk.gen_seq - 1;
     return &is->sk;
 }
@@ -0,0 +1,298 @@
+// Toolhead move "look-ahead" junction velocity planning
+//
+// Copyright (C) 2016-2026  Kevin O'Connor <kevin@koconnor.net>
+//
+// This file may be distributed under the terms of the GNU GPLv3 license.
+
+// The python toolhead code creates a 'class Move' for each requested
+// move and then adds its kinematic parameters to this queue.  The
+// code here determines the maximum junction speed between moves, and
+// on a flush it calculates the final velocities of each move (using a
+// backward and then forward pass over the queue).  Flushed moves can
+// then be appended directly to a trapq.
+
+#include <math.h> // sqrt
+#include <stdlib.h> // malloc
+#include <string.h> // memset
+#include "compiler.h" // __visible
+#include "pyhelper.h" // errorf
+#include "trapq.h" // trapq_append
+
+struct lookahead_move {
+    // Move parameters
+    double start_pos[3], axes_r[3];
+    double move_d, accel, junction_deviation;
+    double max_cruise_v2, delta_v2, mcr_delta_v2, next_junction_v2;
+    int is_kinematic_move;
+    // Junction limits (calculated when the move is added)
+    double max_start_v2, max_mcr_start_v2;
+    // Final velocities (calculated on a flush)
+    double start_v, cruise_v, end_v;
+    double accel_t, cruise_t, decel_t;
+    // Temporary storage used during a flush
+    double flush_start_v2, flush_cruise_v2, flush_next_start_v2;
+};
+
+struct lookahead {
+    struct lookahead_move *moves;
+    int move_count, move_alloc, flush_count;
+};
+
+// Helpers that match the semantics of python's min() and max()
+static inline double
+dmin(double a, double b)
+{
+    return b < a ? b : a;
+}
+
+static inline double
+dmax(double a, double b)
+{
+    return b > a ? b : a;
+}
+
+// Allocate a new 'lookahead' object
+struct lookahead * __visible
+lookahead_alloc(void)
+{
+    struct lookahead *la = malloc(sizeof(*la));
+    memset(la, 0, sizeof(*la));
+    return la;
+}
+
+// Free memory associated with a 'lookahead' object
+void __visible
+lookahead_free(struct lookahead *la)
+{
+    if (!la)
+        return;
+    free(la->moves);
+    free(la);
+}
+
+// Discard moves returned by a previous lookahead_flush()
+static void
+discard_flushed(struct lookahead *la)
+{
+    int flush_count = la->flush_count;
+    if (!flush_count)
+        return;
+    la->move_count -= flush_count;
+    memmove(la->moves, &la->moves[flush_count]
+            , la->move_count * sizeof(la->moves[0]));
+    la->flush_count = 0;
+}
+
+// Remove all moves from the queue
+void __visible
+lookahead_reset(struct lookahead *la)
+{
+    la->move_count = la->flush_count = 0;
+}
+
+// Determine the maximum velocity at the junction between two moves
+static void
+calc_junction(struct lookahead_move *m, struct lookahead_move *prev
+              , double extra_axes_v2)
+{
+    if (!m->is_kinematic_move || !prev->is_kinematic_move)
+        return;
+    double max_start_v2 = dmin(m->max_cruise_v2, prev->max_cruise_v2);
+    max_start_v2 = dmin(max_start_v2, prev->next_junction_v2);
+    max_start_v2 = dmin(max_start_v2, prev->max_start_v2 + prev->delta_v2);
+    max_start_v2 = dmin(max_start_v2, extra_axes_v2);
+    // Find max velocity using "approximated centripetal velocity"
+    double *axes_r = m->axes_r, *prev_axes_r = prev->axes_r;
+    double junction_cos_theta = -(axes_r[0] * prev_axes_r[0]
+                                  + axes_r[1] * prev_axes_r[1]
+                                  + axes_r[2] * prev_axes_r[2]);
+    double sin_theta_d2 = sqrt(dmax(0.5*(1.0-junction_cos_theta), 0.));
+    double cos_theta_d2 = sqrt(dmax(0.5*(1.0+junction_cos_theta), 0.));
+    double one_minus_sin_theta_d2 = 1. - sin_theta_d2;
+    if (one_minus_sin_theta_d2 > 0. && cos_theta_d2 > 0.) {
+        double R_jd = sin_theta_d2 / one_minus_sin_theta_d2;
+        double move_jd_v2 = R_jd * m->junction_deviation * m->accel;
+        double pmove_jd_v2 = R_jd * prev->junction_deviation * prev->accel;
+        // Approximated circle must contact moves no further than mid-move
+        //   centripetal_v2 = .5 * move_d * accel * tan_theta_d2
+        double quarter_tan_theta_d2 = .25 * sin_theta_d2 / cos_theta_d2;
+        double move_centripetal_v2 = m->delta_v2 * quarter_tan_theta_d2;
+        double pmove_centripetal_v2 = prev->delta_v2 * quarter_tan_theta_d2;
+        max_start_v2 = dmin(max_start_v2, move_jd_v2);
+        max_start_v2 = dmin(max_start_v2, pmove_jd_v2);
+        max_start_v2 = dmin(max_start_v2, move_centripetal_v2);
+        max_start_v2 = dmin(max_start_v2, pmove_centripetal_v2);
+    }
+    // Apply limits
+    m->max_start_v2 = max_start_v2;
+    m->max_mcr_start_v2 = dmin(
+        max_start_v2, prev->max_mcr_start_v2 + prev->mcr_delta_v2);
+}
+
+// Add a move to the lookahead queue.  The 'extra_axes_v2' parameter
+// is the maximum junction speed (squared) permitted by the extra axes.
+// Returns 0 on success or -1 if the move could not be stored.
+int __visible
+lookahead_add_move(struct lookahead *la
+                   , double start_x, double start_y, double start_z
+                   , double axes_r_x, double axes_r_y, double axes_r_z
+                   , double move_d, double accel, double junction_deviation
+                   , double max_cruise_v2, double mcr_delta_v2
+                   , int is_kinematic_move, double extra_axes_v2)
+{
+    discard_flushed(la);
+    if (la->move_count >= la->move_alloc) {
+        int new_alloc = la->move_alloc ? la->move_alloc * 2 : 64;
+        struct lookahead_move *nm = realloc(la->moves
+                                            , new_alloc * sizeof(*nm));
+        if (!nm) {
+            errorf("lookahead_add_move: out of memory");
+            return -1;
+        }
+        la->moves = nm;
+        la->move_alloc = new_alloc;
+    }
+    struct lookahead_move *m = &la->moves[la->move_count++];
+    memset(m, 0, sizeof(*m));
+    m->start_pos[0] = start_x;
+    m->start_pos[1] = start_y;
+    m->start_pos[2] = start_z;
+    m->axes_r[0] = axes_r_x;
+    m->axes_r[1] = axes_r_y;
+    m->axes_r[2] = axes_r_z;
+    m->move_d = move_d;
+    m->accel = accel;
+    m->junction_deviation = junction_deviation;
+    m->max_cruise_v2 = max_cruise_v2;
+    m->delta_v2 = 2.0 * move_d * accel;
+    m->mcr_delta_v2 = mcr_delta_v2;
+    m->next_junction_v2 = 999999999.9;
+    m->is_kinematic_move = is_kinematic_move;
+    if (la->move_count > 1)
+        calc_junction(m, m - 1, extra_axes_v2);
+    return 0;
+}
+
+// Limit the junction speed (squared) after the last queued move
+void __visible
+lookahead_limit_next_junction(struct lookahead *la, double v2)
+{
+    discard_flushed(la);
+    if (!la->move_count)
+        return;
+    struct lookahead_move *m = &la->moves[la->move_count - 1];
+    m->next_junction_v2 = dmin(m->next_junction_v2, v2);
+}
+
+// Determine the accel, cruise, and decel portions of a move
+static void
+set_junction(struct lookahead_move *m, double start_v2, double cruise_v2
+             , double end_v2)
+{
+    // Determine accel, cruise, and decel portions of the move distance
+    double half_inv_accel = .5 / m->accel;
+    double accel_d = (cruise_v2 - start_v2) * half_inv_accel;
+    double decel_d = (cruise_v2 - end_v2) * half_inv_accel;
+    double cruise_d = m->move_d - accel_d - decel_d;
+    // Determine move velocities
+    double start_v = m->start_v = sqrt(start_v2);
+    double cruise_v = m->cruise_v = sqrt(cruise_v2);
+    double end_v = m->end_v = sqrt(end_v2);
+    // Determine time spent in each portion of move (time is the
+    // distance divided by average velocity)
+    m->accel_t = accel_d / ((start_v + cruise_v) * 0.5);
+    m->cruise_t = cruise_d / cruise_v;
+    m->decel_t = decel_d / ((end_v + cruise_v) * 0.5);
+}
+
+// Calculate the final velocities of queued moves.  Returns the number
+// of moves that were flushed (these moves are available at the start
+// of the array returned by lookahead_get_moves() until the next call
+// that modifies the queue).
+int __visible
+lookahead_flush(struct lookahead *la, int lazy)
+{
+    discard_flushed(la);
+    struct lookahead_move *moves = la->moves;
+    int update_flush_count = lazy;
+    int flush_count = la->move_count;
+    // Traverse queue from last to first move and determine maximum
+    // junction speed assuming the robot comes to a complete stop
+    // after the last move.
+    double next_start_v2 = 0., next_mcr_start_v2 = 0., peak_cruise_v2 = 0.;
+    int i, pending_cv2_assign = 0;
+    for (i = flush_count - 1; i >= 0; i--) {
+        struct lookahead_move *m = &moves[i];
+        double reachable_start_v2 = next_start_v2 + m->delta_v2;
+        double start_v2 = dmin(m->max_start_v2, reachable_start_v2);
+        double cruise_v2 = -1.; // Not yet known
+        pending_cv2_assign++;
+        double reach_mcr_start_v2 = next_mcr_start_v2 + m->mcr_delta_v2;
+        double mcr_start_v2 = dmin(m->max_mcr_start_v2, reach_mcr_start_v2);
+        if (mcr_start_v2 < reach_mcr_start_v2) {
+            // It's possible for this move to accelerate
+            if (mcr_start_v2 + m->mcr_delta_v2 > next_mcr_start_v2
+                || pending_cv2_assign > 1) {
+                // This move can both accel and decel, or this is a
+                // full accel move followed by a full decel move
+                if (update_flush_count && peak_cruise_v2) {
+                    flush_count = i + pending_cv2_assign;
+                    update_flush_count = 0;
+                }
+                peak_cruise_v2 = (mcr_start_v2 + reach_mcr_start_v2) * .5;
+            }
+            cruise_v2 = dmin((start_v2 + reachable_start_v2) * .5
+                             , m->max_cruise_v2);
+            cruise_v2 = dmin(cruise_v2, peak_cruise_v2);
+            pending_cv2_assign = 0;
+        }
+        m->flush_start_v2 = start_v2;
+        m->flush_cruise_v2 = cruise_v2;
+        m->flush_next_start_v2 = next_start_v2;
+        next_start_v2 = start_v2;
+        next_mcr_start_v2 = mcr_start_v2;
+    }
+    if (update_flush_count || !flush_count)
+        return 0;
+    // Traverse queue in forward direction to propagate cruise_v2
+    double prev_cruise_v2 = 0.;
+    for (i = 0; i < flush_count; i++) {
+        struct lookahead_move *m = &moves[i];
+        double start_v2 = m->flush_start_v2;
+        double cruise_v2 = m->flush_cruise_v2;
+        if (cruise_v2 < 0.)
+            // This move can't accelerate - propagate cruise_v2 from previous
+            cruise_v2 = dmin(prev_cruise_v2, start_v2);
+        set_junction(m, dmin(start_v2, cruise_v2), cruise_v2
+                     , dmin(m->flush_next_start_v2, cruise_v2));
+        prev_cruise_v2 = cruise_v2;
+    }
+    la->flush_count = flush_count;
+    return flush_count;
+}
+
+// Return the array of queued moves
+struct lookahead_move * __visible
+lookahead_get_moves(struct lookahead *la)
+{
+    return la->moves;
+}
+
+// Append the kinematic moves from the last flush to a trapq.  Returns
+// the end time of the last flushed move.
+double __visible
+lookahead_queue_moves(struct lookahead *la, struct trapq *tq
+                      , double print_time)
+{
+    int i;
+    for (i = 0; i < la->flush_count; i++) {
+        struct lookahead_move *m = &la->moves[i];
+        if (m->is_kinematic_move)
+            trapq_append(tq, print_time, m->accel_t, m->cruise_t, m->decel_t
+                         , m->start_pos[0], m->start_pos[1], m->start_pos[2]
+                         , m->axes_r[0], m->axes_r[1], m->axes_r[2]
+                         , m->start_v, m->cruise_v, m->accel);
+        print_time = print_time + m->accel_t + m->cruise_t + m->decel_t;
+    }
+    return print_time;
+}
@@ -0,0 +1,150 @@
+// Fixed size object pools
+//
+// Copyright (C) 2026  Kevin O'Connor <kevin@koconnor.net>
+//
+// This file may be distributed under the terms of the GNU GPLv3 license.
+
+// A mempool hands out objects of a single size from large "slab"
+// allocations.  Objects may only be obtained (mempool_get) by the
+// owner of the pool (callers must ensure those calls are serialized),
+// but they may be released (mempool_put) from any thread.  Released
+// objects are placed on a lock-free stack that the owner reclaims in
+// bulk once its local free list is empty.  The pool memory is released
+// only after the owner calls mempool_free() and all outstanding
+// objects are returned.
+
+#include <stdlib.h> // malloc
+#include <string.h> // memset
+#include "compiler.h" // ALIGN
+#include "mempool.h" // mempool_alloc
+#include "pyhelper.h" // errorf
+
+#define SLAB_OBJECTS 128
+
+struct mempool_free_obj {
+    struct mempool_free_obj *next;
+};
+
+struct mempool_slab {
+    struct mempool_slab *next;
+    uint64_t data[];
+};
+
+struct mempool {
+    int obj_size;
+    // Pool owner state
+    struct mempool_free_obj *free_list;
+    struct mempool_slab *slabs;
+    uint64_t alloc_count;
+    uint32_t slab_count;
+    // Shared state (accessed with atomic instructions)
+    struct mempool_free_obj *remote_free;
+    uint32_t users;
+};
+
+// Allocate a new pool for objects of the given size
+struct mempool *
+mempool_alloc(int obj_size)
+{
+    struct mempool *mp = malloc(sizeof(*mp));
+    memset(mp, 0, sizeof(*mp));
+    if (obj_size < sizeof(struct mempool_free_obj))
+        obj_size = sizeof(struct mempool_free_obj);
+    mp->obj_size = ALIGN(obj_size, sizeof(uint64_t));
+    mp->users = 1;
+    return mp;
+}
+
+// Release all memory of a pool
+static void
+mempool_release(struct mempool *mp)
+{
+    while (mp->slabs) {
+        struct mempool_slab *slab = mp->slabs;
+        mp->slabs = slab->next;
+        free(slab);
+    }
+    free(mp);
+}
+
+// Drop a reference to the pool (freeing it if it was the last)
+static void
+mempool_unref(struct mempool *mp)
+{
+    if (!__atomic_sub_fetch(&mp->users, 1, __ATOMIC_ACQ_REL))
+        mempool_release(mp);
+}
+
+// Release the owner's reference to the pool
+void
+mempool_free(struct mempool *mp)
+{
+    if (!mp)
+        return;
+    mempool_unref(mp);
+}
+
+// Populate the free list with a new slab of objects
+static void
+mempool_add_slab(struct mempool *mp)
+{
+    struct mempool_slab *slab = malloc(sizeof(*slab)
+                                       + mp->obj_size * SLAB_OBJECTS);
+    if (!slab) {
+        errorf("mempool slab allocation failed");
+        abort();
+    }
+    slab->next = mp->slabs;
+    mp->slabs = slab;
+    mp->slab_count++;
+    char *p = (char*)slab->data + mp->obj_size * SLAB_OBJECTS;
+    int i;
+    for (i=0; i<SLAB_OBJECTS; i++) {
+        p -= mp->obj_size;
+        struct mempool_free_obj *fo = (void*)p;
+        fo->next = mp->free_list;
+        mp->free_list = fo;
+    }
+}
+
+// Obtain an object from the pool (only valid from the pool owner)
+void *
+mempool_get(struct mempool *mp)
+{
+    struct mempool_free_obj *fo = mp->free_list;
+    if (unlikely(!fo)) {
+        // Reclaim any objects released by other threads
+        fo = __atomic_exchange_n(&mp->remote_free, NULL, __ATOMIC_ACQUIRE);
+        if (!fo) {
+            mempool_add_slab(mp);
+            fo = mp->free_list;
+        }
+    }
+    mp->free_list = fo->next;
+    mp->alloc_count++;
+    __atomic_add_fetch(&mp->users, 1, __ATOMIC_RELAXED);
+    return fo;
+}
+
+// Return an object to the pool (may be called from any thread)
+void
+mempool_put(struct mempool *mp, void *obj)
+{
+    struct mempool_free_obj *fo = obj;
+    fo->next = __atomic_load_n(&mp->remote_free, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&mp->remote_free, &fo->next, fo, 1
+                                        , __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+        ;
+    mempool_unref(mp);
+}
+
+// Report pool usage statistics (only valid from the pool owner, or
+// after synchronizing with it while it is idle)
+void
+mempool_get_stats(struct mempool *mp, struct mempool_stats *stats)
+{
+    stats->alloc_count = mp->alloc_count;
+    stats->slab_count = mp->slab_count;
+    stats->obj_count = mp->slab_count * SLAB_OBJECTS;
+    stats->in_use = __atomic_load_n(&mp->users, __ATOMIC_RELAXED) - 1;
+}
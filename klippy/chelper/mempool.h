@@ -0,0 +1,18 @@
+#ifndef MEMPOOL_H
+#define MEMPOOL_H
+
+#include <stdint.h> // uint64_t
+
+struct mempool_stats {
+    uint64_t alloc_count;
+    uint32_t slab_count, obj_count, in_use;
+};
+
+struct mempool;
+struct mempool *mempool_alloc(int obj_size);
+void mempool_free(struct mempool *mp);
+void *mempool_get(struct mempool *mp);
+void mempool_put(struct mempool *mp, void *obj);
+void mempool_get_stats(struct mempool *mp, struct mempool_stats *stats);
+
+#endif // mempool.h
@@ -7,6 +7,8 @@
 #include <stddef.h> // offsetof
 #include <stdlib.h> // malloc
 #include <string.h> // memset
+#include "compiler.h" // __visible
+#include "mempool.h" // mempool_get
 #include "msgblock.h" // message_alloc
 #include "pyhelper.h" // errorf
 
@@ -15,18 +17,49 @@
  * Serial protocol helpers
  ****************************************************************/
 
+// Lookup table for the crc "ccitt" algorithm (one entry per input byte)
+static const uint16_t crc16_ccitt_table[256] = {
+    0x0000, 0x1189, 0x2312, 0x329b, 0x4624, 0x57ad, 0x6536, 0x74bf,
+    0x8c48, 0x9dc1, 0xaf5a, 0xbed3, 0xca6c, 0xdbe5, 0xe97e, 0xf8f7,
+    0x1081, 0x0108, 0x3393, 0x221a, 0x56a5, 0x472c, 0x75b7, 0x643e,
+    0x9cc9, 0x8d40, 0xbfdb, 0xae52, 0xdaed, 0xcb64, 0xf9ff, 0xe876,
+    0x2102, 0x308b, 0x0210, 0x1399, 0x6726, 0x76af, 0x4434, 0x55bd,
+    0xad4a, 0xbcc3, 0x8e58, 0x9fd1, 0xeb6e, 0xfae7, 0xc87c, 0xd9f5,
+    0x3183, 0x200a, 0x1291, 0x0318, 0x77a7, 0x662e, 0x54b5, 0x453c,
+    0xbdcb, 0xac42, 0x9ed9, 0x8f50, 0xfbef, 0xea66, 0xd8fd, 0xc974,
+    0x4204, 0x538d, 0x6116, 0x709f, 0x0420, 0x15a9, 0x2732, 0x36bb,
+    0xce4c, 0xdfc5, 0xed5e, 0xfcd7, 0x8868, 0x99e1, 0xab7a, 0xbaf3,
+    0x5285, 0x430c, 0x7197, 0x601e, 0x14a1, 0x0528, 0x37b3, 0x263a,
+    0xdecd, 0xcf44, 0xfddf, 0xec56, 0x98e9, 0x8960, 0xbbfb, 0xaa72,
+    0x6306, 0x728f, 0x4014, 0x519d, 0x2522, 0x34ab, 0x0630, 0x17b9,
+    0xef4e, 0xfec7, 0xcc5c, 0xddd5, 0xa96a, 0xb8e3, 0x8a78, 0x9bf1,
+    0x7387, 0x620e, 0x5095, 0x411c, 0x35a3, 0x242a, 0x16b1, 0x0738,
+    0xffcf, 0xee46, 0xdcdd, 0xcd54, 0xb9eb, 0xa862, 0x9af9, 0x8b70,
+    0x8408, 0x9581, 0xa71a, 0xb693, 0xc22c, 0xd3a5, 0xe13e, 0xf0b7,
+    0x0840, 0x19c9, 0x2b52, 0x3adb, 0x4e64, 0x5fed, 0x6d76, 0x7cff,
+    0x9489, 0x8500, 0xb79b, 0xa612, 0xd2ad, 0xc324, 0xf1bf, 0xe036,
+    0x18c1, 0x0948, 0x3bd3, 0x2a5a, 0x5ee5, 0x4f6c, 0x7df7, 0x6c7e,
+    0xa50a, 0xb483, 0x8618, 0x9791, 0xe32e, 0xf2a7, 0xc03c, 0xd1b5,
+    0x2942, 0x38cb, 0x0a50, 0x1bd9, 0x6f66, 0x7eef, 0x4c74, 0x5dfd,
+    0xb58b, 0xa402, 0x9699, 0x8710, 0xf3af, 0xe226, 0xd0bd, 0xc134,
+    0x39c3, 0x284a, 0x1ad1, 0x0b58, 0x7fe7, 0x6e6e, 0x5cf5, 0x4d7c,
+    0xc60c, 0xd785, 0xe51e, 0xf497, 0x8028, 0x91a1, 0xa33a, 0xb2b3,
+    0x4a44, 0x5bcd, 0x6956, 0x78df, 0x0c60, 0x1de9, 0x2f72, 0x3efb,
+    0xd68d, 0xc704, 0xf59f, 0xe416, 0x90a9, 0x8120, 0xb3bb, 0xa232,
+    0x5ac5, 0x4b4c, 0x79d7, 0x685e, 0x1ce1, 0x0d68, 0x3ff3, 0x2e7a,
+    0xe70e, 0xf687, 0xc41c, 0xd595, 0xa12a, 0xb0a3, 0x8238, 0x93b1,
+    0x6b46, 0x7acf, 0x4854, 0x59dd, 0x2d62, 0x3ceb, 0x0e70, 0x1ff9,
+    0xf78f, 0xe606, 0xd49d, 0xc514, 0xb1ab, 0xa022, 0x92b9, 0x8330,
+    0x7bc7, 0x6a4e, 0x58d5, 0x495c, 0x3de3, 0x2c6a, 0x1ef1, 0x0f78,
+};
+
 // Implement the standard crc "ccitt" algorithm on the given buffer
-uint16_t
+uint16_t __visible
 msgblock_crc16_ccitt(uint8_t *buf, uint8_t len)
 {
     uint16_t crc = 0xffff;
-    while (len--) {
-        uint8_t data = *buf++;
-        data ^= crc & 0xff;
-        data ^= data << 4;
-        crc = ((((uint16_t)data << 8) | (crc >> 8)) ^ (uint8_t)(data >> 4)
-               ^ ((uint16_t)data << 3));
-    }
+    while (len--)
+        crc = (crc >> 8) ^ crc16_ccitt_table[(uint8_t)(crc ^ *buf++)];
     return crc;
 }
 
@@ -119,6 +152,131 @@ msgblock_decode(uint32_t *data, int data_len, uint8_t *msg, int msg_len)
 }
 
 
+/****************************************************************
+ * Response parsing
+ ****************************************************************/
+
+// The parameter types of each message id in the data dictionary are
+// registered as a string of type codes ('u' for an unsigned integer,
+// 'i' for a signed integer, and 's' for a buffer).  Parsing a message
+// fills a compact record with the integer parameters, and with the
+// offset of the length byte of each buffer parameter.
+
+// Message ids in the data dictionary start at -32 (the smallest id
+// that fits in a single vlq byte)
+#define MSGPARSER_MIN_ID -32
+#define MSGPARSER_MAX_ID 1024
+
+struct msgparser {
+    char *param_types[MSGPARSER_MAX_ID - MSGPARSER_MIN_ID];
+};
+
+// Allocate a new 'struct msgparser' object
+struct msgparser * __visible
+msgparser_alloc(void)
+{
+    struct msgparser *mp = malloc(sizeof(*mp));
+    memset(mp, 0, sizeof(*mp));
+    return mp;
+}
+
+// Free all resources associated with a msgparser
+void __visible
+msgparser_free(struct msgparser *mp)
+{
+    if (!mp)
+        return;
+    int i;
+    for (i=0; i<ARRAY_SIZE(mp->param_types); i++)
+        free(mp->param_types[i]);
+    free(mp);
+}
+
+// Register the parameter types of a message id
+int __visible
+msgparser_add_message(struct msgparser *mp, int msgid, char *param_types)
+{
+    if (msgid < MSGPARSER_MIN_ID || msgid >= MSGPARSER_MAX_ID)
+        return -1;
+    int count = strlen(param_types);
+    if (count > MSGPARSER_MAX_PARAMS
+        || strspn(param_types, "uis") != count)
+        return -1;
+    int idx = msgid - MSGPARSER_MIN_ID;
+    free(mp->param_types[idx]);
+    mp->param_types[idx] = strdup(param_types);
+    return 0;
+}
+
+// Parse a vlq integer while checking for the end of the buffer.  The
+// value is not truncated to 32 bits so that signed parameters match
+// the results of the python parser (msgproto.py PT_int32).
+int
+msgblock_parse_int(uint8_t **pp, uint8_t *end, int64_t *pv)
+{
+    uint8_t *p = *pp;
+    if (p >= end)
+        return -1;
+    uint8_t c = *p++;
+    int64_t v = c & 0x7f;
+    if ((c & 0x60) == 0x60)
+        v |= -0x20;
+    while (c & 0x80) {
+        if (p >= end || p - *pp >= 5)
+            return -1;
+        c = *p++;
+        v = v * 128 + (c & 0x7f);
+    }
+    *pp = p;
+    *pv = v;
+    return 0;
+}
+
+// Parse a message block containing a single message.  Returns -1 if
+// the message id is not registered or if the message is malformed.
+int __visible
+msgparser_parse(struct msgparser *mp, uint8_t *msg, int msg_len
+                , struct msgparser_record *rec)
+{
+    if (msg_len < MESSAGE_MIN)
+        return -1;
+    uint8_t *p = &msg[MESSAGE_HEADER_SIZE];
+    uint8_t *end = &msg[msg_len - MESSAGE_TRAILER_SIZE];
+    int64_t v;
+    if (msgblock_parse_int(&p, end, &v))
+        return -1;
+    int64_t msgid = v;
+    if (msgid < MSGPARSER_MIN_ID || msgid >= MSGPARSER_MAX_ID)
+        return -1;
+    // The python parser skips the id using its shortest encoding, so
+    // let it handle any message that uses a longer encoding
+    uint8_t idbuf[5];
+    if (p - &msg[MESSAGE_HEADER_SIZE] != encode_int(idbuf, msgid) - idbuf)
+        return -1;
+    char *pt = mp->param_types[msgid - MSGPARSER_MIN_ID];
+    if (!pt)
+        return -1;
+    int64_t *values = rec->values;
+    for (; *pt; pt++) {
+        if (*pt == 's') {
+            if (p >= end || p + 1 + *p > end)
+                return -1;
+            *values++ = p - msg;
+            p += 1 + *p;
+            continue;
+        }
+        if (msgblock_parse_int(&p, end, &v))
+            return -1;
+        *values++ = *pt == 'i' ? v : (v & 0xffffffff);
+    }
+    if (p != end)
+        return -1;
+    rec->msgid = msgid;
+    rec->param_count = values - rec->values;
+    return 0;
+}
+
+
 /****************************************************************
  * Command queues
  ****************************************************************/
@@ -142,11 +300,10 @@ message_fill(uint8_t *data, int len)
     return qm;
 }
 
-// Allocate a queue_message and fill it with a series of encoded vlq integers
-struct queue_message *
-message_alloc_and_encode(uint32_t *data, int len)
+// Fill a queue_message with a series of encoded vlq integers
+static struct queue_message *
+message_encode(struct queue_message *qm, uint32_t *data, int len)
 {
-    struct queue_message *qm = message_alloc();
     int i;
     uint8_t *p = qm->msg;
     for (i=0; i<len; i++) {
@@ -163,11 +320,31 @@ fail:
     return qm;
 }
 
+// Allocate a queue_message and fill it with a series of encoded vlq integers
+struct queue_message *
+message_alloc_and_encode(uint32_t *data, int len)
+{
+    return message_encode(message_alloc(), data, len);
+}
+
+// Allocate a queue_message from a mempool and encode the given integers
+struct queue_message *
+message_pool_alloc_and_encode(struct mempool *mp, uint32_t *data, int len)
+{
+    struct queue_message *qm = mempool_get(mp);
+    memset(qm, 0, sizeof(*qm));
+    qm->pool = mp;
+    return message_encode(qm, data, len);
+}
+
 // Free the storage from a previous message_alloc() call
 void
 message_free(struct queue_message *qm)
 {
-    free(qm);
+    if (qm->pool)
+        mempool_put(qm->pool, qm);
+    else
+        free(qm);
 }
 
 // Free all the messages on a queue
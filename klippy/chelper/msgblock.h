@@ -32,6 +32,15 @@ struct queue_message {
     };
     uint64_t notify_id;
     struct list_node node;
+    // Pool the message was allocated from (or NULL if from malloc)
+    struct mempool *pool;
+};
+
+#define MSGPARSER_MAX_PARAMS 16
+
+struct msgparser_record {
+    int32_t msgid, param_count;
+    int64_t values[MSGPARSER_MAX_PARAMS];
 };
 
 struct clock_estimate {
@@ -39,12 +48,19 @@ struct clock_estimate {
     double conv_time, est_freq;
 };
 
+struct msgparser;
+int msgparser_parse(struct msgparser *mp, uint8_t *msg, int msg_len
+                    , struct msgparser_record *rec);
 uint16_t msgblock_crc16_ccitt(uint8_t *buf, uint8_t len);
 int msgblock_check(uint8_t *need_sync, uint8_t *buf, int buf_len);
 int msgblock_decode(uint32_t *data, int data_len, uint8_t *msg, int msg_len);
+int msgblock_parse_int(uint8_t **pp, uint8_t *end, int64_t *pv);
 struct queue_message *message_alloc(void);
 struct queue_message *message_fill(uint8_t *data, int len);
 struct queue_message *message_alloc_and_encode(uint32_t *data, int len);
+struct mempool;
+struct queue_message *message_pool_alloc_and_encode(
+    struct mempool *mp, uint32_t *data, int len);
 void message_free(struct queue_message *qm);
 void message_queue_free(struct list_head *root);
 uint64_t clock_from_clock32(struct clock_estimate *ce, uint32_t clock32);
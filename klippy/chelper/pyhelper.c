@@ -27,6 +27,19 @@ get_monotonic(void)
     return (double)ts.tv_sec + (double)ts.tv_nsec * .000000001;
 }
 
+// Return the cpu time used by the calling thread as a double
+double
+get_thread_cpu_time(void)
+{
+    struct timespec ts;
+    int ret = clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    if (ret) {
+        report_errno("clock_gettime", ret);
+        return 0.;
+    }
+    return (double)ts.tv_sec + (double)ts.tv_nsec * .000000001;
+}
+
 // Fill a 'struct timespec' with a system time stored in a double
 struct timespec
 fill_time(double time)
@@ -44,6 +44,7 @@ struct receiver {
     int waiting;
     struct list_head queue;
     struct list_head old_receive;
+    struct msgparser *mp;
 };
 
 struct transmit_requests {
@@ -78,6 +79,9 @@ struct serialqueue {
     uint64_t ignore_nak_seq, last_ack_seq, retransmit_seq, rtt_sample_seq;
     struct list_head sent_queue;
     double srtt, rttvar, rto;
+    // Adaptive transmit support
+    int adaptive, pending_window, window_acks, window_limited;
+    double reqtime_delta;
     // Pending transmission message queues
     struct list_head ready_queues;
     int ready_bytes, need_ack_bytes, last_ack_bytes;
@@ -90,6 +94,7 @@ struct serialqueue {
     struct list_head old_sent;
     // Stats
     uint32_t bytes_write, bytes_read, bytes_retransmit, bytes_invalid;
+    uint32_t blocks_write;
 };
 
 #define SQPF_SERIAL 0
@@ -106,8 +111,11 @@ struct serialqueue {
 
 #define MIN_RTO 0.025
 #define MAX_RTO 5.000
-#define MAX_PENDING_BLOCKS 12
+#define DEFAULT_PENDING_BLOCKS 12
+#define MIN_PENDING_BLOCKS 4
+#define MAX_PENDING_BLOCKS 32
 #define MIN_REQTIME_DELTA 0.100
+#define MIN_ADAPTIVE_REQTIME_DELTA (2. * MIN_RTO)
 #define MIN_BACKGROUND_DELTA 0.005
 #define IDLE_QUERY_TIME 1.0
 
@@ -185,12 +193,58 @@ calculate_bittime(struct serialqueue *sq, uint32_t bytes)
     }
 }
 
+// Adaptive transmit mode tunes the number of unacknowledged message
+// blocks (the "pending window") and the minimum time before a
+// message's req_clock that it is transmitted (the "reqtime delta").
+// The pending window is grown by one block for each window's worth of
+// acknowledged blocks (if the window limited transmission), is halved
+// on each retransmit, and is not grown past twice the number of
+// blocks that can be transmitted during one round-trip time.  The
+// reqtime delta is reduced to twice the retransmit timeout so that
+// messages may be accumulated into fuller blocks on fast links.
+
+// Update the adaptive transmit window after blocks are acknowledged
+//
+// A message is held (so that later messages may join its block) until
+// its req_clock is within reqtime_delta.  That lead time must cover a
+// round trip plus a retransmit of a lost block, which is what twice
+// the retransmit timeout provides.  It is never raised above the
+// fixed (non-adaptive) delta.  The lower limit is twice MIN_RTO
+// (50ms) - a retransmit can not be detected sooner than MIN_RTO, and
+// the remaining 25ms covers the host's thread wakeup latency and the
+// transmit time of a full window of blocks on a fast link.
+static void
+update_adaptive_window(struct serialqueue *sq, int acked_blocks)
+{
+    double reqtime_delta = 2. * sq->rto;
+    if (reqtime_delta < MIN_ADAPTIVE_REQTIME_DELTA)
+        reqtime_delta = MIN_ADAPTIVE_REQTIME_DELTA;
+    else if (reqtime_delta > MIN_REQTIME_DELTA)
+        reqtime_delta = MIN_REQTIME_DELTA;
+    sq->reqtime_delta = reqtime_delta;
+
+    sq->window_acks += acked_blocks;
+    if (sq->window_acks < sq->pending_window)
+        return;
+    sq->window_acks = 0;
+    if (!sq->window_limited || sq->pending_window >= MAX_PENDING_BLOCKS)
+        return;
+    sq->window_limited = 0;
+    double block_time = calculate_bittime(sq, MESSAGE_MAX);
+    if (block_time > 0. && sq->srtt
+        && sq->pending_window > 2. * sq->srtt / block_time + MIN_PENDING_BLOCKS)
+        // Window already exceeds the link's bandwidth-delay product
+        return;
+    sq->pending_window++;
+}
+
 // Update internal state when the receive sequence increases
 static void
 update_receive_seq(struct serialqueue *sq, double eventtime, uint64_t rseq)
 {
     // Remove from sent queue
     uint64_t sent_seq = sq->receive_seq;
+    int acked_blocks = 0;
     for (;;) {
         struct queue_message *sent = list_first_entry(
             &sq->sent_queue, struct queue_message, node);
@@ -204,6 +258,7 @@ update_receive_seq(struct serialqueue *sq, double eventtime, uint64_t rseq)
         list_del(&sent->node);
         debug_queue_add(&sq->old_sent, sent);
         sent_seq++;
+        acked_blocks++;
         if (rseq == sent_seq) {
             // Found sent message corresponding with the received sequence
             sq->last_receive_sent_time = sent->receive_time;
@@ -236,6 +291,8 @@ update_receive_seq(struct serialqueue *sq, double eventtime, uint64_t rseq)
             sq->rto = MAX_RTO;
         sq->rtt_sample_seq = 0;
     }
+    if (sq->adaptive)
+        update_adaptive_window(sq, acked_blocks);
     if (list_empty(&sq->sent_queue)) {
         pollreactor_update_timer(sq->pr, SQPT_RETRANSMIT, PR_NEVER);
     } else {
@@ -246,6 +303,20 @@ update_receive_seq(struct serialqueue *sq, double eventtime, uint64_t rseq)
     }
 }
 
+// Find the fast reader (if any) registered for the current input message
+static struct fastreader *
+find_fastreader(struct serialqueue *sq, int len)
+{
+    struct fastreader *fr;
+    list_for_each_entry(fr, &sq->fast_readers, node) {
+        if (len >= fr->prefix_len + MESSAGE_MIN
+            && memcmp(&sq->input_buf[MESSAGE_HEADER_SIZE]
+                      , fr->prefix, fr->prefix_len) == 0)
+            return fr;
+    }
+    return NULL;
+}
+
 // Process a well formed input message
 static void
 handle_message(struct serialqueue *sq, double eventtime, int len)
@@ -286,6 +357,7 @@ handle_message(struct serialqueue *sq, double eventtime, int len)
     }
 
     // Process message
+    struct fastreader *fr = NULL;
     if (len == MESSAGE_MIN) {
         // Ack/nak message
         if (sq->last_ack_seq < rseq)
@@ -295,25 +367,22 @@ handle_message(struct serialqueue *sq, double eventtime, int len)
             pollreactor_update_timer(sq->pr, SQPT_RETRANSMIT, PR_NOW);
     } else {
         // Data message - add to receive queue
-        struct queue_message *qm = message_fill(sq->input_buf, len);
-        qm->sent_time = (rseq > sq->retransmit_seq
-                         ? sq->last_receive_sent_time : 0.);
-        qm->receive_time = get_monotonic(); // must be time post read()
-        qm->receive_time -= calculate_bittime(sq, len);
-        list_add_tail(&qm->node, &received);
+        fr = find_fastreader(sq, len);
+        if (!fr || !fr->is_exclusive) {
+            struct queue_message *qm = message_fill(sq->input_buf, len);
+            qm->sent_time = (rseq > sq->retransmit_seq
+                             ? sq->last_receive_sent_time : 0.);
+            qm->receive_time = get_monotonic(); // must be time post read()
+            qm->receive_time -= calculate_bittime(sq, len);
+            list_add_tail(&qm->node, &received);
+        }
     }
 
     if (!list_empty(&received))
         receive_append_wake(&sq->receiver, &received);
 
-    // Check fast readers
-    struct fastreader *fr;
-    list_for_each_entry(fr, &sq->fast_readers, node) {
-        if (len < fr->prefix_len + MESSAGE_MIN
-            || memcmp(&sq->input_buf[MESSAGE_HEADER_SIZE]
-                      , fr->prefix, fr->prefix_len) != 0)
-            continue;
-        // Release main lock and invoke callback
+    if (fr) {
+        // Release main lock and invoke fast reader callback
         pthread_mutex_lock(&sq->fast_reader_dispatch_lock);
         pthread_mutex_unlock(&sq->lock);
         fr->func(fr, sq->input_buf, len);
@@ -461,6 +530,12 @@ retransmit_event(struct serialqueue *sq, double eventtime)
     }
     sq->retransmit_seq = sq->send_seq;
     sq->rtt_sample_seq = 0;
+    if (sq->adaptive) {
+        sq->pending_window /= 2;
+        if (sq->pending_window < MIN_PENDING_BLOCKS)
+            sq->pending_window = MIN_PENDING_BLOCKS;
+        sq->window_acks = 0;
+    }
     sq->idle_time = eventtime + calculate_bittime(sq, buflen);
     double waketime = eventtime + sq->rto + calculate_bittime(sq, first_buflen);
 
@@ -529,6 +604,7 @@ build_and_send_command(struct serialqueue *sq, uint8_t *buf, int pending
         sq->rtt_sample_seq = sq->send_seq;
     sq->send_seq++;
     sq->need_ack_bytes += len;
+    sq->blocks_write++;
     list_add_tail(&out->node, &sq->sent_queue);
     return len;
 }
@@ -600,10 +676,12 @@ check_send_command(struct serialqueue *sq, int pending, double eventtime)
     uint64_t min_stalled_clock = check_upcoming_queues(sq, ack_clock);
 
     // Check if valid to send messages
-    if (sq->send_seq - sq->receive_seq >= MAX_PENDING_BLOCKS
-        && sq->receive_seq != (uint64_t)-1)
+    if (sq->send_seq - sq->receive_seq >= sq->pending_window
+        && sq->receive_seq != (uint64_t)-1) {
         // Need an ack before more messages can be sent
+        sq->window_limited = 1;
         return eventtime + 0.250;
+    }
     if (sq->send_seq > sq->receive_seq && sq->receive_window) {
         int need_ack_bytes = sq->need_ack_bytes + MESSAGE_MAX;
         if (sq->last_ack_seq < sq->receive_seq)
@@ -635,13 +713,13 @@ check_send_command(struct serialqueue *sq, int pending, double eventtime)
             &cq->ready.msg_queue, struct queue_message, node);
         uint64_t req_clock = qm->req_clock;
         double bgtime = pending ? idletime : sq->idle_time;
-        double bgoffset = MIN_REQTIME_DELTA + MIN_BACKGROUND_DELTA;
+        double bgoffset = sq->reqtime_delta + MIN_BACKGROUND_DELTA;
         if (req_clock == BACKGROUND_PRIORITY_CLOCK)
             req_clock = clock_from_time(&sq->ce, bgtime + bgoffset);
         if (req_clock < min_ready_clock)
             min_ready_clock = req_clock;
     }
-    uint64_t reqclock_delta = MIN_REQTIME_DELTA * sq->ce.est_freq;
+    uint64_t reqclock_delta = sq->reqtime_delta * sq->ce.est_freq;
     if (min_ready_clock <= ack_clock + reqclock_delta)
         return PR_NOW;
 
@@ -742,6 +820,8 @@ serialqueue_alloc(int serial_fd, char serial_fd_type, int client_id
         sq->receive_seq = 1;
         sq->rto = MIN_RTO;
     }
+    sq->pending_window = DEFAULT_PENDING_BLOCKS;
+    sq->reqtime_delta = MIN_REQTIME_DELTA;
 
     // Queues
     sq->transmit_requests.need_kick_clock = MAX_CLOCK;
@@ -944,43 +1024,71 @@ serialqueue_send(struct serialqueue *sq, struct command_queue *cq, uint8_t *msg
     serialqueue_send_one(sq, cq, qm);
 }
 
-// Return a message read from the serial port (or wait for one if none
-// available)
-void __visible
-serialqueue_pull(struct serialqueue *sq, struct pull_queue_message *pqm)
+// Return up to 'max' messages read from the serial port (or wait for
+// one if none available).  Returns the number of messages stored in
+// 'pqms', or -1 if the serialqueue is exiting.
+int __visible
+serialqueue_pull_batch(struct serialqueue *sq, struct pull_queue_message *pqms
+                       , int max)
 {
     struct receiver *receiver = &sq->receiver;
     pthread_mutex_lock(&receiver->lock);
     // Wait for message to be available
     while (list_empty(&receiver->queue)) {
-        if (pollreactor_is_exit(sq->pr))
-            goto exit;
+        if (pollreactor_is_exit(sq->pr)) {
+            pthread_mutex_unlock(&receiver->lock);
+            return -1;
+        }
         receiver->waiting = 1;
         int ret = pthread_cond_wait(&receiver->cond, &receiver->lock);
         if (ret)
             report_errno("pthread_cond_wait", ret);
     }
 
-    // Remove message from queue
-    struct queue_message *qm = list_first_entry(
-        &receiver->queue, struct queue_message, node);
-    list_del(&qm->node);
-
-    // Copy message
-    memcpy(pqm->msg, qm->msg, qm->len);
-    pqm->len = qm->len;
-    pqm->sent_time = qm->sent_time;
-    pqm->receive_time = qm->receive_time;
-    pqm->notify_id = qm->notify_id;
-    if (qm->len)
-        qm = _debug_queue_add(&receiver->old_receive, qm);
-    pthread_mutex_unlock(&receiver->lock);
-    message_free(qm);
-    return;
+    // Remove and copy messages from queue
+    struct list_head done;
+    list_init(&done);
+    int count = 0;
+    while (count < max && !list_empty(&receiver->queue)) {
+        struct queue_message *qm = list_first_entry(
+            &receiver->queue, struct queue_message, node);
+        list_del(&qm->node);
 
-exit:
-    pqm->len = -1;
+        struct pull_queue_message *pqm = &pqms[count++];
+        memcpy(pqm->msg, qm->msg, qm->len);
+        pqm->len = qm->len;
+        pqm->sent_time = qm->sent_time;
+        pqm->receive_time = qm->receive_time;
+        pqm->notify_id = qm->notify_id;
+        pqm->rec.param_count = -1;
+        if (qm->len && receiver->mp)
+            msgparser_parse(receiver->mp, pqm->msg, pqm->len, &pqm->rec);
+        if (qm->len)
+            qm = _debug_queue_add(&receiver->old_receive, qm);
+        list_add_tail(&qm->node, &done);
+    }
     pthread_mutex_unlock(&receiver->lock);
+    message_queue_free(&done);
+    return count;
+}
+
+// Return a message read from the serial port (or wait for one if none
+// available)
+void __visible
+serialqueue_pull(struct serialqueue *sq, struct pull_queue_message *pqm)
+{
+    int ret = serialqueue_pull_batch(sq, pqm, 1);
+    if (ret < 0)
+        pqm->len = -1;
+}
+
+// Set the parser used to decode messages returned by serialqueue_pull()
+void __visible
+serialqueue_set_msgparser(struct serialqueue *sq, struct msgparser *mp)
+{
+    pthread_mutex_lock(&sq->receiver.lock);
+    sq->receiver.mp = mp;
+    pthread_mutex_unlock(&sq->receiver.lock);
 }
 
 void __visible
@@ -1004,6 +1112,18 @@ serialqueue_set_receive_window(struct serialqueue *sq, int receive_window)
     pthread_mutex_unlock(&sq->lock);
 }
 
+// Enable or disable adaptive transmit window and block fill tuning
+void __visible
+serialqueue_set_adaptive(struct serialqueue *sq, int adaptive)
+{
+    pthread_mutex_lock(&sq->lock);
+    sq->adaptive = adaptive;
+    sq->pending_window = DEFAULT_PENDING_BLOCKS;
+    sq->reqtime_delta = MIN_REQTIME_DELTA;
+    sq->window_acks = sq->window_limited = 0;
+    pthread_mutex_unlock(&sq->lock);
+}
+
 // Set the estimated clock rate of the mcu on the other end of the
 // serial port
 void __visible
@@ -1041,12 +1161,15 @@ serialqueue_get_stats(struct serialqueue *sq, char *buf, int len)
              " send_seq=%u receive_seq=%u retransmit_seq=%u"
              " srtt=%.3f rttvar=%.3f rto=%.3f"
              " ready_bytes=%u upcoming_bytes=%u"
+             " blocks_write=%u pending_window=%d reqtime_delta=%.3f"
              , stats.bytes_write, stats.bytes_read
              , stats.bytes_retransmit, stats.bytes_invalid
              , (int)stats.send_seq, (int)stats.receive_seq
              , (int)stats.retransmit_seq
              , stats.srtt, stats.rttvar, stats.rto
-             , stats.ready_bytes, stats.transmit_requests.upcoming_bytes);
+             , stats.ready_bytes, stats.transmit_requests.upcoming_bytes
+             , stats.blocks_write, stats.pending_window
+             , stats.reqtime_delta);
 }
 
 // Extract old messages stored in the debug queues
@@ -1087,6 +1210,7 @@ serialqueue_extract_old(struct serialqueue *sq, int sentq
             pqm->len = qm->len;
             pqm->sent_time = qm->sent_time;
             pqm->receive_time = qm->receive_time;
+            pqm->rec.param_count = -1;
         }
         list_del(&qm->node);
         message_free(qm);
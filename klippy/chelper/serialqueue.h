@@ -14,6 +14,9 @@ typedef void (*fastreader_cb)(struct fastreader *fr, uint8_t *data, int len);
 struct fastreader {
     struct list_node node;
     fastreader_cb func;
+    // Matching messages are not added to the receive queue if set
+    // (and so are also not in the debug history of received messages)
+    int is_exclusive;
     int prefix_len;
     uint8_t prefix[MESSAGE_MAX];
 };
@@ -23,6 +26,8 @@ struct pull_queue_message {
     int len;
     double sent_time, receive_time;
     uint64_t notify_id;
+    // Parsed message contents (param_count is -1 if not parsed)
+    struct msgparser_record rec;
 };
 
 struct serialqueue;
@@ -41,9 +46,13 @@ void serialqueue_send_one(struct serialqueue *sq, struct command_queue *cq
 void serialqueue_send(struct serialqueue *sq, struct command_queue *cq
                       , uint8_t *msg, int len, uint64_t min_clock
                       , uint64_t req_clock, uint64_t notify_id);
+int serialqueue_pull_batch(struct serialqueue *sq
+                           , struct pull_queue_message *pqms, int max);
 void serialqueue_pull(struct serialqueue *sq, struct pull_queue_message *pqm);
+void serialqueue_set_msgparser(struct serialqueue *sq, struct msgparser *mp);
 void serialqueue_set_wire_frequency(struct serialqueue *sq, double frequency);
 void serialqueue_set_receive_window(struct serialqueue *sq, int receive_window);
+void serialqueue_set_adaptive(struct serialqueue *sq, int adaptive);
 void serialqueue_set_clock_est(struct serialqueue *sq, double est_freq
                                , double conv_time, uint64_t conv_clock
                                , uint64_t last_clock);
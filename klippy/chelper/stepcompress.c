@@ -28,6 +28,12 @@
 #define CHECK_LINES 1
 #define QUEUE_START_SIZE 1024
 
+struct step_move {
+    uint32_t interval;
+    uint16_t count;
+    int16_t add;
+};
+
 struct stepcompress {
     // Buffer management
     uint32_t *queue, *queue_end, *queue_pos, *queue_next;
@@ -40,23 +46,24 @@ struct stepcompress {
     uint32_t oid;
     int32_t queue_step_msgtag, set_next_step_dir_msgtag;
     int sdir, invert_sdir;
+    // Incremental compression (seed search from last_move)
+    int incremental;
+    struct step_move last_move;
     // Step+dir+step filter
     uint64_t next_step_clock;
     int next_step_dir;
     // History tracking
     int64_t last_position;
-    struct list_head history_list;
-};
-
-struct step_move {
-    uint32_t interval;
-    uint16_t count;
-    int16_t add;
+    struct history_steps *history;
+    uint32_t history_size, history_start, history_count;
+    // Storage pool for queued messages
+    struct mempool *msg_pool;
 };
 
 struct history_steps {
-    struct list_node node;
     uint64_t first_clock, last_clock;
+    // Minimum first_clock of this and all newer history entries
+    uint64_t search_clock;
     int64_t start_position;
     int step_count, interval, add;
 };
@@ -101,18 +108,20 @@ minmax_point(struct stepcompress *sc, uint32_t *pos)
 // using 11 works well in practice.
 #define QUADRATIC_DEV 11
 
-// Find a 'step_move' that covers a series of step times
+// Find a 'step_move' that covers a series of step times.  The search
+// always tries add=0 first (so that it can be preferred below) and
+// then tries 'seed_add' if it is still in the valid add range.
 static struct step_move
-compress_bisect_add(struct stepcompress *sc)
+compress_bisect_add(struct stepcompress *sc, int32_t seed_add)
 {
     uint32_t *qlast = sc->queue_next;
     if (qlast > sc->queue_pos + 65535)
         qlast = sc->queue_pos + 65535;
     struct points point = minmax_point(sc, sc->queue_pos);
     int32_t outer_mininterval = point.minp, outer_maxinterval = point.maxp;
-    int32_t add = 0, minadd = -0x8000, maxadd = 0x7fff;
+    int32_t minadd = -0x8000, maxadd = 0x7fff;
     int32_t bestinterval = 0, bestcount = 1, bestadd = 1, bestreach = INT32_MIN;
-    int32_t zerointerval = 0, zerocount = 0;
+    int32_t zerointerval = 0, zerocount = 0, add = 0;
 
     for (;;) {
         // Find longest valid sequence with the given 'add'
@@ -188,7 +197,11 @@ compress_bisect_add(struct stepcompress *sc)
         // Bisect valid add range and try again with new 'add'
         if (minadd > maxadd)
             break;
-        add = maxadd - (maxadd - minadd) / 4;
+        if (seed_add >= minadd && seed_add <= maxadd && seed_add != add)
+            add = seed_add;
+        else
+            add = maxadd - (maxadd - minadd) / 4;
+        seed_add = 0;
     }
     if (zerocount + zerocount/16 >= bestcount)
         // Prefer add=0 if it's similar to the best found sequence
@@ -196,11 +209,98 @@ compress_bisect_add(struct stepcompress *sc)
     return (struct step_move){ bestinterval, bestcount, bestadd };
 }
 
+// Determine the 'add' to seed compress_bisect_add() with.  Moves are
+// typically smooth acceleration or cruise segments, so in incremental
+// mode the search tries the 'add' of the last queued step_move (after
+// add=0) if that sequence would also cover the next step.  Otherwise
+// the search is a full bisection.
+static int32_t
+compress_seed_add(struct stepcompress *sc)
+{
+    struct step_move *lm = &sc->last_move;
+    if (!sc->incremental || !lm->count || !lm->add)
+        return 0;
+    struct points point = minmax_point(sc, sc->queue_pos);
+    int64_t interval = lm->interval + (int64_t)lm->count * lm->add;
+    if (interval < point.minp || interval > point.maxp)
+        return 0;
+    return lm->add;
+}
+
 
 /****************************************************************
  * Step compress checking
  ****************************************************************/
 
+// Select the number of points to check in parallel (if any).  The
+// instruction set is chosen by the compiler flags used when building
+// c_helper.so (see chelper/__init__.py).
+#if defined(__AVX2__)
+#define CHECK_VEC_WIDTH 8
+#elif defined(__SSE2__) || defined(__ARM_NEON)
+#define CHECK_VEC_WIDTH 4
+#endif
+
+#ifdef CHECK_VEC_WIDTH
+
+typedef uint32_t vec_u32 __attribute__((vector_size(CHECK_VEC_WIDTH * 4)));
+typedef int32_t vec_s32 __attribute__((vector_size(CHECK_VEC_WIDTH * 4)));
+
+// Check CHECK_VEC_WIDTH points of a 'step_move' at a time against the
+// minmax_point() bounds.  Returns the number of leading points that
+// were verified (with 'p' and 'interval' updated to match), or zero
+// if any point was found to be invalid.
+static int
+check_line_vec(struct stepcompress *sc, struct step_move *move
+               , uint32_t *pp, uint32_t *pinterval)
+{
+    int count = move->count, i, j;
+    if (count < CHECK_VEC_WIDTH)
+        return 0;
+    uint32_t lsc = sc->last_step_clock, *pos = sc->queue_pos, add = move->add;
+    // Setup lanes with the position and interval of the first points
+    uint32_t lp[CHECK_VEC_WIDTH], li[CHECK_VEC_WIDTH], lprev[CHECK_VEC_WIDTH];
+    uint32_t p = 0, interval = move->interval;
+    for (j=0; j<CHECK_VEC_WIDTH; j++) {
+        p += interval;
+        lp[j] = p;
+        li[j] = interval;
+        lprev[j] = j ? pos[j-1] : lsc;
+        interval += add;
+    }
+    vec_u32 vp, vi, vprev, vpos;
+    memcpy(&vp, lp, sizeof(vp));
+    memcpy(&vi, li, sizeof(vi));
+    memcpy(&vprev, lprev, sizeof(vprev));
+    uint32_t max_error = sc->max_error, add_i = add * CHECK_VEC_WIDTH;
+    uint32_t add_p = add * (CHECK_VEC_WIDTH * (CHECK_VEC_WIDTH + 1) / 2);
+    vec_s32 bad = { 0 };
+    for (i=0; i + CHECK_VEC_WIDTH <= count; i += CHECK_VEC_WIDTH) {
+        if (i)
+            memcpy(&vprev, &pos[i-1], sizeof(vprev));
+        memcpy(&vpos, &pos[i], sizeof(vpos));
+        // Calculate minimum and maximum acceptable times (as minmax_point)
+        vec_u32 point = vpos - lsc, prevpoint = vprev - lsc;
+        vec_u32 vmax_error = (point - prevpoint) / 2;
+        vec_u32 use_max = (vec_u32)((vec_s32)vmax_error > (int32_t)max_error);
+        vmax_error = (vmax_error & ~use_max) | (max_error & use_max);
+        vec_u32 minp = point - vmax_error;
+        // Check points (and that no interval overflowed)
+        bad |= (vp < minp) | (vp > point) | ((vec_s32)vi < 0);
+        // Advance lanes to the next set of points
+        vp += vi * CHECK_VEC_WIDTH + add_p;
+        vi += add_i;
+    }
+    for (j=0; j<CHECK_VEC_WIDTH; j++)
+        if (bad[j])
+            return 0;
+    *pp = vp[0] - vi[0];
+    *pinterval = vi[0];
+    return i;
+}
+
+#endif
+
 // Verify that a given 'step_move' matches the actual step times
 static int
 check_line(struct stepcompress *sc, struct step_move move)
@@ -214,8 +314,11 @@ check_line(struct stepcompress *sc, struct step_move move)
         return ERROR_RET;
     }
     uint32_t interval = move.interval, p = 0;
-    uint16_t i;
-    for (i=0; i<move.count; i++) {
+    uint16_t i = 0;
+#ifdef CHECK_VEC_WIDTH
+    i = check_line_vec(sc, &move, &p, &interval);
+#endif
+    for (; i<move.count; i++) {
         struct points point = minmax_point(sc, sc->queue_pos + i);
         p += interval;
         if (p < point.minp || p > point.maxp) {
@@ -237,19 +340,88 @@ check_line(struct stepcompress *sc, struct step_move move)
 }
 
 
+/****************************************************************
+ * History tracking
+ ****************************************************************/
+
+// The history is stored in a ring buffer ordered from oldest entry to
+// newest entry.  The entries are normally in clock order, however a
+// position reset (eg, after homing) may add an entry with a clock
+// prior to the last queued steps.  Each entry therefore also tracks
+// the minimum first_clock of itself and all newer entries
+// (search_clock) which is always in ascending order and can be
+// binary searched.
+
+// Return the history entry at the given index (0 is oldest)
+static inline struct history_steps *
+history_entry(struct stepcompress *sc, uint32_t idx)
+{
+    return &sc->history[(sc->history_start + idx) & (sc->history_size - 1)];
+}
+
+// Allocate a new history entry (caller must fill and call history_add)
+static struct history_steps *
+history_alloc_entry(struct stepcompress *sc)
+{
+    if (sc->history_count >= sc->history_size) {
+        // Grow the ring buffer (and store entries in order from index 0)
+        uint32_t new_size = sc->history_size ? sc->history_size * 2 : 256;
+        struct history_steps *h = malloc(sizeof(*h) * new_size);
+        uint32_t i;
+        for (i=0; i<sc->history_count; i++)
+            h[i] = *history_entry(sc, i);
+        free(sc->history);
+        sc->history = h;
+        sc->history_size = new_size;
+        sc->history_start = 0;
+    }
+    return history_entry(sc, sc->history_count);
+}
+
+// Add a filled entry (from history_alloc_entry) to the history
+static void
+history_add(struct stepcompress *sc, struct history_steps *hs)
+{
+    uint64_t first_clock = hs->first_clock;
+    hs->search_clock = first_clock;
+    uint32_t idx = sc->history_count++;
+    while (idx--) {
+        struct history_steps *prev = history_entry(sc, idx);
+        if (prev->search_clock <= first_clock)
+            break;
+        prev->search_clock = first_clock;
+    }
+}
+
+// Return the number of history entries with a search_clock <= clock
+static uint32_t
+history_search(struct stepcompress *sc, uint64_t clock)
+{
+    uint32_t low = 0, high = sc->history_count;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (history_entry(sc, mid)->search_clock <= clock)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low;
+}
+
+
 /****************************************************************
  * Step compress interface
  ****************************************************************/
 
 // Allocate a new 'stepcompress' object
 struct stepcompress *
-stepcompress_alloc(struct list_head *msg_queue)
+stepcompress_alloc(struct list_head *msg_queue, struct mempool *msg_pool)
 {
     struct stepcompress *sc = malloc(sizeof(*sc));
     memset(sc, 0, sizeof(*sc));
-    list_init(&sc->history_list);
     sc->sdir = -1;
     sc->msg_queue = msg_queue;
+    sc->msg_pool = msg_pool;
     return sc;
 }
 
@@ -264,6 +436,14 @@ stepcompress_fill(struct stepcompress *sc, uint32_t oid, uint32_t max_error
     sc->set_next_step_dir_msgtag = set_next_step_dir_msgtag;
 }
 
+// Enable (or disable) incremental step compression
+void __visible
+stepcompress_set_incremental(struct stepcompress *sc, uint32_t incremental)
+{
+    sc->incremental = !!incremental;
+    sc->last_move.count = 0;
+}
+
 // Set the inverted stepper direction flag
 void __visible
 stepcompress_set_invert_sdir(struct stepcompress *sc, uint32_t invert_sdir)
@@ -280,16 +460,24 @@ stepcompress_set_invert_sdir(struct stepcompress *sc, uint32_t invert_sdir)
 void
 stepcompress_history_expire(struct stepcompress *sc, uint64_t end_clock)
 {
-    while (!list_empty(&sc->history_list)) {
-        struct history_steps *hs = list_last_entry(
-            &sc->history_list, struct history_steps, node);
+    while (sc->history_count) {
+        struct history_steps *hs = history_entry(sc, 0);
         if (hs->last_clock > end_clock)
             break;
-        list_del(&hs->node);
-        free(hs);
+        sc->history_start = (sc->history_start + 1) & (sc->history_size - 1);
+        sc->history_count--;
     }
 }
 
+// Report the number of history entries and the allocated buffer size
+void
+stepcompress_get_history_stats(struct stepcompress *sc, uint32_t *count
+                               , uint32_t *size)
+{
+    *count = sc->history_count;
+    *size = sc->history_size;
+}
+
 // Free memory associated with a 'stepcompress' object
 void
 stepcompress_free(struct stepcompress *sc)
@@ -297,7 +485,7 @@ stepcompress_free(struct stepcompress *sc)
     if (!sc)
         return;
     free(sc->queue);
-    stepcompress_history_expire(sc, UINT64_MAX);
+    free(sc->history);
     free(sc);
 }
 
@@ -346,7 +534,8 @@ add_move(struct stepcompress *sc, uint64_t first_clock, struct step_move *move)
     uint32_t msg[5] = {
         sc->queue_step_msgtag, sc->oid, move->interval, move->count, move->add
     };
-    struct queue_message *qm = message_alloc_and_encode(msg, 5);
+    struct queue_message *qm = message_pool_alloc_and_encode(sc->msg_pool
+                                                             , msg, 5);
     qm->min_clock = qm->req_clock = sc->last_step_clock;
     if (move->count == 1 && first_clock >= sc->last_step_clock + CLOCK_DIFF_MAX)
         qm->req_clock = first_clock;
@@ -354,7 +543,7 @@ add_move(struct stepcompress *sc, uint64_t first_clock, struct step_move *move)
     sc->last_step_clock = last_clock;
 
     // Create and store move in history tracking
-    struct history_steps *hs = malloc(sizeof(*hs));
+    struct history_steps *hs = history_alloc_entry(sc);
     hs->first_clock = first_clock;
     hs->last_clock = last_clock;
     hs->start_position = sc->last_position;
@@ -362,7 +551,7 @@ add_move(struct stepcompress *sc, uint64_t first_clock, struct step_move *move)
     hs->add = move->add;
     hs->step_count = sc->sdir ? move->count : -move->count;
     sc->last_position += hs->step_count;
-    list_add_head(&hs->node, &sc->history_list);
+    history_add(sc, hs);
 }
 
 // Convert previously scheduled steps into commands for the mcu
@@ -372,12 +561,13 @@ queue_flush(struct stepcompress *sc, uint64_t move_clock)
     if (sc->queue_pos >= sc->queue_next)
         return 0;
     while (sc->last_step_clock < move_clock) {
-        struct step_move move = compress_bisect_add(sc);
+        struct step_move move = compress_bisect_add(sc, compress_seed_add(sc));
         int ret = check_line(sc, move);
         if (ret)
             return ret;
 
         add_move(sc, sc->last_step_clock + move.interval, &move);
+        sc->last_move = move;
 
         if (sc->queue_pos + move.count >= sc->queue_next) {
             sc->queue_pos = sc->queue_next = sc->queue;
@@ -395,6 +585,7 @@ stepcompress_flush_far(struct stepcompress *sc, uint64_t abs_step_clock)
 {
     struct step_move move = { abs_step_clock - sc->last_step_clock, 1, 0 };
     add_move(sc, abs_step_clock, &move);
+    sc->last_move.count = 0;
     calc_last_step_print_time(sc);
     return 0;
 }
@@ -409,30 +600,17 @@ set_next_step_dir(struct stepcompress *sc, int sdir)
     if (ret)
         return ret;
     sc->sdir = sdir;
+    sc->last_move.count = 0;
     uint32_t msg[3] = {
         sc->set_next_step_dir_msgtag, sc->oid, sdir ^ sc->invert_sdir
     };
-    struct queue_message *qm = message_alloc_and_encode(msg, 3);
+    struct queue_message *qm = message_pool_alloc_and_encode(sc->msg_pool
+                                                             , msg, 3);
     qm->req_clock = sc->last_step_clock;
     list_add_tail(&qm->node, sc->msg_queue);
     return 0;
 }
 
-// Slow path for queue_append() - handle next step far in future
-static int
-queue_append_far(struct stepcompress *sc)
-{
-    uint64_t step_clock = sc->next_step_clock;
-    sc->next_step_clock = 0;
-    int ret = queue_flush(sc, step_clock - CLOCK_DIFF_MAX + 1);
-    if (ret)
-        return ret;
-    if (step_clock >= sc->last_step_clock + CLOCK_DIFF_MAX)
-        return stepcompress_flush_far(sc, step_clock);
-    *sc->queue_next++ = step_clock;
-    return 0;
-}
-
 // Slow path for queue_append() - expand the internal queue storage
 static int
 queue_append_extend(struct stepcompress *sc)
@@ -471,6 +649,26 @@ queue_append_extend(struct stepcompress *sc)
     return 0;
 }
 
+// Slow path for queue_append() - handle next step far in future
+static int
+queue_append_far(struct stepcompress *sc)
+{
+    uint64_t step_clock = sc->next_step_clock;
+    sc->next_step_clock = 0;
+    int ret = queue_flush(sc, step_clock - CLOCK_DIFF_MAX + 1);
+    if (ret)
+        return ret;
+    if (step_clock >= sc->last_step_clock + CLOCK_DIFF_MAX)
+        return stepcompress_flush_far(sc, step_clock);
+    // The flush may not have emptied the queue - make sure there is room
+    sc->next_step_clock = step_clock;
+    if (unlikely(sc->queue_next >= sc->queue_end))
+        return queue_append_extend(sc);
+    *sc->queue_next++ = step_clock;
+    sc->next_step_clock = 0;
+    return 0;
+}
+
 // Add a step time to the queue (flushing the queue if needed)
 static int
 queue_append(struct stepcompress *sc)
@@ -551,6 +749,7 @@ stepcompress_reset(struct stepcompress *sc, uint64_t last_step_clock)
         return ret;
     sc->last_step_clock = last_step_clock;
     sc->sdir = -1;
+    sc->last_move.count = 0;
     calc_last_step_print_time(sc);
     return 0;
 }
@@ -566,11 +765,11 @@ stepcompress_set_last_position(struct stepcompress *sc, uint64_t clock
     sc->last_position = last_position;
 
     // Add a marker to the history list
-    struct history_steps *hs = malloc(sizeof(*hs));
+    struct history_steps *hs = history_alloc_entry(sc);
     memset(hs, 0, sizeof(*hs));
     hs->first_clock = hs->last_clock = clock;
     hs->start_position = last_position;
-    list_add_head(&hs->node, &sc->history_list);
+    history_add(sc, hs);
     return 0;
 }
 
@@ -578,29 +777,28 @@ stepcompress_set_last_position(struct stepcompress *sc, uint64_t clock
 int64_t __visible
 stepcompress_find_past_position(struct stepcompress *sc, uint64_t clock)
 {
-    int64_t last_position = sc->last_position;
-    struct history_steps *hs;
-    list_for_each_entry(hs, &sc->history_list, node) {
-        if (clock < hs->first_clock) {
-            last_position = hs->start_position;
-            continue;
-        }
-        if (clock >= hs->last_clock)
-            return hs->start_position + hs->step_count;
-        int32_t interval = hs->interval, add = hs->add;
-        int32_t ticks = (int32_t)(clock - hs->first_clock) + interval, offset;
-        if (!add) {
-            offset = ticks / interval;
-        } else {
-            // Solve for "count" using quadratic formula
-            double a = .5 * add, b = interval - .5 * add, c = -ticks;
-            offset = (sqrt(b*b - 4*a*c) - b) / (2. * a);
-        }
-        if (hs->step_count < 0)
-            return hs->start_position - offset;
-        return hs->start_position + offset;
+    // Find newest entry with a first_clock <= clock
+    uint32_t idx = history_search(sc, clock);
+    if (!idx) {
+        if (!sc->history_count)
+            return sc->last_position;
+        return history_entry(sc, 0)->start_position;
+    }
+    struct history_steps *hs = history_entry(sc, idx - 1);
+    if (clock >= hs->last_clock)
+        return hs->start_position + hs->step_count;
+    int32_t interval = hs->interval, add = hs->add;
+    int32_t ticks = (int32_t)(clock - hs->first_clock) + interval, offset;
+    if (!add) {
+        offset = ticks / interval;
+    } else {
+        // Solve for "count" using quadratic formula
+        double a = .5 * add, b = interval - .5 * add, c = -ticks;
+        offset = (sqrt(b*b - 4*a*c) - b) / (2. * a);
     }
-    return last_position;
+    if (hs->step_count < 0)
+        return hs->start_position - offset;
+    return hs->start_position + offset;
 }
 
 // Return history of queue_step commands
@@ -608,9 +806,13 @@ int __visible
 stepcompress_extract_old(struct stepcompress *sc, struct pull_history_steps *p
                          , int max, uint64_t start_clock, uint64_t end_clock)
 {
+    // Skip newer entries that all start at or after end_clock
+    uint32_t idx = sc->history_count;
+    if (start_clock < end_clock)
+        idx = history_search(sc, end_clock - 1);
     int res = 0;
-    struct history_steps *hs;
-    list_for_each_entry(hs, &sc->history_list, node) {
+    while (idx--) {
+        struct history_steps *hs = history_entry(sc, idx);
         if (start_clock >= hs->last_clock || res >= max)
             break;
         if (end_clock <= hs->first_clock)
@@ -12,14 +12,20 @@ struct pull_history_steps {
 };
 
 struct list_head;
-struct stepcompress *stepcompress_alloc(struct list_head *msg_queue);
+struct mempool;
+struct stepcompress *stepcompress_alloc(struct list_head *msg_queue
+                                        , struct mempool *msg_pool);
 void stepcompress_fill(struct stepcompress *sc, uint32_t oid, uint32_t max_error
                        , int32_t queue_step_msgtag
                        , int32_t set_next_step_dir_msgtag);
 void stepcompress_set_invert_sdir(struct stepcompress *sc
                                   , uint32_t invert_sdir);
+void stepcompress_set_incremental(struct stepcompress *sc
+                                  , uint32_t incremental);
 void stepcompress_history_expire(struct stepcompress *sc, uint64_t end_clock);
 void stepcompress_free(struct stepcompress *sc);
+void stepcompress_get_history_stats(struct stepcompress *sc, uint32_t *count
+                                    , uint32_t *size);
 uint32_t stepcompress_get_oid(struct stepcompress *sc);
 int stepcompress_get_step_dir(struct stepcompress *sc);
 void stepcompress_set_time(struct stepcompress *sc
@@ -11,19 +11,105 @@
 // mcu step queue is ordered between steppers so that no stepper
 // starves the other steppers of space in the mcu step queue.
 
+#include <linux/futex.h> // FUTEX_WAIT_PRIVATE
 #include <pthread.h> // pthread_mutex_lock
 #include <stddef.h> // offsetof
+#include <stdio.h> // snprintf
 #include <stdlib.h> // malloc
 #include <string.h> // memset
+#include <sys/syscall.h> // SYS_futex
+#include <unistd.h> // syscall
 #include "compiler.h" // __visible
 #include "pyhelper.h" // set_thread_name
 #include "itersolve.h" // itersolve_generate_steps
+#include "mempool.h" // mempool_alloc
 #include "serialqueue.h" // struct queue_message
 #include "stepcompress.h" // stepcompress_flush
 #include "steppersync.h" // steppersync_alloc
 #include "trapq.h" // trapq_check_sentinels
 
 
+/****************************************************************
+ * Lock-free request handoff
+ ****************************************************************/
+
+// Each syncemitter background thread receives requests from a single
+// producer (the thread flushing the motion queues) and returns results
+// to that producer.  Requests and results are signaled by incrementing
+// a sequence counter.  A waiter spins for a short time (most flushes
+// complete quickly) and then sleeps using a futex.  A futex wakeup is
+// only issued if the other side has indicated that it is sleeping.
+
+#define HANDOFF_SPIN_TIME 0.000100
+
+// Pause briefly in a spin loop
+static inline void
+cpu_relax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield" ::: "memory");
+#else
+    barrier();
+#endif
+}
+
+// Return the time to spin in handoff_wait() on this system
+static double
+handoff_spin_time(void)
+{
+    if (sysconf(_SC_NPROCESSORS_ONLN) <= 1)
+        // Spinning is not useful on a single cpu system
+        return 0.;
+    return HANDOFF_SPIN_TIME;
+}
+
+// Wait (up to 'spin_time' seconds) for a sequence to change
+static int
+handoff_spin(uint32_t *seq, uint32_t val, double spin_time)
+{
+    if (spin_time <= 0.)
+        return 0;
+    double end_time = get_monotonic() + spin_time;
+    for (;;) {
+        int i;
+        for (i=0; i<64; i++) {
+            if (__atomic_load_n(seq, __ATOMIC_ACQUIRE) != val)
+                return 1;
+            cpu_relax();
+        }
+        if (get_monotonic() > end_time)
+            return 0;
+    }
+}
+
+// Wait for a sequence to no longer contain the value 'val'
+static void
+handoff_wait(uint32_t *seq, uint32_t val, uint32_t *sleeping
+             , double spin_time)
+{
+    if (handoff_spin(seq, val, spin_time))
+        return;
+    for (;;) {
+        __atomic_store_n(sleeping, 1, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(seq, __ATOMIC_SEQ_CST) != val)
+            break;
+        syscall(SYS_futex, seq, FUTEX_WAIT_PRIVATE, val, NULL, NULL, 0);
+    }
+    __atomic_store_n(sleeping, 0, __ATOMIC_RELAXED);
+}
+
+// Update a sequence and wake the other side if it is sleeping
+static void
+handoff_post(uint32_t *seq, uint32_t val, uint32_t *sleeping)
+{
+    __atomic_store_n(seq, val, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(sleeping, __ATOMIC_SEQ_CST))
+        syscall(SYS_futex, seq, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+}
+
+
 /****************************************************************
  * SyncEmitter - message generation for each stepper
  ****************************************************************/
@@ -33,17 +119,24 @@ struct syncemitter {
     struct list_node ss_node;
     // Transmit message queue
     struct list_head msg_queue;
+    // Storage pool for queued messages
+    struct mempool *msg_pool;
     // Thread for step generation
     struct stepcompress *sc;
     struct stepper_kinematics *sk;
     char name[16];
+    int have_thread;
     pthread_t tid;
-    pthread_mutex_t lock; // protects variables below
-    pthread_cond_t cond;
-    int have_work;
+    // Request and result handoff with background thread
+    uint32_t req_seq, done_seq, req_sleeping, done_sleeping;
+    double spin_time;
+    int exit_request;
     double bg_gen_steps_time;
     uint64_t bg_flush_clock, bg_clear_history_clock;
     int32_t bg_result;
+    // Syncemitters sharing a trapq that are generated as a single task
+    struct syncemitter *batch[ITERSOLVE_MAX_BATCH];
+    int batch_count;
 };
 
 // Return this emitters 'struct stepcompress' (or NULL if not allocated)
@@ -73,31 +166,62 @@ void __visible
 syncemitter_queue_msg(struct syncemitter *se, uint64_t req_clock
                       , uint32_t *data, int len)
 {
-    struct queue_message *qm = message_alloc_and_encode(data, len);
+    struct queue_message *qm = message_pool_alloc_and_encode(se->msg_pool
+                                                             , data, len);
     qm->min_clock = qm->req_clock = req_clock;
     list_add_tail(&qm->node, &se->msg_queue);
 }
 
+// Flush generated steps and clear old history
+static int32_t
+se_flush_steps(struct syncemitter *se)
+{
+    // Flush steps
+    int32_t ret = stepcompress_flush(se->sc, se->bg_flush_clock);
+    if (ret)
+        return ret;
+    // Clear history
+    stepcompress_history_expire(se->sc, se->bg_clear_history_clock);
+    return 0;
+}
+
+// Generate steps for a batch of syncemitters sharing a trapq and flush
+static int32_t
+se_generate_batch_steps(struct syncemitter *se)
+{
+    struct stepper_kinematics *sks[ITERSOLVE_MAX_BATCH];
+    struct stepcompress *scs[ITERSOLVE_MAX_BATCH];
+    int i;
+    for (i=0; i<se->batch_count; i++) {
+        sks[i] = se->batch[i]->sk;
+        scs[i] = se->batch[i]->sc;
+    }
+    int32_t ret = itersolve_generate_steps_batch(sks, scs, se->batch_count
+                                                 , se->bg_gen_steps_time);
+    if (ret)
+        return ret;
+    for (i=0; i<se->batch_count; i++) {
+        ret = se_flush_steps(se->batch[i]);
+        if (ret)
+            return ret;
+    }
+    return 0;
+}
+
 // Generate steps (via itersolve) and flush
 static int32_t
 se_generate_steps(struct syncemitter *se)
 {
     if (!se->sc || !se->sk)
         return 0;
-    double gen_steps_time = se->bg_gen_steps_time;
-    uint64_t flush_clock = se->bg_flush_clock;
-    uint64_t clear_history_clock = se->bg_clear_history_clock;
+    if (se->batch_count)
+        return se_generate_batch_steps(se);
     // Generate steps
-    int32_t ret = itersolve_generate_steps(se->sk, se->sc, gen_steps_time);
-    if (ret)
-        return ret;
-    // Flush steps
-    ret = stepcompress_flush(se->sc, flush_clock);
+    int32_t ret = itersolve_generate_steps(se->sk, se->sc
+                                           , se->bg_gen_steps_time);
     if (ret)
         return ret;
-    // Clear history
-    stepcompress_history_expire(se->sc, clear_history_clock);
-    return 0;
+    return se_flush_steps(se);
 }
 
 // Main background thread for generating steps
@@ -107,28 +231,34 @@ se_background_thread(void *data)
     struct syncemitter *se = data;
     set_thread_name(se->name);
 
-    pthread_mutex_lock(&se->lock);
+    uint32_t seq = 0;
     for (;;) {
-        if (!se->have_work) {
-            pthread_cond_wait(&se->cond, &se->lock);
-            continue;
-        }
-        if (se->have_work < 0)
-            // Exit request
+        // Wait for next request
+        handoff_wait(&se->req_seq, seq, &se->req_sleeping, 0.);
+        seq++;
+        if (se->exit_request)
             break;
 
         // Request to generate steps
         se->bg_result = se_generate_steps(se);
         if (se->bg_result)
             errorf("Error in syncemitter '%s' step generation", se->name);
-        se->have_work = 0;
-        pthread_cond_signal(&se->cond);
+        handoff_post(&se->done_seq, seq, &se->done_sleeping);
     }
-    pthread_mutex_unlock(&se->lock);
 
     return NULL;
 }
 
+// Wait for background thread to complete any pending request
+static void
+se_wait_idle(struct syncemitter *se)
+{
+    uint32_t seq = se->req_seq;
+    if (__atomic_load_n(&se->done_seq, __ATOMIC_ACQUIRE) != seq)
+        handoff_wait(&se->done_seq, seq - 1, &se->done_sleeping
+                     , se->spin_time);
+}
+
 // Signal background thread to start step generation
 static void
 se_start_gen_steps(struct syncemitter *se, double gen_steps_time
@@ -136,15 +266,11 @@ se_start_gen_steps(struct syncemitter *se, double gen_steps_time
 {
     if (!se->sc || !se->sk)
         return;
-    pthread_mutex_lock(&se->lock);
-    while (se->have_work)
-        pthread_cond_wait(&se->cond, &se->lock);
+    se_wait_idle(se);
     se->bg_gen_steps_time = gen_steps_time;
     se->bg_flush_clock = flush_clock;
     se->bg_clear_history_clock = clear_history_clock;
-    se->have_work = 1;
-    pthread_mutex_unlock(&se->lock);
-    pthread_cond_signal(&se->cond);
+    handoff_post(&se->req_seq, se->req_seq + 1, &se->req_sleeping);
 }
 
 // Wait for background thread to complete last step generation request
@@ -153,39 +279,33 @@ se_finalize_gen_steps(struct syncemitter *se)
 {
     if (!se->sc || !se->sk)
         return 0;
-    pthread_mutex_lock(&se->lock);
-    while (se->have_work)
-        pthread_cond_wait(&se->cond, &se->lock);
-    int32_t res = se->bg_result;
-    pthread_mutex_unlock(&se->lock);
-    return res;
+    se_wait_idle(se);
+    return se->bg_result;
 }
 
-// Allocate syncemitter and start thread
+// Allocate syncemitter and start thread (if requested)
 static struct syncemitter *
-syncemitter_alloc(char name[16], int alloc_stepcompress)
+syncemitter_alloc(char name[16], int alloc_stepcompress, int use_thread)
 {
     struct syncemitter *se = malloc(sizeof(*se));
     memset(se, 0, sizeof(*se));
     list_init(&se->msg_queue);
     strncpy(se->name, name, sizeof(se->name));
     se->name[sizeof(se->name)-1] = '\0';
+    se->msg_pool = mempool_alloc(sizeof(struct queue_message));
     if (!alloc_stepcompress)
         return se;
-    se->sc = stepcompress_alloc(&se->msg_queue);
-    int ret = pthread_mutex_init(&se->lock, NULL);
-    if (ret)
-        goto fail;
-    ret = pthread_cond_init(&se->cond, NULL);
-    if (ret)
-        goto fail;
-    ret = pthread_create(&se->tid, NULL, se_background_thread, se);
-    if (ret)
-        goto fail;
+    se->sc = stepcompress_alloc(&se->msg_queue, se->msg_pool);
+    if (!use_thread)
+        return se;
+    se->have_thread = 1;
+    se->spin_time = handoff_spin_time();
+    int ret = pthread_create(&se->tid, NULL, se_background_thread, se);
+    if (ret) {
+        report_errno("se alloc", ret);
+        return NULL;
+    }
     return se;
-fail:
-    report_errno("se alloc", ret);
-    return NULL;
 }
 
 // Free syncemitter and exit background thread
@@ -194,19 +314,17 @@ syncemitter_free(struct syncemitter *se)
 {
     if (!se)
         return;
-    if (se->sc) {
-        pthread_mutex_lock(&se->lock);
-        while (se->have_work)
-            pthread_cond_wait(&se->cond, &se->lock);
-        se->have_work = -1;
-        pthread_cond_signal(&se->cond);
-        pthread_mutex_unlock(&se->lock);
+    if (se->have_thread) {
+        se_wait_idle(se);
+        se->exit_request = 1;
+        handoff_post(&se->req_seq, se->req_seq + 1, &se->req_sleeping);
         int ret = pthread_join(se->tid, NULL);
         if (ret)
             report_errno("se pthread_join", ret);
-        stepcompress_free(se->sc);
     }
+    stepcompress_free(se->sc);
     message_queue_free(&se->msg_queue);
+    mempool_free(se->msg_pool);
     free(se);
 }
 
@@ -228,6 +346,8 @@ struct steppersync {
     // Storage for list of pending move clocks
     uint64_t *move_clocks;
     int num_move_clocks;
+    // Generate steps using the worker pool (instead of per-stepper threads)
+    int use_pool;
 };
 
 // Allocate a new syncemitter instance
@@ -235,7 +355,8 @@ struct syncemitter * __visible
 steppersync_alloc_syncemitter(struct steppersync *ss, char name[16]
                               , int alloc_stepcompress)
 {
-    struct syncemitter *se = syncemitter_alloc(name, alloc_stepcompress);
+    struct syncemitter *se = syncemitter_alloc(name, alloc_stepcompress
+                                               , !ss->use_pool);
     if (se)
         list_add_tail(&se->ss_node, &ss->se_list);
     return se;
@@ -340,12 +461,234 @@ steppersync_flush(struct steppersync *ss, uint64_t move_clock)
 }
 
 
+/****************************************************************
+ * Step generation worker pool
+ ****************************************************************/
+
+// The optional worker pool generates the steps for all syncemitters
+// using a fixed number of threads (instead of a thread per stepper).
+// On each flush the syncemitters are distributed among per-worker
+// task lists.  A worker that empties its own task list then steals
+// the remaining tasks from the lists of the other workers.  The
+// thread that requests the flush also participates as a worker.  If
+// batching is enabled then syncemitters that share a trapq are
+// combined into a single task so that the trapq is traversed once.
+
+struct sg_tasklist {
+    struct syncemitter **tasks;
+    int count, alloc;
+    int next; // index of next unclaimed task (updated atomically)
+};
+
+struct sg_worker {
+    struct sg_pool *sp;
+    int id;
+    pthread_t tid;
+};
+
+struct sg_pool {
+    // Background threads (task list 0 is used by the requesting thread)
+    int num_workers, batch;
+    struct sg_worker *workers;
+    struct sg_tasklist *lists;
+    int next_list;
+    pthread_mutex_t lock; // protects variables below
+    pthread_cond_t cond, done_cond;
+    uint32_t generation;
+    int busy, exit_request;
+};
+
+// Claim the next task from a task list (or NULL if none remaining)
+static struct syncemitter *
+sg_tasklist_claim(struct sg_tasklist *tl)
+{
+    int idx = __atomic_fetch_add(&tl->next, 1, __ATOMIC_RELAXED);
+    return idx < tl->count ? tl->tasks[idx] : NULL;
+}
+
+// Run the tasks in the given task list and then steal from the others
+static void
+sg_pool_run_tasks(struct sg_pool *sp, int id)
+{
+    int num_lists = sp->num_workers + 1, i;
+    for (i=0; i<num_lists; i++) {
+        struct sg_tasklist *tl = &sp->lists[(id + i) % num_lists];
+        struct syncemitter *se;
+        while ((se = sg_tasklist_claim(tl))) {
+            se->bg_result = se_generate_steps(se);
+            if (se->bg_result)
+                errorf("Error in syncemitter '%s' step generation", se->name);
+        }
+    }
+}
+
+// Main background thread for a worker in the pool
+static void *
+sg_worker_thread(void *data)
+{
+    struct sg_worker *w = data;
+    struct sg_pool *sp = w->sp;
+    char name[16];
+    snprintf(name, sizeof(name), "stepgen%d", w->id);
+    set_thread_name(name);
+
+    pthread_mutex_lock(&sp->lock);
+    uint32_t generation = 0;
+    for (;;) {
+        if (sp->exit_request)
+            break;
+        if (sp->generation == generation) {
+            pthread_cond_wait(&sp->cond, &sp->lock);
+            continue;
+        }
+        generation = sp->generation;
+        pthread_mutex_unlock(&sp->lock);
+
+        // Request to generate steps
+        sg_pool_run_tasks(sp, w->id);
+
+        pthread_mutex_lock(&sp->lock);
+        sp->busy--;
+        if (!sp->busy)
+            pthread_cond_signal(&sp->done_cond);
+    }
+    pthread_mutex_unlock(&sp->lock);
+
+    return NULL;
+}
+
+// Add a syncemitter to the tasks of the next step generation request
+static void
+sg_pool_add_task(struct sg_pool *sp, struct syncemitter *se)
+{
+    struct sg_tasklist *tl = &sp->lists[sp->next_list];
+    sp->next_list = (sp->next_list + 1) % (sp->num_workers + 1);
+    if (tl->count >= tl->alloc) {
+        tl->alloc = tl->alloc ? tl->alloc * 2 : 8;
+        tl->tasks = realloc(tl->tasks, sizeof(*tl->tasks) * tl->alloc);
+    }
+    tl->tasks[tl->count++] = se;
+}
+
+// Add a syncemitter to an existing task using the same trapq
+static int
+sg_pool_add_to_batch(struct sg_pool *sp, struct syncemitter *se)
+{
+    struct trapq *tq = itersolve_get_trapq(se->sk);
+    if (!tq)
+        return 0;
+    int i, j;
+    for (i=0; i<sp->num_workers+1; i++) {
+        struct sg_tasklist *tl = &sp->lists[i];
+        for (j=0; j<tl->count; j++) {
+            struct syncemitter *leader = tl->tasks[j];
+            if (itersolve_get_trapq(leader->sk) != tq
+                || leader->batch_count >= ITERSOLVE_MAX_BATCH)
+                continue;
+            if (!leader->batch_count)
+                leader->batch[leader->batch_count++] = leader;
+            leader->batch[leader->batch_count++] = se;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Generate steps for all added tasks and wait for completion
+static void
+sg_pool_run(struct sg_pool *sp)
+{
+    pthread_mutex_lock(&sp->lock);
+    sp->generation++;
+    sp->busy = sp->num_workers;
+    pthread_cond_broadcast(&sp->cond);
+    pthread_mutex_unlock(&sp->lock);
+
+    sg_pool_run_tasks(sp, 0);
+
+    pthread_mutex_lock(&sp->lock);
+    while (sp->busy)
+        pthread_cond_wait(&sp->done_cond, &sp->lock);
+    pthread_mutex_unlock(&sp->lock);
+
+    // Reset task lists for next request
+    int i;
+    for (i=0; i<sp->num_workers+1; i++)
+        sp->lists[i].count = sp->lists[i].next = 0;
+    sp->next_list = 0;
+}
+
+// Allocate a worker pool and start its threads
+static struct sg_pool *
+sg_pool_alloc(int num_workers, int batch)
+{
+    struct sg_pool *sp = malloc(sizeof(*sp));
+    memset(sp, 0, sizeof(*sp));
+    sp->num_workers = num_workers;
+    sp->batch = batch;
+    sp->lists = malloc(sizeof(*sp->lists) * (num_workers + 1));
+    memset(sp->lists, 0, sizeof(*sp->lists) * (num_workers + 1));
+    sp->workers = malloc(sizeof(*sp->workers) * num_workers);
+    memset(sp->workers, 0, sizeof(*sp->workers) * num_workers);
+    int ret = pthread_mutex_init(&sp->lock, NULL);
+    if (ret)
+        goto fail;
+    ret = pthread_cond_init(&sp->cond, NULL);
+    if (ret)
+        goto fail;
+    ret = pthread_cond_init(&sp->done_cond, NULL);
+    if (ret)
+        goto fail;
+    int i;
+    for (i=0; i<num_workers; i++) {
+        struct sg_worker *w = &sp->workers[i];
+        w->sp = sp;
+        w->id = i + 1;
+        ret = pthread_create(&w->tid, NULL, sg_worker_thread, w);
+        if (ret)
+            goto fail;
+    }
+    return sp;
+fail:
+    report_errno("sg_pool alloc", ret);
+    return NULL;
+}
+
+// Free a worker pool and exit its threads
+static void
+sg_pool_free(struct sg_pool *sp)
+{
+    if (!sp)
+        return;
+    pthread_mutex_lock(&sp->lock);
+    sp->exit_request = 1;
+    pthread_cond_broadcast(&sp->cond);
+    pthread_mutex_unlock(&sp->lock);
+    int i;
+    for (i=0; i<sp->num_workers; i++) {
+        int ret = pthread_join(sp->workers[i].tid, NULL);
+        if (ret)
+            report_errno("sg_pool pthread_join", ret);
+    }
+    for (i=0; i<sp->num_workers+1; i++)
+        free(sp->lists[i].tasks);
+    free(sp->lists);
+    free(sp->workers);
+    free(sp);
+}
+
+
 /****************************************************************
  * StepperSyncMgr - manage a list of steppersync
  ****************************************************************/
 
 struct steppersyncmgr {
     struct list_head ss_list;
+    // Optional step generation worker pool
+    struct sg_pool *sg_pool;
+    // Step generation timing statistics
+    uint32_t gen_steps_count;
+    double gen_steps_time, gen_steps_max_time;
 };
 
 // Allocate a new 'steppersyncmgr' object
@@ -378,9 +721,23 @@ steppersyncmgr_free(struct steppersyncmgr *ssm)
         }
         free(ss);
     }
+    sg_pool_free(ssm->sg_pool);
     free(ssm);
 }
 
+// Generate steps using a pool of worker threads
+int __visible
+steppersyncmgr_setup_workers(struct steppersyncmgr *ssm, int num_workers
+                             , int batch)
+{
+    if (ssm->sg_pool || !list_empty(&ssm->ss_list) || num_workers <= 0) {
+        errorf("Invalid steppersyncmgr worker pool setup");
+        return -1;
+    }
+    ssm->sg_pool = sg_pool_alloc(num_workers, batch);
+    return ssm->sg_pool ? 0 : -1;
+}
+
 // Allocate a new 'steppersync' object
 struct steppersync * __visible
 steppersyncmgr_alloc_steppersync(struct steppersyncmgr *ssm)
@@ -388,10 +745,83 @@ steppersyncmgr_alloc_steppersync(struct steppersyncmgr *ssm)
     struct steppersync *ss = malloc(sizeof(*ss));
     memset(ss, 0, sizeof(*ss));
     list_init(&ss->se_list);
+    ss->use_pool = !!ssm->sg_pool;
     list_add_tail(&ss->ssm_node, &ssm->ss_list);
     return ss;
 }
 
+// Wait for all step generation threads to be idle
+static void
+ssm_wait_idle(struct steppersyncmgr *ssm)
+{
+    struct sg_pool *sp = ssm->sg_pool;
+    if (sp) {
+        pthread_mutex_lock(&sp->lock);
+        while (sp->busy)
+            pthread_cond_wait(&sp->done_cond, &sp->lock);
+        pthread_mutex_unlock(&sp->lock);
+    }
+    struct steppersync *ss;
+    list_for_each_entry(ss, &ssm->ss_list, ssm_node) {
+        struct syncemitter *se;
+        list_for_each_entry(se, &ss->se_list, ss_node) {
+            if (se->have_thread)
+                se_wait_idle(se);
+        }
+    }
+}
+
+// Report memory usage statistics for all syncemitters
+void __visible
+steppersyncmgr_get_stats(struct steppersyncmgr *ssm, char *buf, int len)
+{
+    // The pool and history state is owned by the step generation
+    // threads - only read it once they have finished all requests
+    ssm_wait_idle(ssm);
+    struct mempool_stats msgs, s;
+    memset(&msgs, 0, sizeof(msgs));
+    uint32_t history_count = 0, history_size = 0, count, size;
+    struct steppersync *ss;
+    list_for_each_entry(ss, &ssm->ss_list, ssm_node) {
+        struct syncemitter *se;
+        list_for_each_entry(se, &ss->se_list, ss_node) {
+            mempool_get_stats(se->msg_pool, &s);
+            msgs.alloc_count += s.alloc_count;
+            msgs.obj_count += s.obj_count;
+            msgs.in_use += s.in_use;
+            if (!se->sc)
+                continue;
+            stepcompress_get_history_stats(se->sc, &count, &size);
+            history_count += count;
+            history_size += size;
+        }
+    }
+    double avg_time = 0.;
+    if (ssm->gen_steps_count)
+        avg_time = ssm->gen_steps_time / ssm->gen_steps_count;
+    snprintf(buf, len, "msg_allocs=%llu msg_pool=%u msg_active=%u"
+             " history_entries=%u history_size=%u"
+             " stepgen_workers=%d gen_steps=%u"
+             " gen_steps_avg=%.6f gen_steps_max=%.6f"
+             , (unsigned long long)msgs.alloc_count, msgs.obj_count
+             , msgs.in_use, history_count, history_size
+             , ssm->sg_pool ? ssm->sg_pool->num_workers : 0
+             , ssm->gen_steps_count, avg_time, ssm->gen_steps_max_time);
+    // Timing statistics are reported per interval
+    ssm->gen_steps_count = 0;
+    ssm->gen_steps_time = ssm->gen_steps_max_time = 0.;
+}
+
+// Report the cpu time used generating steps for a stepper_kinematics
+double __visible
+steppersyncmgr_get_gen_steps_cpu_time(struct steppersyncmgr *ssm
+                                      , struct stepper_kinematics *sk)
+{
+    // The counter is updated by the step generation threads
+    ssm_wait_idle(ssm);
+    return itersolve_get_gen_steps_cpu_time(sk);
+}
+
 // Generate and flush steps
 int32_t __visible
 steppersyncmgr_gen_steps(struct steppersyncmgr *ssm, double flush_time
@@ -409,21 +839,47 @@ steppersyncmgr_gen_steps(struct steppersyncmgr *ssm, double flush_time
                 trapq_check_sentinels(tq);
         }
     }
-    // Start step generation threads
-    list_for_each_entry(ss, &ssm->ss_list, ssm_node) {
-        uint64_t flush_clock = clock_from_time(&ss->ce, flush_time);
-        uint64_t clear_clock = clock_from_time(&ss->ce, clear_history_time);
-        struct syncemitter *se;
-        list_for_each_entry(se, &ss->se_list, ss_node) {
-            se_start_gen_steps(se, gen_steps_time, flush_clock, clear_clock);
+    double start_time = get_monotonic();
+    struct sg_pool *sp = ssm->sg_pool;
+    if (sp) {
+        // Distribute step generation tasks to worker pool
+        list_for_each_entry(ss, &ssm->ss_list, ssm_node) {
+            uint64_t flush_clock = clock_from_time(&ss->ce, flush_time);
+            uint64_t clear_clock = clock_from_time(&ss->ce
+                                                   , clear_history_time);
+            struct syncemitter *se;
+            list_for_each_entry(se, &ss->se_list, ss_node) {
+                se->bg_result = se->batch_count = 0;
+                if (!se->sc || !se->sk)
+                    continue;
+                se->bg_gen_steps_time = gen_steps_time;
+                se->bg_flush_clock = flush_clock;
+                se->bg_clear_history_clock = clear_clock;
+                if (sp->batch && sg_pool_add_to_batch(sp, se))
+                    continue;
+                sg_pool_add_task(sp, se);
+            }
+        }
+        sg_pool_run(sp);
+    } else {
+        // Start step generation threads
+        list_for_each_entry(ss, &ssm->ss_list, ssm_node) {
+            uint64_t flush_clock = clock_from_time(&ss->ce, flush_time);
+            uint64_t clear_clock = clock_from_time(&ss->ce
+                                                   , clear_history_time);
+            struct syncemitter *se;
+            list_for_each_entry(se, &ss->se_list, ss_node) {
+                se_start_gen_steps(se, gen_steps_time, flush_clock
+                                   , clear_clock);
+            }
         }
     }
-    // Wait for step generation threads to complete
+    // Wait for step generation to complete
     int32_t res = 0;
     list_for_each_entry(ss, &ssm->ss_list, ssm_node) {
         struct syncemitter *se;
         list_for_each_entry(se, &ss->se_list, ss_node) {
-            int32_t ret = se_finalize_gen_steps(se);
+            int32_t ret = sp ? se->bg_result : se_finalize_gen_steps(se);
             if (ret)
                 res = ret;
         }
@@ -432,5 +888,11 @@ steppersyncmgr_gen_steps(struct steppersyncmgr *ssm, double flush_time
         uint64_t flush_clock = clock_from_time(&ss->ce, flush_time);
         steppersync_flush(ss, flush_clock);
     }
+    // Track timing statistics
+    double gen_time = get_monotonic() - start_time;
+    ssm->gen_steps_count++;
+    ssm->gen_steps_time += gen_time;
+    if (gen_time > ssm->gen_steps_max_time)
+        ssm->gen_steps_max_time = gen_time;
     return res;
 }
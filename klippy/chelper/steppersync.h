@@ -22,9 +22,14 @@ void steppersync_set_time(struct steppersync *ss, double time_offset
 
 struct steppersyncmgr *steppersyncmgr_alloc(void);
 void steppersyncmgr_free(struct steppersyncmgr *ssm);
+int steppersyncmgr_setup_workers(struct steppersyncmgr *ssm, int num_workers
+                                 , int batch);
 struct serialqueue;
 struct steppersync *steppersyncmgr_alloc_steppersync(
     struct steppersyncmgr *ssm);
+void steppersyncmgr_get_stats(struct steppersyncmgr *ssm, char *buf, int len);
+double steppersyncmgr_get_gen_steps_cpu_time(struct steppersyncmgr *ssm
+                                             , struct stepper_kinematics *sk);
 int32_t steppersyncmgr_gen_steps(struct steppersyncmgr *ssm, double flush_time
                                  , double gen_steps_time
                                  , double clear_history_time);
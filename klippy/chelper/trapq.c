@@ -11,15 +11,75 @@
 #include "compiler.h" // unlikely
 #include "trapq.h" // move_get_coord
 
+// Moves are appended in time order and are (almost always) freed in
+// time order, so they are allocated sequentially from large chunks.
+// This keeps neighboring moves adjacent in memory.  A chunk is only
+// released once all of its moves have been freed.
+
+#define MOVE_CHUNK_SIZE 256
+
+struct move_chunk {
+    struct list_node node;
+    int alloc_count, free_count;
+    struct move moves[MOVE_CHUNK_SIZE];
+};
+
+// Allocate a new move storage chunk
+static struct move_chunk *
+move_chunk_alloc(struct trapq *tq)
+{
+    struct move_chunk *mc = tq->spare_chunk;
+    if (mc)
+        tq->spare_chunk = NULL;
+    else
+        mc = malloc(sizeof(*mc));
+    mc->alloc_count = mc->free_count = 0;
+    list_add_tail(&mc->node, &tq->chunks);
+    return mc;
+}
+
+// Release a move storage chunk (retaining one for reuse)
+static void
+move_chunk_release(struct trapq *tq, struct move_chunk *mc)
+{
+    list_del(&mc->node);
+    if (tq->spare_chunk)
+        free(mc);
+    else
+        tq->spare_chunk = mc;
+}
+
 // Allocate a new 'move' object
 struct move *
-move_alloc(void)
+move_alloc(struct trapq *tq)
 {
-    struct move *m = malloc(sizeof(*m));
+    struct move_chunk *mc = NULL;
+    if (!list_empty(&tq->chunks))
+        mc = list_last_entry(&tq->chunks, struct move_chunk, node);
+    if (!mc || mc->alloc_count >= MOVE_CHUNK_SIZE)
+        mc = move_chunk_alloc(tq);
+    struct move *m = &mc->moves[mc->alloc_count++];
     memset(m, 0, sizeof(*m));
+    m->chunk = mc;
     return m;
 }
 
+// Free a 'move' object
+void
+move_free(struct trapq *tq, struct move *m)
+{
+    struct move_chunk *mc = m->chunk;
+    mc->free_count++;
+    if (mc->free_count != mc->alloc_count)
+        return;
+    if (mc->alloc_count < MOVE_CHUNK_SIZE
+        && mc == list_last_entry(&tq->chunks, struct move_chunk, node))
+        // Restart allocations at the beginning of the active chunk
+        mc->alloc_count = mc->free_count = 0;
+    else
+        move_chunk_release(tq, mc);
+}
+
 // Return the distance moved given a time in a move
 inline double
 move_get_distance(struct move *m, double move_time)
@@ -48,7 +108,9 @@ trapq_alloc(void)
     memset(tq, 0, sizeof(*tq));
     list_init(&tq->moves);
     list_init(&tq->history);
-    struct move *head_sentinel = move_alloc(), *tail_sentinel = move_alloc();
+    list_init(&tq->chunks);
+    struct move *head_sentinel = &tq->head_sentinel;
+    struct move *tail_sentinel = &tq->tail_sentinel;
     head_sentinel->print_time = -1.0;
     tail_sentinel->print_time = tail_sentinel->move_t = NEVER_TIME;
     list_add_head(&head_sentinel->node, &tq->moves);
@@ -60,16 +122,14 @@ trapq_alloc(void)
 void __visible
 trapq_free(struct trapq *tq)
 {
-    while (!list_empty(&tq->moves)) {
-        struct move *m = list_first_entry(&tq->moves, struct move, node);
-        list_del(&m->node);
-        free(m);
-    }
-    while (!list_empty(&tq->history)) {
-        struct move *m = list_first_entry(&tq->history, struct move, node);
-        list_del(&m->node);
-        free(m);
+    // All moves are released in bulk with their storage chunks
+    while (!list_empty(&tq->chunks)) {
+        struct move_chunk *mc = list_first_entry(&tq->chunks
+                                                 , struct move_chunk, node);
+        list_del(&mc->node);
+        free(mc);
     }
+    free(tq->spare_chunk);
     free(tq);
 }
 
@@ -102,7 +162,7 @@ trapq_add_move(struct trapq *tq, struct move *m)
     struct move *prev = list_prev_entry(tail_sentinel, node);
     if (prev->print_time + prev->move_t < m->print_time) {
         // Add a null move to fill time gap
-        struct move *null_move = move_alloc();
+        struct move *null_move = move_alloc(tq);
         null_move->start_pos = m->start_pos;
         if (prev->print_time <= 0. && m->print_time > MAX_NULL_MOVE)
             // Limit the first null move to improve numerical stability
@@ -127,7 +187,7 @@ trapq_append(struct trapq *tq, double print_time
     struct coord start_pos = { .x=start_pos_x, .y=start_pos_y, .z=start_pos_z };
     struct coord axes_r = { .x=axes_r_x, .y=axes_r_y, .z=axes_r_z };
     if (accel_t) {
-        struct move *m = move_alloc();
+        struct move *m = move_alloc(tq);
         m->print_time = print_time;
         m->move_t = accel_t;
         m->start_v = start_v;
@@ -140,7 +200,7 @@ trapq_append(struct trapq *tq, double print_time
         start_pos = move_get_coord(m, accel_t);
     }
     if (cruise_t) {
-        struct move *m = move_alloc();
+        struct move *m = move_alloc(tq);
         m->print_time = print_time;
         m->move_t = cruise_t;
         m->start_v = cruise_v;
@@ -153,7 +213,7 @@ trapq_append(struct trapq *tq, double print_time
         start_pos = move_get_coord(m, cruise_t);
     }
     if (decel_t) {
-        struct move *m = move_alloc();
+        struct move *m = move_alloc(tq);
         m->print_time = print_time;
         m->move_t = decel_t;
         m->start_v = cruise_v;
@@ -184,7 +244,7 @@ trapq_finalize_moves(struct trapq *tq, double print_time
         if (m->start_v || m->half_accel)
             list_add_head(&m->node, &tq->history);
         else
-            free(m);
+            move_free(tq, m);
     }
     // Free old moves from history list
     if (list_empty(&tq->history))
@@ -195,7 +255,7 @@ trapq_finalize_moves(struct trapq *tq, double print_time
         if (m == latest || m->print_time + m->move_t > clear_history_time)
             break;
         list_del(&m->node);
-        free(m);
+        move_free(tq, m);
     }
 }
 
@@ -216,11 +276,11 @@ trapq_set_position(struct trapq *tq, double print_time
             break;
         }
         list_del(&m->node);
-        free(m);
+        move_free(tq, m);
     }
 
     // Add a marker to the trapq history
-    struct move *m = move_alloc();
+    struct move *m = move_alloc(tq);
     m->print_time = print_time;
     m->start_pos.x = pos_x;
     m->start_pos.y = pos_y;
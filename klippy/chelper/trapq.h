@@ -18,10 +18,15 @@ struct move {
     struct coord start_pos, axes_r;
 
     struct list_node node;
+    struct move_chunk *chunk;
 };
 
 struct trapq {
     struct list_head moves, history;
+    struct move head_sentinel, tail_sentinel;
+    // Storage for moves (see move_alloc)
+    struct list_head chunks;
+    struct move_chunk *spare_chunk;
 };
 
 struct pull_move {
@@ -31,7 +36,8 @@ struct pull_move {
     double x_r, y_r, z_r;
 };
 
-struct move *move_alloc(void);
+struct move *move_alloc(struct trapq *tq);
+void move_free(struct trapq *tq, struct move *m);
 double move_get_distance(struct move *m, double move_time);
 struct coord move_get_coord(struct move *m, double move_time);
 struct trapq *trapq_alloc(void);
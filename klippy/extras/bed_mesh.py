@@ -206,26 +206,38 @@ class BedMesh:
             self.last_position[:] = [x, y, z - final_z_adj] + cur_pos[3:]
         return list(self.last_position)
     def move(self, newpos, speed):
-        factor = self.get_z_factor(newpos[2])
-        if self.z_mesh is None or not factor:
-            # No mesh calibrated, or mesh leveling phased out.
-            x, y, z = newpos[:3]
-            if self.log_fade_complete:
-                self.log_fade_complete = False
-                logging.info(
-                    "bed_mesh fade complete: Current Z: %.4f fade_target: %.4f "
-                    % (z, self.fade_target))
-            self.toolhead.move([x, y, z + self.fade_target] + newpos[3:], speed)
-        else:
-            self.splitter.build_move(self.last_position, newpos, factor)
-            while not self.splitter.traverse_complete:
-                split_move = self.splitter.split()
-                if split_move:
-                    self.toolhead.move(split_move, speed)
-                else:
-                    raise self.gcode.error(
-                        "Mesh Leveling: Error splitting move ")
-        self.last_position[:] = newpos
+        self.move_batch(((newpos, speed),))
+    def _mesh_moves(self, moves):
+        # Generate the toolhead moves (with the mesh applied) for a
+        # sequence of (newpos, speed) moves
+        for newpos, speed in moves:
+            factor = self.get_z_factor(newpos[2])
+            if self.z_mesh is None or not factor:
+                # No mesh calibrated, or mesh leveling phased out.
+                x, y, z = newpos[:3]
+                if self.log_fade_complete:
+                    self.log_fade_complete = False
+                    logging.info(
+                        "bed_mesh fade complete: Current Z: %.4f"
+                        " fade_target: %.4f " % (z, self.fade_target))
+                yield [x, y, z + self.fade_target] + newpos[3:], speed
+            else:
+                self.splitter.build_move(self.last_position, newpos, factor)
+                while not self.splitter.traverse_complete:
+                    split_move = self.splitter.split()
+                    if not split_move:
+                        raise self.gcode.error(
+                            "Mesh Leveling: Error splitting move ")
+                    yield split_move, speed
+            self.last_position[:] = newpos
+    def move_batch(self, moves):
+        # Queue a sequence of (newpos, speed) moves with the mesh applied
+        try:
+            self.toolhead.move_batch(self._mesh_moves(moves))
+        except:
+            # Resync last_position with the moves the toolhead accepted
+            self.get_position()
+            raise
     def get_status(self, eventtime=None):
         return self.status
     def update_status(self):
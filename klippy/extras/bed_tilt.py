@@ -29,9 +29,14 @@ class BedTilt:
         z -= x*self.x_adjust + y*self.y_adjust + self.z_adjust
         return [x, y, z] + pos[3:]
     def move(self, newpos, speed):
-        x, y, z = newpos[:3]
-        z += x*self.x_adjust + y*self.y_adjust + self.z_adjust
-        self.toolhead.move([x, y, z] + newpos[3:], speed)
+        self.move_batch(((newpos, speed),))
+    def _tilt_moves(self, moves):
+        for newpos, speed in moves:
+            x, y, z = newpos[:3]
+            z += x*self.x_adjust + y*self.y_adjust + self.z_adjust
+            yield [x, y, z] + newpos[3:], speed
+    def move_batch(self, moves):
+        self.toolhead.move_batch(self._tilt_moves(moves))
     def update_adjust(self, x_adjust, y_adjust, z_adjust):
         self.x_adjust = x_adjust
         self.y_adjust = y_adjust
@@ -4,6 +4,7 @@
 #
 # This file may be distributed under the terms of the GNU GPLv3 license.
 import logging, threading, struct
+import chelper
 
 # This "bulk sensor" module facilitates the processing of sensor chip
 # measurements that do not require the host to respond with low
@@ -131,6 +132,50 @@ class BulkDataQueue:
     def clear_queue(self):
         self.pull_queue()
 
+# Number of sensor_bulk_data messages that BulkDataBuffer can store
+BULK_BUFFER_BLOCKS = 4096
+
+# Helper class to store incoming sensor_bulk_data messages in a C ring
+# buffer.  The messages are stored by the serialqueue background
+# thread, and the python code processes them in place (via memoryview).
+class BulkDataBuffer:
+    def __init__(self, mcu, oid, block_count=BULK_BUFFER_BLOCKS):
+        ffi_main, ffi_lib = chelper.get_ffi()
+        self.ffi_buffer = ffi_main.buffer
+        self.block_size = ffi_main.sizeof("struct bulkqueue_block")
+        self.data_offset = ffi_main.offsetof("struct bulkqueue_block", "data")
+        self.bulkqueue_peek = ffi_lib.bulkqueue_peek
+        self.bulkqueue_release = ffi_lib.bulkqueue_release
+        self.bulkqueue_clear = ffi_lib.bulkqueue_clear
+        self.bulkqueue_get_dropped = ffi_lib.bulkqueue_get_dropped
+        self.pblocks = ffi_main.new("struct bulkqueue_block **")
+        msgtag = mcu.lookup_command(
+            "sensor_bulk_data oid=%c sequence=%hu data=%*s").get_command_tag()
+        sq = mcu.get_serialqueue()
+        # The destructor references 'sq' so that the serialqueue is
+        # not freed before the fastreader is unregistered from it
+        bulkqueue_free = ffi_lib.bulkqueue_free
+        self.bulkqueue = ffi_main.gc(
+            ffi_lib.bulkqueue_alloc(sq, msgtag, oid, block_count),
+            lambda bq, sq=sq: bulkqueue_free(bq))
+    def get_block_layout(self):
+        # Returns the size of each stored block and the offset of its data
+        return self.block_size, self.data_offset
+    def peek_blocks(self):
+        # Returns (count, memoryview) of contiguous stored blocks.  The
+        # blocks remain valid until release_blocks() is called.
+        count = self.bulkqueue_peek(self.bulkqueue, self.pblocks)
+        if not count:
+            return 0, None
+        buf = self.ffi_buffer(self.pblocks[0], count * self.block_size)
+        return count, memoryview(buf)
+    def release_blocks(self, count):
+        self.bulkqueue_release(self.bulkqueue, count)
+    def get_dropped(self):
+        return self.bulkqueue_get_dropped(self.bulkqueue)
+    def clear_queue(self):
+        self.bulkqueue_clear(self.bulkqueue)
+
 
 ######################################################################
 # Clock synchronization
@@ -208,6 +253,7 @@ class FixedFreqReader:
         self.clock_sync = ClockSyncRegression(mcu, chip_clock_smooth)
         unpack = struct.Struct(unpack_fmt)
         self.unpack_from = unpack.unpack_from
+        self.unpack_block_header = struct.Struct("=HB").unpack_from
         self.bytes_per_sample = unpack.size
         self.samples_per_block = MAX_BULK_MSG_SIZE // self.bytes_per_sample
         self.last_sequence = self.max_query_duration = 0
@@ -221,9 +267,9 @@ class FixedFreqReader:
             " next_sequence=%hu buffered=%u possible_overflows=%hu",
             oid=oid, cq=cq)
         # Read sensor_bulk_data messages and store in a queue
-        self.bulk_queue = BulkDataQueue(self.mcu, oid=oid)
+        self.bulk_queue = BulkDataBuffer(self.mcu, oid)
     def get_last_overflows(self):
-        return self.last_overflows
+        return self.last_overflows + self.bulk_queue.get_dropped()
     def _clear_duration_filter(self):
         self.max_query_duration = 1 << 31
     def note_start(self):
@@ -268,30 +314,35 @@ class FixedFreqReader:
     def pull_samples(self):
         # Query MCU for sample timing and update clock synchronization
         self._update_clock()
-        # Pull sensor_bulk_data messages from local queue
-        raw_samples = self.bulk_queue.pull_queue()
-        if not raw_samples:
-            return []
         # Load variables to optimize inner loop below
         last_sequence = self.last_sequence
         time_base, chip_base, inv_freq = self.clock_sync.get_time_translation()
         unpack_from = self.unpack_from
+        unpack_block_header = self.unpack_block_header
         bytes_per_sample = self.bytes_per_sample
         samples_per_block = self.samples_per_block
-        # Process every message in raw_samples
-        count = seq = 0
-        samples = [None] * (len(raw_samples) * samples_per_block)
-        for params in raw_samples:
-            seq_diff = (params['sequence'] - last_sequence) & 0xffff
-            seq_diff -= (seq_diff & 0x8000) << 1
-            seq = last_sequence + seq_diff
-            msg_cdiff = seq * samples_per_block - chip_base
-            data = params['data']
-            for i in range(len(data) // bytes_per_sample):
-                ptime = time_base + (msg_cdiff + i) * inv_freq
-                udata = unpack_from(data, i * bytes_per_sample)
-                samples[count] = (ptime,) + udata
-                count += 1
+        block_size, data_offset = self.bulk_queue.get_block_layout()
+        # Process every message stored in the bulk queue
+        samples = []
+        seq = i = 0
+        while 1:
+            block_count, blocks = self.bulk_queue.peek_blocks()
+            if not block_count:
+                break
+            for block_pos in range(0, block_count * block_size, block_size):
+                sequence, data_len = unpack_block_header(blocks, block_pos)
+                seq_diff = (sequence - last_sequence) & 0xffff
+                seq_diff -= (seq_diff & 0x8000) << 1
+                seq = last_sequence + seq_diff
+                msg_cdiff = seq * samples_per_block - chip_base
+                data_pos = block_pos + data_offset
+                for i in range(data_len // bytes_per_sample):
+                    ptime = time_base + (msg_cdiff + i) * inv_freq
+                    udata = unpack_from(blocks, data_pos)
+                    data_pos += bytes_per_sample
+                    samples.append((ptime,) + udata)
+            self.bulk_queue.release_blocks(block_count)
+        if not samples:
+            return samples
         self.clock_sync.set_last_chip_clock(seq * samples_per_block + i)
-        del samples[count:]
         return samples
@@ -15,6 +15,10 @@ class PrinterExtruderStepper:
                                             self.handle_connect)
     def handle_connect(self):
         self.extruder_stepper.sync_to_extruder(self.extruder_name)
+    def stats(self, eventtime):
+        is_active, msg = self.extruder_stepper.stats(eventtime)
+        return is_active, "extruder_stepper %s: %s" % (
+            self.extruder_stepper.name, msg)
     def find_past_position(self, print_time):
         return self.extruder_stepper.find_past_position(print_time)
     def get_status(self, eventtime):
@@ -5,6 +5,10 @@
 # This file may be distributed under the terms of the GNU GPLv3 license.
 import logging
 
+# Location of the 'F' parameter in a natively tokenized move
+FIELD_F_INDEX = ord('F') - ord('A')
+FIELD_F_BIT = 1 << FIELD_F_INDEX
+
 class GCodeMove:
     def __init__(self, config):
         self.printer = printer = config.get_printer()
@@ -21,6 +25,10 @@ class GCodeMove:
             desc = getattr(self, 'cmd_' + cmd + '_help', None)
             gcode.register_command(cmd, func, False, desc)
         gcode.register_command('G0', self.cmd_G1)
+        gcode.register_fast_move_command('G0', self._fast_G1,
+                                         self._fast_G1_batch)
+        gcode.register_fast_move_command('G1', self._fast_G1,
+                                         self._fast_G1_batch)
         gcode.register_command('M114', self.cmd_M114, True)
         gcode.register_command('GET_POSITION', self.cmd_GET_POSITION, True,
                                desc=self.cmd_GET_POSITION_help)
@@ -31,12 +39,14 @@ class GCodeMove:
         self.last_position = [0.0, 0.0, 0.0, 0.0]
         self.homing_position = [0.0, 0.0, 0.0, 0.0]
         self.axis_map = {'X':0, 'Y': 1, 'Z': 2, 'E': 3}
+        self.fast_axis_map = self._build_fast_axis_map()
         self.speed = 25.
         self.speed_factor = 1. / 60.
         self.extrude_factor = 1.
         # G-Code state
         self.saved_states = {}
         self.move_transform = self.move_with_transform = None
+        self.move_batch_with_transform = None
         self.position_with_transform = (lambda: [0., 0., 0., 0.])
         # Register callbacks
         printer.register_event_handler("klippy:ready", self._handle_ready)
@@ -60,6 +70,7 @@ class GCodeMove:
         if self.move_transform is None:
             toolhead = self.printer.lookup_object('toolhead')
             self.move_with_transform = toolhead.move
+            self.move_batch_with_transform = toolhead.move_batch
             self.position_with_transform = toolhead.get_position
         self.reset_last_position()
     def _handle_shutdown(self):
@@ -89,8 +100,15 @@ class GCodeMove:
             old_transform = self.printer.lookup_object('toolhead', None)
         self.move_transform = transform
         self.move_with_transform = transform.move
+        self.move_batch_with_transform = getattr(
+            transform, 'move_batch', self._move_batch_fallback)
         self.position_with_transform = transform.get_position
         return old_transform
+    def _move_batch_fallback(self, moves):
+        # Transform doesn't support batches - issue the moves one by one
+        move_with_transform = self.move_with_transform
+        for newpos, speed in moves:
+            move_with_transform(newpos, speed)
     def _get_gcode_position(self):
         p = [lp - bp for lp, bp in zip(self.last_position, self.base_position)]
         p[3] /= self.extrude_factor
@@ -128,6 +146,7 @@ class GCodeMove:
                 continue
             axis_map[gcode_id] = index
         self.axis_map = axis_map
+        self.fast_axis_map = self._build_fast_axis_map()
         self.base_position[4:] = [0.] * (len(extra_axes) - 4)
         self.reset_last_position()
     # G-Code movement commands
@@ -159,6 +178,77 @@ class GCodeMove:
             raise gcmd.error("Unable to parse move '%s'"
                              % (gcmd.get_commandline(),))
         self.move_with_transform(self.last_position, self.speed)
+    def _build_fast_axis_map(self):
+        # Map axes to the fields of a natively tokenized move
+        return [(1 << (ord(axis) - ord('A')), ord(axis) - ord('A'),
+                 axis == 'E', pos)
+                for axis, pos in self.axis_map.items() if 'A' <= axis <= 'Z']
+    def _fast_G1(self, fields, commandline):
+        # Move (from a line tokenized by the C code - see gcodeparse.c)
+        mask = fields.mask
+        values = fields.values
+        for axis_bit, field_index, is_extrude, pos in self.fast_axis_map:
+            if mask & axis_bit:
+                v = values[field_index]
+                absolute_coord = self.absolute_coord
+                if is_extrude:
+                    v *= self.extrude_factor
+                    if not self.absolute_extrude:
+                        absolute_coord = False
+                if not absolute_coord:
+                    # value relative to position of last move
+                    self.last_position[pos] += v
+                else:
+                    # value relative to base coordinate position
+                    self.last_position[pos] = v + self.base_position[pos]
+        if mask & FIELD_F_BIT:
+            gcode_speed = values[FIELD_F_INDEX]
+            if gcode_speed <= 0.:
+                raise self.printer.command_error("Invalid speed in '%s'"
+                                                 % (commandline,))
+            self.speed = gcode_speed * self.speed_factor
+        self.move_with_transform(self.last_position, self.speed)
+    def _fast_G1_moves(self, fields_iter):
+        # Convert tokenized moves to (newpos, speed) moves as they are
+        # requested by the transform
+        last_position = self.last_position
+        base_position = self.base_position
+        extrude_factor = self.extrude_factor
+        absolute_coord = self.absolute_coord
+        absolute_extrude = absolute_coord and self.absolute_extrude
+        fast_axis_map = self.fast_axis_map
+        for fields in fields_iter:
+            mask = fields.mask
+            values = fields.values
+            for axis_bit, field_index, is_extrude, pos in fast_axis_map:
+                if mask & axis_bit:
+                    v = values[field_index]
+                    is_absolute = absolute_coord
+                    if is_extrude:
+                        v *= extrude_factor
+                        is_absolute = absolute_extrude
+                    if not is_absolute:
+                        last_position[pos] += v
+                    else:
+                        last_position[pos] = v + base_position[pos]
+            if mask & FIELD_F_BIT:
+                gcode_speed = values[FIELD_F_INDEX]
+                if gcode_speed <= 0.:
+                    raise self.printer.command_error(
+                        "Invalid speed in pre-parsed move")
+                self.speed = gcode_speed * self.speed_factor
+            yield list(last_position), self.speed
+    def _fast_G1_batch(self, fields_iter):
+        # Process a sequence of tokenized moves and issue them in one
+        # batch.  The moves are generated lazily, so the moves prior to
+        # an error are queued and the fields iterator tracks progress.
+        try:
+            self.move_batch_with_transform(self._fast_G1_moves(fields_iter))
+        except:
+            # last_position may have been advanced past the moves that
+            # were actually queued - resync it
+            self.reset_last_position()
+            raise
     # G-Code coordinate manipulation
     def cmd_G20(self, gcmd):
         # Set units to inches
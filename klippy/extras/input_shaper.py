@@ -11,7 +11,8 @@ from . import shaper_defs
 class InputShaperParams:
     def __init__(self, axis, config):
         self.axis = axis
-        self.shapers = {s.name : s for s in shaper_defs.INPUT_SHAPERS}
+        self.shapers = {s.name : s for s in (shaper_defs.INPUT_SHAPERS
+                                             + shaper_defs.INPUT_SMOOTHERS)}
         shaper_type = config.get('shaper_type', 'mzv')
         self.shaper_type = config.get('shaper_type_' + axis, shaper_type)
         if self.shaper_type not in self.shapers:
@@ -40,12 +41,18 @@ class InputShaperParams:
         self.damping_ratio = damping_ratio
         self.shaper_type = shaper_type.lower()
     def get_shaper(self):
+        # Returns (n, A, T, t_sm) - for smoothers 'A' holds the kernel
+        # polynomial coefficients and 't_sm' its duration
         if not self.shaper_freq:
             A, T = shaper_defs.get_none_shaper()
-        else:
-            A, T = self.shapers[self.shaper_type].init_func(
-                    self.shaper_freq, self.damping_ratio)
-        return len(A), A, T
+            return len(A), A, T, 0.
+        shaper_cfg = self.shapers[self.shaper_type]
+        if isinstance(shaper_cfg, shaper_defs.InputSmootherCfg):
+            C, t_sm = shaper_cfg.init_func(self.shaper_freq,
+                                           self.damping_ratio)
+            return len(C), C, [], t_sm
+        A, T = shaper_cfg.init_func(self.shaper_freq, self.damping_ratio)
+        return len(A), A, T, 0.
     def get_status(self):
         return collections.OrderedDict([
             ('shaper_type', self.shaper_type),
@@ -56,36 +63,40 @@ class AxisInputShaper:
     def __init__(self, axis, config):
         self.axis = axis
         self.params = InputShaperParams(axis, config)
-        self.n, self.A, self.T = self.params.get_shaper()
+        self.n, self.A, self.T, self.t_sm = self.params.get_shaper()
         self.saved = None
     def get_name(self):
         return 'shaper_' + self.axis
     def get_shaper(self):
-        return self.n, self.A, self.T
+        return self.n, self.A, self.T, self.t_sm
     def update(self, gcmd):
         self.params.update(gcmd)
-        self.n, self.A, self.T = self.params.get_shaper()
-    def set_shaper_kinematics(self, sk):
+        self.n, self.A, self.T, self.t_sm = self.params.get_shaper()
+    def _set_params(self, sk):
         ffi_main, ffi_lib = chelper.get_ffi()
-        success = ffi_lib.input_shaper_set_shaper_params(
+        if self.t_sm:
+            return ffi_lib.input_shaper_set_smoother_params(
+                    sk, self.axis.encode(), self.n, self.A, self.t_sm) == 0
+        return ffi_lib.input_shaper_set_shaper_params(
                 sk, self.axis.encode(), self.n, self.A, self.T) == 0
+    def set_shaper_kinematics(self, sk):
+        success = self._set_params(sk)
         if not success:
             self.disable_shaping()
-            ffi_lib.input_shaper_set_shaper_params(
-                    sk, self.axis.encode(), self.n, self.A, self.T)
+            self._set_params(sk)
         return success
     def is_enabled(self):
         return self.n > 0
     def disable_shaping(self):
         if self.saved is None and self.n:
-            self.saved = (self.n, self.A, self.T)
+            self.saved = (self.n, self.A, self.T, self.t_sm)
         A, T = shaper_defs.get_none_shaper()
-        self.n, self.A, self.T = len(A), A, T
+        self.n, self.A, self.T, self.t_sm = len(A), A, T, 0.
     def enable_shaping(self):
         if self.saved is None:
             # Input shaper was not disabled
             return
-        self.n, self.A, self.T = self.saved
+        self.n, self.A, self.T, self.t_sm = self.saved
         self.saved = None
     def report(self, gcmd):
         info = ' '.join(["%s_%s:%s" % (key, self.axis, value)
@@ -104,6 +115,7 @@ class InputShaper:
                         AxisInputShaper('z', config)]
         self.input_shaper_stepper_kinematics = []
         self.orig_stepper_kinematics = []
+        self.piecewise_shaping = config.getboolean('piecewise_shaping', False)
         # Register gcode commands
         gcode = self.printer.lookup_object('gcode')
         gcode.register_command("SET_INPUT_SHAPER",
@@ -132,6 +144,7 @@ class InputShaper:
             return sk
         ffi_main, ffi_lib = chelper.get_ffi()
         is_sk = ffi_main.gc(ffi_lib.input_shaper_alloc(), ffi_lib.free)
+        ffi_lib.input_shaper_set_segments(is_sk, self.piecewise_shaping)
         stepper.set_stepper_kinematics(is_sk)
         res = ffi_lib.input_shaper_set_sk(is_sk, sk)
         if res < 0:
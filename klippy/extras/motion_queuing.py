@@ -34,6 +34,22 @@ class PrinterMotionQueuing:
         self.syncemitters = []
         self.steppersyncs = []
         self.steppersyncmgr_gen_steps = ffi_lib.steppersyncmgr_gen_steps
+        self.stats_buf = ffi_main.new('char[4096]')
+        self.incremental_stepcompress = config.getboolean(
+            'incremental_step_compression', False)
+        self.analytic_step_solver = config.getboolean(
+            'analytic_step_solver', False)
+        step_gen_threads = config.getint('step_generation_threads', 0,
+                                         minval=0, maxval=64)
+        batch_step_gen = config.getboolean('batch_step_generation', False)
+        if batch_step_gen and not step_gen_threads:
+            raise config.error("Option 'batch_step_generation' requires"
+                               " 'step_generation_threads'")
+        if step_gen_threads:
+            ret = ffi_lib.steppersyncmgr_setup_workers(
+                self.steppersyncmgr, step_gen_threads, batch_step_gen)
+            if ret:
+                raise config.error("Unable to start step generation threads")
         # History expiration
         self.clear_history_time = 0.
         # Flush notification callbacks
@@ -84,8 +100,15 @@ class PrinterMotionQueuing:
         ss = self._lookup_steppersync(mcu)
         ffi_main, ffi_lib = chelper.get_ffi()
         se = ffi_lib.steppersync_alloc_syncemitter(ss, name, alloc_stepcompress)
+        if alloc_stepcompress:
+            sc = ffi_lib.syncemitter_get_stepcompress(se)
+            ffi_lib.stepcompress_set_incremental(sc,
+                                                 self.incremental_stepcompress)
         self.syncemitters.append(se)
         return se
+    def setup_stepper_kinematics(self, sk):
+        ffi_main, ffi_lib = chelper.get_ffi()
+        ffi_lib.itersolve_set_analytic(sk, self.analytic_step_solver)
     def setup_mcu_movequeue(self, mcu, serialqueue, move_count):
         # Setup steppersync object for the mcu's main movequeue
         ffi_main, ffi_lib = chelper.get_ffi()
@@ -103,7 +126,15 @@ class PrinterMotionQueuing:
         # Calculate history expiration
         est_print_time = self.mcu.estimated_print_time(eventtime)
         self.clear_history_time = max(0., est_print_time - MOVE_HISTORY_EXPIRE)
-        return False, ""
+        # Report step generation memory pool usage
+        ffi_lib.steppersyncmgr_get_stats(self.steppersyncmgr, self.stats_buf,
+                                         len(self.stats_buf))
+        stats = ffi_main.string(self.stats_buf).decode()
+        return False, "motion_queuing: %s" % (stats,)
+    def get_gen_steps_cpu_time(self, sk):
+        ffi_main, ffi_lib = chelper.get_ffi()
+        return ffi_lib.steppersyncmgr_get_gen_steps_cpu_time(
+            self.steppersyncmgr, sk)
     # Flush notification callbacks
     def register_flush_callback(self, callback, can_add_trapq=False):
         if can_add_trapq:
@@ -275,7 +275,8 @@ class ShaperCalibrate:
             min_freq = min(min_freq, data.freq_bins.min())
         for test_freq in test_freqs[::-1]:
             shaper_vibrations = 0.
-            shaper = shaper_cfg.init_func(test_freq, damping_ratio)
+            shaper = shaper_defs.get_shaper_pulses(shaper_cfg, test_freq,
+                                                   damping_ratio)
             shaper_smoothing = self._get_shaper_smoothing(shaper, scv=scv)
             if max_smoothing and shaper_smoothing > max_smoothing and best_res:
                 return [best_res] + results
@@ -359,7 +360,8 @@ class ShaperCalibrate:
         best_shaper = None
         all_shapers = []
         shapers = shapers or AUTOTUNE_SHAPERS
-        for shaper_cfg in shaper_defs.INPUT_SHAPERS:
+        for shaper_cfg in (shaper_defs.INPUT_SHAPERS
+                           + shaper_defs.INPUT_SMOOTHERS):
             if shaper_cfg.name not in shapers:
                 continue
             fit_results = self.background_process_exec(self.fit_shaper, (
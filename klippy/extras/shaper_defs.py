@@ -11,6 +11,12 @@ DEFAULT_DAMPING_RATIO = 0.1
 InputShaperCfg = collections.namedtuple(
         'InputShaperCfg',
         ('name', 'init_func', 'min_freq', 'max_damping_ratio'))
+InputSmootherCfg = collections.namedtuple(
+        'InputSmootherCfg',
+        ('name', 'init_func', 'min_freq', 'max_damping_ratio'))
+
+# Number of pulses used to approximate a smoother during calibration
+SMOOTHER_APPROX_PULSES = 64
 
 def get_none_shaper():
     return ([], [])
@@ -104,6 +110,47 @@ def get_3hump_ei_shaper(shaper_freq, damping_ratio):
          [0.11244, -0.45439,  0.96382, -1.46000]]
     return _get_shaper_from_expansion_coeffs(shaper_freq, damping_ratio, t, a)
 
+# Smoothers are continuous polynomial kernels C[0] + C[1]*t + C[2]*t^2 + ...
+# defined for t in [-t_sm/2, t_sm/2].  The duration t_sm is chosen so
+# that the first zero of the kernel frequency response is at shaper_freq.
+
+def get_p2_smoother(shaper_freq, damping_ratio):
+    # Parabolic kernel 1 - (t/h)^2; first zero of response at 2*pi*f*h=x
+    # where x is the first positive root of tan(x) = x
+    h = 4.493409457909064 / (2. * math.pi * shaper_freq)
+    C = [1., 0., -1. / h**2]
+    return (C, 2. * h)
+
+def get_p4_smoother(shaper_freq, damping_ratio):
+    # Biweight kernel (1 - (t/h)^2)^2; first zero of response at
+    # 2*pi*f*h=x where x is the first positive root of
+    # tan(x) = 3*x / (3 - x^2)
+    h = 5.763459196894550 / (2. * math.pi * shaper_freq)
+    C = [1., 0., -2. / h**2, 0., 1. / h**4]
+    return (C, 2. * h)
+
+# Approximate a smoother with evenly spaced pulses (midpoint rule)
+def get_smoother_pulses(C, t_sm, num_pulses=SMOOTHER_APPROX_PULSES):
+    dt = t_sm / num_pulses
+    A = []
+    T = []
+    for i in range(num_pulses):
+        t = (i + .5) * dt
+        u = t - .5 * t_sm
+        w = 0.
+        for c in reversed(C):
+            w = w * u + c
+        A.append(w * dt)
+        T.append(t)
+    return (A, T)
+
+# Return the (A, T) pulses of a shaper or an approximation of a smoother
+def get_shaper_pulses(shaper_cfg, shaper_freq, damping_ratio):
+    if isinstance(shaper_cfg, InputSmootherCfg):
+        C, t_sm = shaper_cfg.init_func(shaper_freq, damping_ratio)
+        return get_smoother_pulses(C, t_sm)
+    return shaper_cfg.init_func(shaper_freq, damping_ratio)
+
 # min_freq for each shaper is chosen to have projected max_accel ~= 1500
 INPUT_SHAPERS = [
     InputShaperCfg(name='zv', init_func=get_zv_shaper,
@@ -119,3 +166,10 @@ INPUT_SHAPERS = [
     InputShaperCfg(name='3hump_ei', init_func=get_3hump_ei_shaper,
                    min_freq=48., max_damping_ratio=0.2),
 ]
+
+INPUT_SMOOTHERS = [
+    InputSmootherCfg(name='smooth_p2', init_func=get_p2_smoother,
+                     min_freq=26., max_damping_ratio=0.99),
+    InputSmootherCfg(name='smooth_p4', init_func=get_p4_smoother,
+                     min_freq=28., max_damping_ratio=0.99),
+]
@@ -3,7 +3,8 @@
 # Copyright (C) 2018-2024  Kevin O'Connor <kevin@koconnor.net>
 #
 # This file may be distributed under the terms of the GNU GPLv3 license.
-import os, sys, logging, io
+import os, logging, io, hashlib
+import chelper
 
 VALID_GCODE_EXTS = ['gcode', 'g', 'gco']
 
@@ -13,6 +14,94 @@ DEFAULT_ERROR_GCODE = """
 {% endif %}
 """
 
+# Read batches of lines from a file (using a background readahead thread)
+READ_BATCH_SIZE = 256 * 1024
+READ_BATCH_LINES = 4096
+MOVE_BATCH_COUNT = 32
+
+class FileReader:
+    def __init__(self, f, pos):
+        ffi_main, ffi_lib = chelper.get_ffi()
+        self.ffi_main = ffi_main
+        self.filereader_pull = ffi_lib.filereader_pull
+        self.filereader_seek = ffi_lib.filereader_seek
+        self.reader = ffi_main.gc(ffi_lib.filereader_alloc(f.fileno(), pos),
+                                  ffi_lib.filereader_free)
+        if self.reader == ffi_main.NULL:
+            raise IOError("Unable to start file reader")
+        self.pos = pos
+        self.data = ffi_main.new('char[]', READ_BATCH_SIZE)
+        self.line_ends = ffi_main.new('uint64_t[]', READ_BATCH_LINES)
+    def seek(self, pos):
+        self.filereader_seek(self.reader, pos)
+        self.pos = pos
+        return True
+    def read_lines(self):
+        # Returns a reversed list of (line, next_file_position, gnum)
+        # tuples (gnum is always -1 as lines are not pre-parsed)
+        count = self.filereader_pull(self.reader, self.data, READ_BATCH_SIZE,
+                                     self.line_ends, READ_BATCH_LINES)
+        if count < 0:
+            raise IOError("Error reading file")
+        if not count:
+            return []
+        line_ends = list(self.line_ends[0:count])
+        data = self.ffi_main.buffer(self.data, line_ends[-1] - self.pos)[:]
+        self.pos = line_ends[-1]
+        lines = [(line, pos, -1) for line, pos in zip(
+            data.decode('utf-8').split('\n'), line_ends)]
+        lines.reverse()
+        return lines
+    def close(self):
+        self.reader = None
+
+# Read batches of lines from a pre-parsed g-code cache file
+class GCodeCacheReader:
+    def __init__(self, cache_fname, f, pos):
+        ffi_main, ffi_lib = chelper.get_ffi()
+        self.ffi_main = ffi_main
+        self.reader_pull = ffi_lib.gcodecache_reader_pull
+        self.reader_seek = ffi_lib.gcodecache_reader_seek
+        cf = io.open(cache_fname, 'rb')
+        try:
+            reader = ffi_lib.gcodecache_reader_alloc(cf.fileno(), f.fileno())
+        finally:
+            cf.close()
+        if reader == ffi_main.NULL:
+            raise IOError("G-Code cache is not valid")
+        self.reader = ffi_main.gc(reader, ffi_lib.gcodecache_reader_free)
+        self.entries = ffi_main.new('struct gcodecache_entry[]',
+                                    READ_BATCH_LINES)
+        self.text = ffi_main.new('char[]', READ_BATCH_SIZE)
+        if not self.seek(pos):
+            raise IOError("Position %d not available in G-Code cache" % (pos,))
+    def seek(self, pos):
+        return self.reader_seek(self.reader, pos) == 0
+    def read_lines(self):
+        # Returns a reversed list of (line, next_file_position, gnum)
+        # tuples.  For a pre-parsed move, 'line' contains the move
+        # fields and gnum is the G-Code number (otherwise it is -1).
+        count = self.reader_pull(self.reader, self.entries, READ_BATCH_LINES,
+                                 self.text, READ_BATCH_SIZE)
+        if count < 0:
+            raise IOError("Error reading G-Code cache")
+        text = self.ffi_main.buffer(self.text)
+        entries = self.entries
+        lines = []
+        for i in range(count):
+            e = entries[i]
+            gnum = e.gnum
+            if gnum < 0:
+                start = e.text_offset
+                line = text[start:start + e.text_len].decode('utf-8')
+                lines.append((line, e.end_pos, -1))
+            else:
+                lines.append((e.fields, e.end_pos, gnum))
+        lines.reverse()
+        return lines
+    def close(self):
+        self.reader = None
+
 class VirtualSD:
     def __init__(self, config):
         self.printer = config.get_printer()
@@ -28,6 +117,14 @@ class VirtualSD:
         self.must_pause_work = self.cmd_from_sd = False
         self.next_file_position = 0
         self.work_timer = None
+        # Pre-parsed g-code cache
+        self.cache_dirname = config.get('gcode_cache_path', None)
+        if self.cache_dirname is not None:
+            self.cache_dirname = os.path.normpath(
+                os.path.expanduser(self.cache_dirname))
+        self.cache_max_size = config.getfloat(
+            'gcode_cache_max_size', 1024., above=0.) * 1024. * 1024.
+        self.cache_compile = None
         # Error handling
         gcode_macro = self.printer.load_object(config, 'gcode_macro')
         self.on_error_gcode = gcode_macro.load_template(
@@ -44,8 +141,21 @@ class VirtualSD:
         self.gcode.register_command(
             "SDCARD_PRINT_FILE", self.cmd_SDCARD_PRINT_FILE,
             desc=self.cmd_SDCARD_PRINT_FILE_help)
+        if self.cache_dirname is not None:
+            self.gcode.register_command(
+                "SDCARD_COMPILE_FILE", self.cmd_SDCARD_COMPILE_FILE,
+                desc=self.cmd_SDCARD_COMPILE_FILE_help)
         self.printer.register_event_handler("klippy:analyze_shutdown",
                                             self._handle_analyze_shutdown)
+        if self.printer.get_start_args().get("debuginput") is not None:
+            self.printer.register_event_handler("gcode:request_restart",
+                                                self._handle_batch_exit)
+    def _handle_batch_exit(self, print_time):
+        # In batch mode, complete an active print before exiting (the
+        # print is run from a timer and would otherwise be cut short
+        # at the end of the input file)
+        while self.work_timer is not None and not self.cmd_from_sd:
+            self.reactor.pause(self.reactor.monotonic() + .001)
     def _handle_analyze_shutdown(self, msg, details):
         if self.work_timer is not None:
             self.must_pause_work = True
@@ -154,7 +264,23 @@ class VirtualSD:
         if filename[0] == '/':
             filename = filename[1:]
         self._load_file(gcmd, filename, check_subdirs=True)
+        if self.cache_dirname is not None:
+            self._update_cache(self.current_file)
         self.do_resume()
+    cmd_SDCARD_COMPILE_FILE_help = "Create a pre-parsed G-Code cache for a "\
+        "file.  May include files in subdirectories."
+    def cmd_SDCARD_COMPILE_FILE(self, gcmd):
+        filename = gcmd.get("FILENAME")
+        if filename[0] == '/':
+            filename = filename[1:]
+        wait = gcmd.get_int("WAIT", 0, minval=0, maxval=1)
+        fname = self._lookup_file(gcmd, filename, check_subdirs=True)
+        if self.cache_compile is not None:
+            raise gcmd.error("G-Code cache compile already in progress")
+        self._start_compile(gcmd, fname)
+        gcmd.respond_info("Creating G-Code cache for %s" % (filename,))
+        while wait and self.cache_compile is not None:
+            self.reactor.pause(self.reactor.monotonic() + .100)
     def cmd_M20(self, gcmd):
         # List SD card
         files = self.get_file_list()
@@ -174,7 +300,7 @@ class VirtualSD:
         if filename.startswith('/'):
             filename = filename[1:]
         self._load_file(gcmd, filename)
-    def _load_file(self, gcmd, filename, check_subdirs=False):
+    def _lookup_file(self, gcmd, filename, check_subdirs=False):
         files = self.get_file_list(check_subdirs)
         flist = [f[0] for f in files]
         files_by_lower = { fname.lower(): fname for fname, fsize in files }
@@ -182,7 +308,13 @@ class VirtualSD:
         try:
             if fname not in flist:
                 fname = files_by_lower[fname.lower()]
-            fname = os.path.join(self.sdcard_dirname, fname)
+        except:
+            logging.exception("virtual_sdcard file open")
+            raise gcmd.error("Unable to open file")
+        return os.path.join(self.sdcard_dirname, fname)
+    def _load_file(self, gcmd, filename, check_subdirs=False):
+        fname = self._lookup_file(gcmd, filename, check_subdirs)
+        try:
             f = io.open(fname, 'r', newline='')
             f.seek(0, os.SEEK_END)
             fsize = f.tell()
@@ -221,40 +353,162 @@ class VirtualSD:
         self.next_file_position = pos
     def is_cmd_from_sd(self):
         return self.cmd_from_sd
+    # Pre-parsed g-code cache
+    def _get_cache_filename(self, fname):
+        fhash = hashlib.sha1(os.path.abspath(fname).encode()).hexdigest()
+        return os.path.join(self.cache_dirname, fhash + ".cache")
+    def _open_cache(self, f, pos):
+        if (self.cache_dirname is None
+            or not self.gcode.has_fast_move_command('G0')
+            or not self.gcode.has_fast_move_command('G1')):
+            return None
+        cache_fname = self._get_cache_filename(f.name)
+        try:
+            reader = GCodeCacheReader(cache_fname, f, pos)
+            # Note the use of the cache (for pruning of old cache files)
+            os.utime(cache_fname, None)
+        except (IOError, OSError) as e:
+            logging.info("Not using G-Code cache: %s", str(e))
+            return None
+        logging.info("Using G-Code cache %s", cache_fname)
+        return reader
+    def _check_cache(self, cache_fname, fname):
+        # Check if a cache file is up to date for the given g-code file
+        ffi_main, ffi_lib = chelper.get_ffi()
+        try:
+            cf = io.open(cache_fname, 'rb')
+            try:
+                f = io.open(fname, 'rb')
+                try:
+                    return ffi_lib.gcodecache_check(cf.fileno(), f.fileno())
+                finally:
+                    f.close()
+            finally:
+                cf.close()
+        except (IOError, OSError):
+            return False
+    def _prune_cache(self, keep_fname):
+        # Remove cache files that are not up to date for any sdcard file
+        valid = {}
+        for fname, fsize in self.get_file_list(check_subdirs=True):
+            fname = os.path.join(self.sdcard_dirname, fname)
+            valid[self._get_cache_filename(fname)] = fname
+        caches = []
+        for name in os.listdir(self.cache_dirname):
+            cache_fname = os.path.join(self.cache_dirname, name)
+            if not os.path.isfile(cache_fname):
+                continue
+            if cache_fname != keep_fname:
+                fname = valid.get(cache_fname)
+                if fname is None or not self._check_cache(cache_fname, fname):
+                    logging.info("Removing G-Code cache %s", cache_fname)
+                    os.unlink(cache_fname)
+                    continue
+            st = os.stat(cache_fname)
+            caches.append((st.st_mtime, st.st_size, cache_fname))
+        # Remove the least recently used files if over the size limit
+        caches.sort(reverse=True)
+        total_size = 0
+        for mtime, size, cache_fname in caches:
+            total_size += size
+            if total_size > self.cache_max_size and cache_fname != keep_fname:
+                logging.info("Removing G-Code cache %s (size limit)",
+                             cache_fname)
+                os.unlink(cache_fname)
+    def _update_cache(self, f):
+        # Start creating a cache for the file if it is not up to date
+        if self.cache_compile is not None:
+            return
+        if self._check_cache(self._get_cache_filename(f.name), f.name):
+            return
+        try:
+            self._start_compile(self.gcode, f.name)
+        except self.gcode.error as e:
+            logging.info("Not creating G-Code cache: %s", str(e))
+    def _start_compile(self, gcmd, fname):
+        ffi_main, ffi_lib = chelper.get_ffi()
+        cache_fname = self._get_cache_filename(fname)
+        tmp_fname = cache_fname + ".tmp"
+        try:
+            if not os.path.exists(self.cache_dirname):
+                os.makedirs(self.cache_dirname)
+            src = io.open(fname, 'rb')
+            try:
+                dst = io.open(tmp_fname, 'wb')
+                try:
+                    cc = ffi_lib.gcodecache_compile_alloc(src.fileno(),
+                                                          dst.fileno())
+                finally:
+                    dst.close()
+            finally:
+                src.close()
+        except:
+            logging.exception("virtual_sdcard cache create")
+            raise gcmd.error("Unable to create G-Code cache")
+        if cc == ffi_main.NULL:
+            raise gcmd.error("Unable to create G-Code cache")
+        cc = ffi_main.gc(cc, ffi_lib.gcodecache_compile_free)
+        timer = self.reactor.register_timer(
+            self._check_compile, self.reactor.monotonic() + .250)
+        self.cache_compile = (cc, timer, fname, tmp_fname, cache_fname)
+    def _check_compile(self, eventtime):
+        cc, timer, fname, tmp_fname, cache_fname = self.cache_compile
+        ffi_main, ffi_lib = chelper.get_ffi()
+        res = ffi_lib.gcodecache_compile_check(cc)
+        if not res:
+            return eventtime + .250
+        self.cache_compile = None
+        self.reactor.unregister_timer(timer)
+        try:
+            if res < 0:
+                raise IOError("compile failed")
+            os.rename(tmp_fname, cache_fname)
+        except:
+            logging.exception("virtual_sdcard cache create")
+            try:
+                os.unlink(tmp_fname)
+            except OSError:
+                pass
+            self.gcode.respond_info("Unable to create G-Code cache for %s"
+                                    % (fname,))
+            return self.reactor.NEVER
+        self.gcode.respond_info("Created G-Code cache for %s" % (fname,))
+        try:
+            self._prune_cache(cache_fname)
+        except:
+            logging.exception("virtual_sdcard cache prune")
+        return self.reactor.NEVER
     # Background work timer
     def work_handler(self, eventtime):
         logging.info("Starting SD card print (position %d)", self.file_position)
         self.reactor.unregister_timer(self.work_timer)
         try:
-            self.current_file.seek(self.file_position)
+            reader = self._open_cache(self.current_file, self.file_position)
+            if reader is None:
+                reader = FileReader(self.current_file, self.file_position)
         except:
             logging.exception("virtual_sdcard seek")
             self.work_timer = None
             return self.reactor.NEVER
         self.print_stats.note_start()
         gcode_mutex = self.gcode.get_mutex()
-        partial_input = ""
         lines = []
         error_message = None
         while not self.must_pause_work:
             if not lines:
                 # Read more data
                 try:
-                    data = self.current_file.read(8192)
+                    lines = reader.read_lines()
                 except:
                     logging.exception("virtual_sdcard read")
                     break
-                if not data:
+                if not lines:
                     # End of file
                     self.current_file.close()
                     self.current_file = None
                     logging.info("Finished SD card print")
                     self.gcode.respond_raw("Done printing file")
                     break
-                lines = data.split('\n')
-                lines[0] = partial_input + lines[0]
-                partial_input = lines.pop()
-                lines.reverse()
                 self.reactor.pause(self.reactor.NOW)
                 continue
             # Pause if any other request is pending in the gcode class
@@ -263,16 +517,29 @@ class VirtualSD:
                 continue
             # Dispatch command
             self.cmd_from_sd = True
-            line = lines.pop()
-            if sys.version_info.major >= 3:
-                next_file_position = self.file_position + len(line.encode()) + 1
-            else:
-                next_file_position = self.file_position + len(line) + 1
+            line, next_file_position, gnum = lines.pop()
+            if gnum >= 0:
+                # Group consecutive pre-parsed moves into a single batch
+                fields_list = [line]
+                move_positions = [next_file_position]
+                while (lines and lines[-1][2] == gnum
+                       and len(fields_list) < MOVE_BATCH_COUNT):
+                    line, next_file_position, gnum = lines.pop()
+                    fields_list.append(line)
+                    move_positions.append(next_file_position)
             self.next_file_position = next_file_position
             try:
-                self.gcode.run_script(line)
+                if gnum < 0:
+                    self.gcode.run_script(line)
+                else:
+                    self.gcode.run_fast_moves(gnum, fields_list)
             except self.gcode.error as e:
                 error_message = str(e)
+                if gnum >= 0:
+                    # Don't replay the moves of the batch that completed
+                    done = self.gcode.get_fast_moves_done()
+                    if done:
+                        self.file_position = move_positions[done - 1]
                 try:
                     self.gcode.run_script(self.on_error_gcode.render())
                 except:
@@ -285,14 +552,18 @@ class VirtualSD:
             self.file_position = self.next_file_position
             # Do we need to skip around?
             if self.next_file_position != next_file_position:
-                try:
-                    self.current_file.seek(self.file_position)
-                except:
-                    logging.exception("virtual_sdcard seek")
-                    self.work_timer = None
-                    return self.reactor.NEVER
                 lines = []
-                partial_input = ""
+                if not reader.seek(self.file_position):
+                    # Position not available in cache - read file instead
+                    reader.close()
+                    try:
+                        reader = FileReader(self.current_file,
+                                            self.file_position)
+                    except:
+                        logging.exception("virtual_sdcard seek")
+                        self.work_timer = None
+                        return self.reactor.NEVER
+        reader.close()
         logging.info("Exiting SD card print (position %d)", self.file_position)
         self.work_timer = None
         self.cmd_from_sd = False
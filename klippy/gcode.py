@@ -4,6 +4,7 @@
 #
 # This file may be distributed under the terms of the GNU GPLv3 license.
 import os, re, logging, collections, shlex, operator
+import chelper
 
 class CommandError(Exception):
     pass
@@ -95,6 +96,9 @@ class GCodeCommand:
         return self.get(name, default, parser=float, minval=minval,
                         maxval=maxval, above=above, below=below)
 
+# Commands that may be tokenized by the C code (indexed by G number)
+FAST_MOVE_COMMANDS = ('G0', 'G1', 'G2', 'G3')
+
 # Parse and dispatch G-Code commands
 class GCodeDispatch:
     error = CommandError
@@ -115,6 +119,13 @@ class GCodeDispatch:
         self.mux_commands = {}
         self.gcode_help = {}
         self.status_commands = {}
+        # Fast path handling of movement commands (see gcodeparse.c)
+        ffi_main, ffi_lib = chelper.get_ffi()
+        self.move_fields = ffi_main.new('struct gcode_move_fields *')
+        self.gcodeparse_move = ffi_lib.gcodeparse_move
+        self.fast_move_handlers = [None] * len(FAST_MOVE_COMMANDS)
+        self.fast_move_batch_handlers = [None] * len(FAST_MOVE_COMMANDS)
+        self.fast_moves_done = 0
         # Register commands needed before config file is loaded
         handlers = ['M110', 'M112', 'M115',
                     'RESTART', 'FIRMWARE_RESTART', 'ECHO', 'STATUS', 'HELP']
@@ -132,6 +143,10 @@ class GCodeDispatch:
             return False
     def register_command(self, cmd, func, when_not_ready=False, desc=None):
         if func is None:
+            if cmd in FAST_MOVE_COMMANDS:
+                gnum = FAST_MOVE_COMMANDS.index(cmd)
+                self.fast_move_handlers[gnum] = None
+                self.fast_move_batch_handlers[gnum] = None
             old_cmd = self.ready_gcode_handlers.get(cmd)
             if cmd in self.ready_gcode_handlers:
                 del self.ready_gcode_handlers[cmd]
@@ -155,6 +170,21 @@ class GCodeDispatch:
         if desc is not None:
             self.gcode_help[cmd] = desc
         self._build_status_commands()
+    def register_fast_move_command(self, cmd, func, batch_func=None):
+        # Register an additional handler for simple G0/G1/G2/G3 lines.
+        # The handler is invoked with the numeric fields extracted by
+        # the C tokenizer instead of a GCodeCommand.  The optional
+        # batch handler is invoked with an iterator of such fields and
+        # must fully process each move before requesting the next one
+        # (see get_fast_moves_done()).  Both are dropped if the command
+        # is later unregistered (eg, by a macro).
+        if (cmd not in FAST_MOVE_COMMANDS
+            or cmd not in self.ready_gcode_handlers):
+            raise self.printer.config_error(
+                "Can't register fast move handler for '%s'" % (cmd,))
+        gnum = FAST_MOVE_COMMANDS.index(cmd)
+        self.fast_move_handlers[gnum] = func
+        self.fast_move_batch_handlers[gnum] = batch_func
     def register_mux_command(self, cmd, key, value, func, desc=None):
         prev = self.mux_commands.get(cmd)
         if prev is None:
@@ -200,40 +230,103 @@ class GCodeDispatch:
     # Parse input into commands
     args_r = re.compile('([A-Z_]+|[A-Z*])')
     def _process_commands(self, commands, need_ack=True):
+        move_fields = self.move_fields
         for line in commands:
             # Ignore comments and leading/trailing spaces
             line = origline = line.strip()
-            cpos = line.find(';')
-            if cpos >= 0:
-                line = line[:cpos]
-            # Break line into parts and determine command
-            parts = self.args_r.split(line.upper())
-            if ''.join(parts[:2]) == 'N':
-                # Skip line number at start of command
-                cmd = ''.join(parts[3:5]).strip()
+            # Check for a simple movement command (tokenized in C)
+            fast_handler = gcmd = None
+            if self.is_printer_ready:
+                try:
+                    gnum = self.gcodeparse_move(line.encode(), move_fields)
+                except UnicodeError:
+                    gnum = -1
+                if gnum >= 0:
+                    fast_handler = self.fast_move_handlers[gnum]
+            if fast_handler is not None:
+                cmd = FAST_MOVE_COMMANDS[gnum]
             else:
-                cmd = ''.join(parts[:3]).strip()
-            # Build gcode "params" dictionary
-            params = { parts[i]: parts[i+1].strip()
-                       for i in range(1, len(parts), 2) }
-            gcmd = GCodeCommand(self, cmd, origline, params, need_ack)
+                cpos = line.find(';')
+                if cpos >= 0:
+                    line = line[:cpos]
+                # Break line into parts and determine command
+                parts = self.args_r.split(line.upper())
+                if ''.join(parts[:2]) == 'N':
+                    # Skip line number at start of command
+                    cmd = ''.join(parts[3:5]).strip()
+                else:
+                    cmd = ''.join(parts[:3]).strip()
+                # Build gcode "params" dictionary
+                params = { parts[i]: parts[i+1].strip()
+                           for i in range(1, len(parts), 2) }
+                gcmd = GCodeCommand(self, cmd, origline, params, need_ack)
             # Invoke handler for command
-            handler = self.gcode_handlers.get(cmd, self.cmd_default)
             try:
-                handler(gcmd)
+                if gcmd is None:
+                    fast_handler(move_fields, origline)
+                else:
+                    handler = self.gcode_handlers.get(cmd, self.cmd_default)
+                    handler(gcmd)
             except self.error as e:
-                self._respond_error(str(e))
-                self.printer.send_event("gcode:command_error")
+                self._handle_command_error(e)
                 if not need_ack:
                     raise
             except:
-                msg = 'Internal error on command:"%s"' % (cmd,)
-                logging.exception(msg)
-                self.printer.invoke_shutdown(msg)
-                self._respond_error(msg)
+                self._handle_internal_error(cmd)
                 if not need_ack:
                     raise
-            gcmd.ack()
+            if gcmd is None:
+                if need_ack:
+                    self.respond_raw("ok")
+            else:
+                gcmd.ack()
+    def _handle_command_error(self, e):
+        self._respond_error(str(e))
+        self.printer.send_event("gcode:command_error")
+    def _handle_internal_error(self, cmd):
+        msg = 'Internal error on command:"%s"' % (cmd,)
+        logging.exception(msg)
+        self.printer.invoke_shutdown(msg)
+        self._respond_error(msg)
+    def has_fast_move_command(self, cmd):
+        handler = self.fast_move_handlers[FAST_MOVE_COMMANDS.index(cmd)]
+        return handler is not None
+    def run_fast_moves(self, gnum, fields_list):
+        # Run a sequence of moves that were tokenized in advance (eg,
+        # pre-parsed moves from a g-code cache file).  The fast move
+        # handlers are invoked without a command line, so moves that
+        # could report a line specific error must instead be run via
+        # run_script().
+        with self.mutex:
+            handler = self.fast_move_handlers[gnum]
+            batch_handler = self.fast_move_batch_handlers[gnum]
+            self.fast_moves_done = 0
+            try:
+                if not self.is_printer_ready:
+                    raise self.error(self.printer.get_state_message()[0])
+                if handler is None:
+                    raise self.error("Unable to run pre-parsed %s move"
+                                     % (FAST_MOVE_COMMANDS[gnum],))
+                if batch_handler is not None:
+                    batch_handler(self._track_fast_moves(fields_list))
+                else:
+                    for fields in fields_list:
+                        handler(fields, None)
+                        self.fast_moves_done += 1
+            except self.error as e:
+                self._handle_command_error(e)
+                raise
+            except:
+                self._handle_internal_error(FAST_MOVE_COMMANDS[gnum])
+                raise
+    def _track_fast_moves(self, fields_list):
+        # A move is complete once the batch handler requests the next
+        for fields in fields_list:
+            yield fields
+            self.fast_moves_done += 1
+    def get_fast_moves_done(self):
+        # Number of moves completed by the last run_fast_moves() call
+        return self.fast_moves_done
     def run_script_from_command(self, script):
         self._process_commands(script.split('\n'), need_ack=False)
     def run_script(self, script):
@@ -21,6 +21,7 @@ class ExtruderStepper:
                                        ffi_lib.extruder_stepper_free)
         self.stepper.set_stepper_kinematics(self.sk_extruder)
         self.motion_queue = None
+        self.last_gen_steps_cpu_time = 0.
         # Register commands
         self.printer.register_event_handler("klippy:connect",
                                             self._handle_connect)
@@ -44,6 +45,13 @@ class ExtruderStepper:
         return {'pressure_advance': self.pressure_advance,
                 'smooth_time': self.pressure_advance_smooth_time,
                 'motion_queue': self.motion_queue}
+    def stats(self, eventtime):
+        # Report the cpu time used for step generation since the last call
+        motion_queuing = self.printer.lookup_object('motion_queuing')
+        cpu_time = motion_queuing.get_gen_steps_cpu_time(self.sk_extruder)
+        gen_time = cpu_time - self.last_gen_steps_cpu_time
+        self.last_gen_steps_cpu_time = cpu_time
+        return False, "gen_steps_cpu=%.6f" % (gen_time,)
     def find_past_position(self, print_time):
         mcu_pos = self.stepper.get_past_mcu_position(print_time)
         return self.stepper.mcu_to_commanded_position(mcu_pos)
@@ -204,7 +212,10 @@ class PrinterExtruder:
     def get_axis_gcode_id(self):
         return 'E'
     def stats(self, eventtime):
-        return self.heater.stats(eventtime)
+        is_active, msg = self.heater.stats(eventtime)
+        if self.extruder_stepper is not None:
+            msg += " " + self.extruder_stepper.stats(eventtime)[1]
+        return is_active, msg
     def check_move(self, move, ea_index):
         if not self.heater.can_extrude:
             raise self.printer.command_error(
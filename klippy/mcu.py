@@ -713,6 +713,7 @@ class MCUConnectHelper:
             if not (self._serialport.startswith("/dev/rpmsg_")
                     or self._serialport.startswith("/tmp/klipper_host_")):
                 self._baud = config.getint('baud', 250000, minval=2400)
+        self._adaptive_transmit = config.getboolean('adaptive_transmit', False)
         # Shutdown tracking
         self._emergency_stop_cmd = None
         self._is_shutdown = self._is_timeout = False
@@ -776,6 +777,8 @@ class MCUConnectHelper:
         dict_data = dfile.read()
         dfile.close()
         self._serial.connect_file(outfile, dict_data)
+        if self._adaptive_transmit:
+            self._serial.set_adaptive_transmit(True)
         self._clocksync.connect_file(self._serial)
     def _attach(self):
         self._restart_helper.check_restart_on_attach()
@@ -790,6 +793,8 @@ class MCUConnectHelper:
                 self._serial.connect_uart(self._serialport, self._baud, rts)
             else:
                 self._serial.connect_pipe(self._serialport)
+            if self._adaptive_transmit:
+                self._serial.set_adaptive_transmit(True)
             self._clocksync.connect(self._serial)
         except serialhdl.error as e:
             raise error(str(e))
@@ -1110,6 +1115,8 @@ class MCU:
     # SerialHdl wrappers
     def register_response(self, cb, msg, oid=None):
         self._serial.register_response(cb, msg, oid)
+    def get_serialqueue(self):
+        return self._serial.get_serialqueue()
     def alloc_command_queue(self):
         return self._serial.alloc_command_queue()
     # MsgParser wrappers
@@ -39,6 +39,9 @@ class PT_uint32:
     is_dynamic_string = False
     max_length = 5
     signed = False
+    native_type = 'u'
+    def native_value(self, s, v):
+        return v
     def encode(self, out, v):
         if v >= 0xc000000 or v < -0x4000000: out.append((v>>28) & 0x7f | 0x80)
         if v >= 0x180000 or v < -0x80000:    out.append((v>>21) & 0x7f | 0x80)
@@ -61,6 +64,7 @@ class PT_uint32:
 
 class PT_int32(PT_uint32):
     signed = True
+    native_type = 'i'
 class PT_uint16(PT_uint32):
     max_length = 3
 class PT_int16(PT_int32):
@@ -73,6 +77,9 @@ class PT_string:
     is_int = False
     is_dynamic_string = True
     max_length = 64
+    native_type = 's'
+    def native_value(self, s, v):
+        return self.parse(s, v)[0]
     def encode(self, out, v):
         out.append(len(v))
         out.extend(bytearray(v))
@@ -99,6 +106,7 @@ class Enumeration:
     def __init__(self, pt, enum_name, enums):
         self.pt = pt
         self.max_length = pt.max_length
+        self.native_type = pt.native_type
         self.enum_name = enum_name
         self.enums = enums
         self.reverse_enums = {v: k for k, v in enums.items()}
@@ -107,12 +115,14 @@ class Enumeration:
         if tv is None:
             raise enumeration_error(self.enum_name, v)
         self.pt.encode(out, tv)
-    def parse(self, s, pos):
-        v, pos = self.pt.parse(s, pos)
+    def native_value(self, s, v):
         tv = self.reverse_enums.get(v)
         if tv is None:
             tv = "?%d" % (v,)
-        return tv, pos
+        return tv
+    def parse(self, s, pos):
+        v, pos = self.pt.parse(s, pos)
+        return self.native_value(s, v), pos
 
 MessageTypes = {
     '%u': PT_uint32(), '%i': PT_int32(),
@@ -168,6 +178,10 @@ class MessageFormat:
         self.param_names = lookup_params(msgformat, enumerations)
         self.param_types = [t for name, t in self.param_names]
         self.name_to_type = dict(self.param_names)
+        self.native_types = ''.join([t.native_type for t in self.param_types])
+        self.native_names = [name for name, t in self.param_names]
+        self.native_fixups = [(name, t) for name, t in self.param_names
+                              if not t.is_int]
     def encode(self, params):
         out = list(self.msgid_bytes)
         for i, t in enumerate(self.param_types):
@@ -185,6 +199,11 @@ class MessageFormat:
             v, pos = t.parse(s, pos)
             out[name] = v
         return out, pos
+    def parse_native(self, s, values):
+        out = dict(zip(self.native_names, values))
+        for name, t in self.native_fixups:
+            out[name] = t.native_value(s, out[name])
+        return out
     def format_params(self, params):
         out = []
         for name, t in self.param_names:
@@ -201,6 +220,7 @@ class OutputFormat:
         self.msgformat = msgformat
         self.debugformat = convert_msg_format(msgformat)
         self.param_types = lookup_output_params(msgformat)
+        self.native_types = ''.join([t.native_type for t in self.param_types])
     def parse(self, s, pos):
         pos += len(self.msgid_bytes)
         out = []
@@ -211,6 +231,15 @@ class OutputFormat:
             out.append(v)
         outmsg = self.debugformat % tuple(out)
         return {'#msg': outmsg}, pos
+    def parse_native(self, s, values):
+        out = []
+        for t, v in zip(self.param_types, values):
+            v = t.native_value(s, v)
+            if t.is_dynamic_string:
+                v = repr(v)
+            out.append(v)
+        outmsg = self.debugformat % tuple(out)
+        return {'#msg': outmsg}
     def format_params(self, params):
         return "#output %s" % (params['#msg'],)
 
@@ -223,9 +252,37 @@ class UnknownFormat:
     def format_params(self, params):
         return "#unknown %s" % (repr(params['#msg']),)
 
+# Message parameter decoding in the C helper code (see msgblock.c).  The
+# C code fills a 'struct msgparser_record' with the raw parameter
+# values, and the message formats here convert those into a params dict.
+class NativeParser:
+    def __init__(self):
+        import chelper
+        ffi_main, ffi_lib = chelper.get_ffi()
+        self.ffi_unpack = ffi_main.unpack
+        self.cparser = ffi_main.gc(ffi_lib.msgparser_alloc(),
+                                   ffi_lib.msgparser_free)
+        self.msgparser_add_message = ffi_lib.msgparser_add_message
+        self.formats = {}
+    def get_cparser(self):
+        return self.cparser
+    def add_message(self, msgid, mid):
+        ret = self.msgparser_add_message(self.cparser, msgid,
+                                         mid.native_types.encode())
+        if not ret:
+            self.formats[msgid] = mid
+    def parse_record(self, s, rec):
+        mid = self.formats.get(rec.msgid)
+        if mid is None:
+            return None
+        values = self.ffi_unpack(rec.values, rec.param_count)
+        params = mid.parse_native(s, values)
+        params['#name'] = mid.name
+        return params
+
 class MessageParser:
     error = error
-    def __init__(self, warn_prefix=""):
+    def __init__(self, warn_prefix="", native=False):
         self.warn_prefix = warn_prefix
         self.unknown = UnknownFormat()
         self.enumerations = {}
@@ -237,6 +294,9 @@ class MessageParser:
         self.config = {}
         self.version = self.build_versions = ""
         self.raw_identify_data = ""
+        self.native_parser = None
+        if native:
+            self.native_parser = NativeParser()
         self._init_messages(DefaultMessages)
     def _error(self, msg, *params):
         raise error(self.warn_prefix + (msg % params))
@@ -281,6 +341,17 @@ class MessageParser:
         if msg is not None:
             return "%s %s" % (name, msg)
         return str(params)
+    def get_native_parser(self):
+        if self.native_parser is None:
+            return None
+        return self.native_parser.get_cparser()
+    def parse_record(self, s, rec):
+        # Parse a message using a record filled by the C msgparser code
+        if self.native_parser is not None and rec.param_count >= 0:
+            params = self.native_parser.parse_record(s, rec)
+            if params is not None:
+                return params
+        return self.parse(s)
     def parse(self, s):
         msgid, param_pos = self.msgid_parser.parse(s, MESSAGE_HEADER_SIZE)
         mid = self.messages_by_id.get(msgid, self.unknown)
@@ -383,12 +454,14 @@ class MessageParser:
             msgid_bytes = []
             self.msgid_parser.encode(msgid_bytes, msgid)
             if msgtype == 'output':
-                self.messages_by_id[msgid] = OutputFormat(msgid_bytes,
-                                                          msgformat)
+                msg = OutputFormat(msgid_bytes, msgformat)
+                self.messages_by_id[msgid] = msg
             else:
                 msg = MessageFormat(msgid_bytes, msgformat, self.enumerations)
                 self.messages_by_id[msgid] = msg
                 self.messages_by_name[msg.name] = msg
+            if self.native_parser is not None:
+                self.native_parser.add_message(msgid, msg)
     def process_identify(self, data, decompress=True):
         try:
             if decompress:
@@ -11,6 +11,9 @@ import msgproto, chelper, util
 class error(Exception):
     pass
 
+# Maximum number of received messages processed per serialqueue pull
+PULL_BATCH_SIZE = 32
+
 class SerialReader:
     def __init__(self, reactor, mcu_name=""):
         self.reactor = reactor
@@ -22,7 +25,8 @@ class SerialReader:
         self.sq_name = sq_name.encode("utf-8")
         # Serial port
         self.serial_dev = None
-        self.msgparser = msgproto.MessageParser(warn_prefix=self.warn_prefix)
+        self.msgparser = msgproto.MessageParser(warn_prefix=self.warn_prefix,
+                                                native=True)
         # C interface
         self.ffi_main, self.ffi_lib = chelper.get_ffi()
         self.serialqueue = None
@@ -41,29 +45,47 @@ class SerialReader:
     def _bg_thread(self):
         name_short = ("serialhdl %s" % (self.mcu_name))[:15]
         self.ffi_lib.set_thread_name(name_short.encode('utf-8'))
-        response = self.ffi_main.new('struct pull_queue_message *')
+        responses = self.ffi_main.new('struct pull_queue_message[%d]'
+                                      % (PULL_BATCH_SIZE,))
         while 1:
-            self.ffi_lib.serialqueue_pull(self.serialqueue, response)
-            count = response.len
+            count = self.ffi_lib.serialqueue_pull_batch(
+                self.serialqueue, responses, PULL_BATCH_SIZE)
             if count < 0:
                 break
-            if response.notify_id:
-                params = {'#sent_time': response.sent_time,
-                          '#receive_time': response.receive_time}
-                completion = self.pending_notifications.pop(response.notify_id)
+            # Parse all pulled messages before taking the handler lock
+            batch = []
+            for i in range(count):
+                response = responses[i]
+                if response.notify_id:
+                    params = {'#sent_time': response.sent_time,
+                              '#receive_time': response.receive_time}
+                    completion = self.pending_notifications.pop(
+                        response.notify_id)
+                    batch.append((completion, params))
+                    continue
+                params = self.msgparser.parse_record(
+                    response.msg[0:response.len], response.rec)
+                params['#sent_time'] = response.sent_time
+                params['#receive_time'] = response.receive_time
+                batch.append((None, params))
+            # Dispatch messages (in the order they were received)
+            completions = []
+            with self.lock:
+                handlers = self.handlers
+                for completion, params in batch:
+                    if completion is not None:
+                        completions.append((completion, params))
+                        continue
+                    hdl = (params['#name'], params.get('oid'))
+                    try:
+                        hdl = handlers.get(hdl, self.handle_default)
+                        hdl(params)
+                    except:
+                        logging.exception("%sException in serial callback",
+                                          self.warn_prefix)
+            # Notify the reactor of sent messages without holding the lock
+            for completion, params in completions:
                 self.reactor.async_complete(completion, params)
-                continue
-            params = self.msgparser.parse(response.msg[0:count])
-            params['#sent_time'] = response.sent_time
-            params['#receive_time'] = response.receive_time
-            hdl = (params['#name'], params.get('oid'))
-            try:
-                with self.lock:
-                    hdl = self.handlers.get(hdl, self.handle_default)
-                    hdl(params)
-            except:
-                logging.exception("%sException in serial callback",
-                                  self.warn_prefix)
     def _error(self, msg, *params):
         raise error(self.warn_prefix + (msg % params))
     def _get_identify_data(self, eventtime):
@@ -90,6 +112,8 @@ class SerialReader:
                                            serial_fd_type, client_id,
                                            self.sq_name),
             self.ffi_lib.serialqueue_free)
+        self.ffi_lib.serialqueue_set_msgparser(
+            self.serialqueue, self.msgparser.get_native_parser())
         self.background_thread = threading.Thread(target=self._bg_thread)
         self.background_thread.start()
         # Obtain and load the data dictionary from the firmware
@@ -99,8 +123,11 @@ class SerialReader:
             logging.info("%sTimeout on connect", self.warn_prefix)
             self.disconnect()
             return False
-        msgparser = msgproto.MessageParser(warn_prefix=self.warn_prefix)
+        msgparser = msgproto.MessageParser(warn_prefix=self.warn_prefix,
+                                           native=True)
         msgparser.process_identify(identify_data)
+        self.ffi_lib.serialqueue_set_msgparser(
+            self.serialqueue, msgparser.get_native_parser())
         self.msgparser = msgparser
         self.register_response(self.handle_unknown, '#unknown')
         # Setup baud adjust
@@ -211,6 +238,8 @@ class SerialReader:
             self.ffi_lib.serialqueue_alloc(self.serial_dev.fileno(), b'f', 0,
                                            self.sq_name),
             self.ffi_lib.serialqueue_free)
+    def set_adaptive_transmit(self, adaptive):
+        self.ffi_lib.serialqueue_set_adaptive(self.serialqueue, adaptive)
     def set_clock_est(self, freq, conv_time, conv_clock, last_clock):
         self.ffi_lib.serialqueue_set_clock_est(
             self.serialqueue, freq, conv_time, conv_clock, last_clock)
@@ -44,9 +44,10 @@ class MCU_stepper:
         self._mcu_position_offset = 0.
         self._reset_cmd_tag = self._get_position_cmd = None
         self._active_callbacks = []
-        motion_queuing = printer.load_object(config, 'motion_queuing')
+        self._motion_queuing = printer.load_object(config, 'motion_queuing')
         sname = self._name.split()[-1]
-        self._syncemitter = motion_queuing.allocate_syncemitter(mcu, sname)
+        self._syncemitter = self._motion_queuing.allocate_syncemitter(mcu,
+                                                                      sname)
         ffi_main, ffi_lib = chelper.get_ffi()
         self._stepqueue = ffi_lib.syncemitter_get_stepcompress(
             self._syncemitter)
@@ -194,6 +195,7 @@ class MCU_stepper:
         if old_sk is not None:
             mcu_pos = self.get_mcu_position()
         self._stepper_kinematics = sk
+        self._motion_queuing.setup_stepper_kinematics(sk)
         ffi_main, ffi_lib = chelper.get_ffi()
         ffi_lib.syncemitter_set_stepper_kinematics(self._syncemitter, sk);
         self.set_trapq(self._trapq)
@@ -0,0 +1,2133 @@
+
+/* DO NOT EDIT! This is an autogenerated file. See scripts/buildcommands.py. */
+
+#include "board/irq.h"
+#include "board/pgm.h"
+#include "command.h"
+#include "compiler.h"
+#include "initial_pins.h"
+
+void
+ctr_run_initfuncs(void)
+{
+    extern void alloc_init(void);
+    alloc_init();
+    extern void initial_pins_setup(void);
+    initial_pins_setup();
+    extern void timer_init(void);
+    timer_init();
+}
+
+void
+ctr_run_shutdownfuncs(void)
+{
+    extern void sendf_shutdown(void);
+    sendf_shutdown();
+    extern void move_reset(void);
+    move_reset();
+    extern void digital_out_shutdown(void);
+    digital_out_shutdown();
+    extern void stepper_shutdown(void);
+    stepper_shutdown();
+    extern void trsync_shutdown(void);
+    trsync_shutdown();
+    extern void analog_in_shutdown(void);
+    analog_in_shutdown();
+    extern void spidev_shutdown(void);
+    spidev_shutdown();
+    extern void pwm_shutdown(void);
+    pwm_shutdown();
+    extern void tmcuart_shutdown(void);
+    tmcuart_shutdown();
+    extern void st7920_shutdown(void);
+    st7920_shutdown();
+    extern void hd44780_shutdown(void);
+    hd44780_shutdown();
+    extern void pca9685_shutdown(void);
+    pca9685_shutdown();
+}
+
+void
+ctr_run_taskfuncs(void)
+{
+    irq_poll();
+    extern void trsync_task(void);
+    trsync_task();
+    irq_poll();
+    extern void analog_in_task(void);
+    analog_in_task();
+    irq_poll();
+    extern void buttons_task(void);
+    buttons_task();
+    irq_poll();
+    extern void tmcuart_task(void);
+    tmcuart_task();
+    irq_poll();
+    extern void counter_task(void);
+    counter_task();
+    irq_poll();
+    extern void thermocouple_task(void);
+    thermocouple_task();
+    irq_poll();
+    extern void adxl345_task(void);
+    adxl345_task();
+    irq_poll();
+    extern void lis2dw_task(void);
+    lis2dw_task();
+    irq_poll();
+    extern void mpu9250_task(void);
+    mpu9250_task();
+    irq_poll();
+    extern void icm20948_task(void);
+    icm20948_task();
+    irq_poll();
+    extern void hx71x_capture_task(void);
+    hx71x_capture_task();
+    irq_poll();
+    extern void ads1220_capture_task(void);
+    ads1220_capture_task();
+    irq_poll();
+    extern void ldc1612_task(void);
+    ldc1612_task();
+    irq_poll();
+    extern void spi_angle_task(void);
+    spi_angle_task();
+    irq_poll();
+    extern void console_task(void);
+    console_task();
+    irq_poll();
+    extern void watchdog_task(void);
+    watchdog_task();
+    irq_poll();
+    extern void ds18_task(void);
+    ds18_task();
+    irq_poll();
+}
+
+uint8_t __always_inline
+ctr_lookup_static_string(const char *str)
+{
+    if (__builtin_strcmp(str, "Shutdown cleared when not shutdown") == 0)
+        return 2;
+    if (__builtin_strcmp(str, "Timer too close") == 0)
+        return 3;
+    if (__builtin_strcmp(str, "sentinel timer called") == 0)
+        return 4;
+    if (__builtin_strcmp(str, "Invalid command") == 0)
+        return 5;
+    if (__builtin_strcmp(str, "Message encode error") == 0)
+        return 6;
+    if (__builtin_strcmp(str, "Command parser error") == 0)
+        return 7;
+    if (__builtin_strcmp(str, "Command request") == 0)
+        return 8;
+    if (__builtin_strcmp(str, "config_reset only available when shutdown") == 0)
+        return 9;
+    if (__builtin_strcmp(str, "oids already allocated") == 0)
+        return 10;
+    if (__builtin_strcmp(str, "Can't assign oid") == 0)
+        return 11;
+    if (__builtin_strcmp(str, "Invalid oid type") == 0)
+        return 12;
+    if (__builtin_strcmp(str, "Already finalized") == 0)
+        return 13;
+    if (__builtin_strcmp(str, "Invalid move request size") == 0)
+        return 14;
+    if (__builtin_strcmp(str, "Move queue overflow") == 0)
+        return 15;
+    if (__builtin_strcmp(str, "alloc_chunks failed") == 0)
+        return 16;
+    if (__builtin_strcmp(str, "alloc_chunk failed") == 0)
+        return 17;
+    if (__builtin_strcmp(str, "update_digital_out not valid with active queue") == 0)
+        return 18;
+    if (__builtin_strcmp(str, "Scheduled digital out event will exceed max_duration") == 0)
+        return 19;
+    if (__builtin_strcmp(str, "Can not set soft pwm cycle ticks while updates pending") == 0)
+        return 20;
+    if (__builtin_strcmp(str, "Missed scheduling of next digital out event") == 0)
+        return 21;
+    if (__builtin_strcmp(str, "Can't reset time when stepper active") == 0)
+        return 22;
+    if (__builtin_strcmp(str, "Invalid count parameter") == 0)
+        return 23;
+    if (__builtin_strcmp(str, "Stepper too far in past") == 0)
+        return 24;
+    if (__builtin_strcmp(str, "Can't add signal that is already active") == 0)
+        return 25;
+    if (__builtin_strcmp(str, "ADC out of range") == 0)
+        return 26;
+    if (__builtin_strcmp(str, "Invalid spi config") == 0)
+        return 27;
+    if (__builtin_strcmp(str, "I2C Timeout") == 0)
+        return 28;
+    if (__builtin_strcmp(str, "I2C START READ NACK") == 0)
+        return 29;
+    if (__builtin_strcmp(str, "I2C START NACK") == 0)
+        return 30;
+    if (__builtin_strcmp(str, "I2C NACK") == 0)
+        return 31;
+    if (__builtin_strcmp(str, "Scheduled pwm event will exceed max_duration") == 0)
+        return 32;
+    if (__builtin_strcmp(str, "Missed scheduling of next hard pwm event") == 0)
+        return 33;
+    if (__builtin_strcmp(str, "Invalid buttons retransmit count") == 0)
+        return 34;
+    if (__builtin_strcmp(str, "Set button past maximum button count") == 0)
+        return 35;
+    if (__builtin_strcmp(str, "Max of 8 buttons") == 0)
+        return 36;
+    if (__builtin_strcmp(str, "tmcuart data too large") == 0)
+        return 37;
+    if (__builtin_strcmp(str, "Invalid neopixel update command") == 0)
+        return 38;
+    if (__builtin_strcmp(str, "Invalid neopixel data_size") == 0)
+        return 39;
+    if (__builtin_strcmp(str, "Thermocouple reader fault") == 0)
+        return 40;
+    if (__builtin_strcmp(str, "Invalid thermocouple chip type") == 0)
+        return 41;
+    if (__builtin_strcmp(str, "model type invalid") == 0)
+        return 42;
+    if (__builtin_strcmp(str, "bus_type invalid") == 0)
+        return 43;
+    if (__builtin_strcmp(str, "bus_type i2c unsupported") == 0)
+        return 44;
+    if (__builtin_strcmp(str, "bus_type spi unsupported") == 0)
+        return 45;
+    if (__builtin_strcmp(str, "HX71x gain/channel out of range 1-4") == 0)
+        return 46;
+    if (__builtin_strcmp(str, "angle sensor requires cs pin") == 0)
+        return 47;
+    if (__builtin_strcmp(str, "Invalid spi_angle chip type") == 0)
+        return 48;
+    if (__builtin_strcmp(str, "Filter section index larger than max_sections") == 0)
+        return 49;
+    if (__builtin_strcmp(str, "sos_filter not property initialized") == 0)
+        return 50;
+    if (__builtin_strcmp(str, "fixed_mul: overflow") == 0)
+        return 51;
+    if (__builtin_strcmp(str, "grams_per_count is invalid") == 0)
+        return 52;
+    if (__builtin_strcmp(str, "trigger_grams too large") == 0)
+        return 53;
+    if (__builtin_strcmp(str, "Safety range reversed") == 0)
+        return 54;
+    if (__builtin_strcmp(str, "Rescheduled timer in the past") == 0)
+        return 55;
+    if (__builtin_strcmp(str, "Force shutdown command") == 0)
+        return 56;
+    if (__builtin_strcmp(str, "Invalid pca9685 channel or value") == 0)
+        return 57;
+    if (__builtin_strcmp(str, "Scheduled pca9685 event will exceed max_duration") == 0)
+        return 58;
+    if (__builtin_strcmp(str, "Invalid pca9685 value") == 0)
+        return 59;
+    if (__builtin_strcmp(str, "Missed scheduling of next pca9685 event") == 0)
+        return 60;
+    if (__builtin_strcmp(str, "Unable to open and init PCA9685 device") == 0)
+        return 61;
+    if (__builtin_strcmp(str, "Too many i2c devices") == 0)
+        return 62;
+    if (__builtin_strcmp(str, "All PCA9685 channels must have the same cycle_ticks") == 0)
+        return 63;
+    if (__builtin_strcmp(str, "Unable to update PCA9685 value") == 0)
+        return 64;
+    if (__builtin_strcmp(str, "Unable to write to spi") == 0)
+        return 65;
+    if (__builtin_strcmp(str, "Unable to issue spi ioctl") == 0)
+        return 66;
+    if (__builtin_strcmp(str, "Unable to set SPI mode") == 0)
+        return 67;
+    if (__builtin_strcmp(str, "Unable to set SPI speed") == 0)
+        return 68;
+    if (__builtin_strcmp(str, "Unable to set non-blocking on spi device") == 0)
+        return 69;
+    if (__builtin_strcmp(str, "Unable to open spi device") == 0)
+        return 70;
+    if (__builtin_strcmp(str, "Too many spi devices") == 0)
+        return 71;
+    if (__builtin_strcmp(str, "Error on analog read") == 0)
+        return 72;
+    if (__builtin_strcmp(str, "Unable to open adc device") == 0)
+        return 73;
+    if (__builtin_strcmp(str, "Unable to config pwm device") == 0)
+        return 74;
+    if (__builtin_strcmp(str, "Unable to open i2c device") == 0)
+        return 75;
+    if (__builtin_strcmp(str, "Unable to open in GPIO chip line") == 0)
+        return 76;
+    if (__builtin_strcmp(str, "Unable to open out GPIO chip line") == 0)
+        return 77;
+    if (__builtin_strcmp(str, "Unable to open GPIO chip device") == 0)
+        return 78;
+    if (__builtin_strcmp(str, "GPIO chip device not found") == 0)
+        return 79;
+    if (__builtin_strcmp(str, "DS18B20 sensor didn't respond in time") == 0)
+        return 80;
+    if (__builtin_strcmp(str, "DS18B20 out of range") == 0)
+        return 81;
+    if (__builtin_strcmp(str, "Error reading DS18B20 sensor") == 0)
+        return 82;
+    if (__builtin_strcmp(str, "Error getting monotonic clock time") == 0)
+        return 83;
+    if (__builtin_strcmp(str, "Could not start DS18B20 reader thread") == 0)
+        return 84;
+    if (__builtin_strcmp(str, "Could not start DS18B20 reader thread (cond init)") == 0)
+        return 85;
+    if (__builtin_strcmp(str, "Could not start DS18B20 reader thread (mutex init)") == 0)
+        return 86;
+    if (__builtin_strcmp(str, "Invalid DS18B20 serial id, could not open for reading") == 0)
+        return 87;
+    if (__builtin_strcmp(str, "Invalid DS18B20 serial id, must not contain '/'") == 0)
+        return 88;
+    return 0xff;
+}
+
+const struct initial_pin_s initial_pins[] PROGMEM = {
+};
+const int initial_pins_size PROGMEM = ARRAY_SIZE(initial_pins);
+
+static const uint8_t command_parameters0[] PROGMEM = {
+    PT_uint16 };
+static const uint8_t command_parameters1[] PROGMEM = {
+    PT_uint32, PT_uint16 };
+static const uint8_t command_parameters2[] PROGMEM = {
+    PT_uint32, PT_progmem_buffer };
+static const uint8_t command_parameters3[] PROGMEM = {
+    PT_uint32, PT_uint32, PT_uint32 };
+static const uint8_t command_parameters4[] PROGMEM = {
+    PT_uint32, PT_uint32 };
+static const uint8_t command_parameters5[] PROGMEM = {
+    PT_uint32 };
+static const uint8_t command_parameters6[] PROGMEM = {
+    PT_byte, PT_uint32, PT_byte, PT_uint16 };
+static const uint8_t command_parameters7[] PROGMEM = {
+    PT_buffer };
+static const uint8_t command_parameters8[] PROGMEM = {
+    PT_byte, PT_int32 };
+static const uint8_t command_parameters9[] PROGMEM = {
+    PT_byte, PT_byte, PT_uint32, PT_byte };
+static const uint8_t command_parameters10[] PROGMEM = {
+    PT_byte, PT_byte, PT_byte, PT_uint32 };
+static const uint8_t command_parameters11[] PROGMEM = {
+    PT_byte, PT_uint32, PT_uint16 };
+static const uint8_t command_parameters12[] PROGMEM = {
+    PT_byte, PT_buffer };
+static const uint8_t command_parameters13[] PROGMEM = {
+    PT_byte, PT_byte, PT_buffer };
+static const uint8_t command_parameters14[] PROGMEM = {
+    PT_byte, PT_byte };
+static const uint8_t command_parameters15[] PROGMEM = {
+    PT_byte, PT_uint32, PT_uint32, PT_uint32 };
+static const uint8_t command_parameters16[] PROGMEM = {
+    PT_byte, PT_uint32, PT_uint32, PT_byte };
+static const uint8_t command_parameters17[] PROGMEM = {
+    PT_byte, PT_byte, PT_uint32 };
+static const uint8_t command_parameters18[] PROGMEM = {
+    PT_byte, PT_uint32, PT_buffer };
+static const uint8_t command_parameters19[] PROGMEM = {
+    PT_byte, PT_uint32, PT_uint32, PT_uint16, PT_uint32, PT_uint16 };
+static const uint8_t command_parameters20[] PROGMEM = {
+    PT_byte, PT_uint16, PT_buffer };
+static const uint8_t command_parameters21[] PROGMEM = {
+    PT_byte, PT_uint32, PT_int32, PT_uint32 };
+static const uint8_t command_parameters22[] PROGMEM = {
+    PT_uint32, PT_byte };
+static const uint8_t command_parameters23[] PROGMEM = {
+    PT_byte };
+static const uint8_t command_parameters24[] PROGMEM = {
+    PT_byte, PT_uint32, PT_uint32 };
+static const uint8_t command_parameters25[] PROGMEM = {
+    PT_byte, PT_uint32 };
+static const uint8_t command_parameters26[] PROGMEM = {
+    PT_byte, PT_uint32, PT_byte, PT_byte, PT_uint32 };
+static const uint8_t command_parameters27[] PROGMEM = {
+    PT_byte, PT_uint32, PT_uint16, PT_int16 };
+static const uint8_t command_parameters28[] PROGMEM = {
+    PT_byte, PT_byte, PT_byte, PT_byte, PT_uint32 };
+static const uint8_t command_parameters29[] PROGMEM = {
+    PT_byte, PT_uint32, PT_uint32, PT_byte, PT_uint32, PT_byte, PT_byte, PT_byte };
+static const uint8_t command_parameters30[] PROGMEM = {
+    PT_byte, PT_byte, PT_byte };
+static const uint8_t command_parameters31[] PROGMEM = {
+    PT_byte, PT_uint32, PT_uint32, PT_byte, PT_uint32, PT_uint16, PT_uint16, PT_byte };
+static const uint8_t command_parameters32[] PROGMEM = {
+    PT_byte, PT_uint32, PT_byte };
+static const uint8_t command_parameters33[] PROGMEM = {
+    PT_byte, PT_buffer, PT_uint32 };
+static const uint8_t command_parameters34[] PROGMEM = {
+    PT_uint32, PT_uint32, PT_uint16 };
+static const uint8_t command_parameters35[] PROGMEM = {
+    PT_byte, PT_uint32, PT_uint32, PT_uint16, PT_uint16, PT_uint32 };
+static const uint8_t command_parameters36[] PROGMEM = {
+    PT_byte, PT_uint32, PT_uint32, PT_byte, PT_byte };
+static const uint8_t command_parameters37[] PROGMEM = {
+    PT_byte, PT_buffer, PT_byte };
+static const uint8_t command_parameters38[] PROGMEM = {
+    PT_byte, PT_uint32, PT_byte, PT_uint32, PT_uint32 };
+static const uint8_t command_parameters39[] PROGMEM = {
+    PT_byte, PT_uint32, PT_uint16, PT_uint32, PT_uint32 };
+static const uint8_t command_parameters40[] PROGMEM = {
+    PT_byte, PT_uint32, PT_uint32, PT_uint32, PT_uint32, PT_uint32 };
+static const uint8_t command_parameters41[] PROGMEM = {
+    PT_byte, PT_uint32, PT_uint32, PT_uint32, PT_uint32, PT_uint32, PT_uint32, PT_uint32 };
+static const uint8_t command_parameters42[] PROGMEM = {
+    PT_byte, PT_uint32, PT_uint32, PT_uint32, PT_uint32 };
+static const uint8_t command_parameters43[] PROGMEM = {
+    PT_byte, PT_uint32, PT_uint32, PT_uint32, PT_uint32, PT_byte };
+static const uint8_t command_parameters44[] PROGMEM = {
+    PT_byte, PT_byte, PT_byte, PT_byte };
+static const uint8_t command_parameters45[] PROGMEM = {
+    PT_byte, PT_byte, PT_uint32, PT_uint32 };
+static const uint8_t command_parameters46[] PROGMEM = {
+    PT_byte, PT_uint32, PT_uint32, PT_byte, PT_byte, PT_byte };
+static const uint8_t command_parameters47[] PROGMEM = {
+    PT_byte, PT_byte, PT_int32, PT_int32 };
+static const uint8_t command_parameters48[] PROGMEM = {
+    PT_byte, PT_byte, PT_int32, PT_int32, PT_int32, PT_int32, PT_int32 };
+static const uint8_t command_parameters49[] PROGMEM = {
+    PT_byte, PT_byte, PT_byte, PT_byte, PT_uint32, PT_uint32, PT_uint32 };
+static const uint8_t command_parameters50[] PROGMEM = {
+    PT_byte, PT_int32, PT_int32, PT_int32, PT_uint32, PT_int32 };
+static const uint8_t command_parameters51[] PROGMEM = {
+    PT_byte, PT_byte, PT_byte, PT_uint32, PT_uint16 };
+static const uint8_t command_parameters52[] PROGMEM = {
+    PT_byte, PT_byte, PT_byte, PT_byte, PT_uint32, PT_uint16, PT_uint16, PT_uint32 };
+static const uint8_t command_parameters53[] PROGMEM = {
+    PT_byte, PT_uint32, PT_uint32, PT_int32, PT_int32 };
+
+const struct command_encoder command_encoder_110 PROGMEM = {    
+    // starting
+    .encoded_msgid=110, // msgid=-18
+    .num_params=0,
+    .param_types = 0,
+    .max_size=6,
+};
+const struct command_encoder command_encoder_111 PROGMEM = {    
+    // is_shutdown static_string_id=%hu
+    .encoded_msgid=111, // msgid=-17
+    .num_params=1,
+    .param_types = command_parameters0,
+    .max_size=9,
+};
+const struct command_encoder command_encoder_112 PROGMEM = {    
+    // shutdown clock=%u static_string_id=%hu
+    .encoded_msgid=112, // msgid=-16
+    .num_params=2,
+    .param_types = command_parameters1,
+    .max_size=14,
+};
+const struct command_encoder command_encoder_0 PROGMEM = {    
+    // identify_response offset=%u data=%.*s
+    .encoded_msgid=0, // msgid=0
+    .num_params=2,
+    .param_types = command_parameters2,
+    .max_size=64,
+};
+const struct command_encoder command_encoder_113 PROGMEM = {    
+    // stats count=%u sum=%u sumsq=%u
+    .encoded_msgid=113, // msgid=-15
+    .num_params=3,
+    .param_types = command_parameters3,
+    .max_size=21,
+};
+const struct command_encoder command_encoder_114 PROGMEM = {    
+    // uptime high=%u clock=%u
+    .encoded_msgid=114, // msgid=-14
+    .num_params=2,
+    .param_types = command_parameters4,
+    .max_size=16,
+};
+const struct command_encoder command_encoder_115 PROGMEM = {    
+    // clock clock=%u
+    .encoded_msgid=115, // msgid=-13
+    .num_params=1,
+    .param_types = command_parameters5,
+    .max_size=11,
+};
+const struct command_encoder command_encoder_116 PROGMEM = {    
+    // config is_config=%c crc=%u is_shutdown=%c move_count=%hu
+    .encoded_msgid=116, // msgid=-12
+    .num_params=4,
+    .param_types = command_parameters6,
+    .max_size=18,
+};
+const struct command_encoder command_encoder_117 PROGMEM = {    
+    // pong data=%*s
+    .encoded_msgid=117, // msgid=-11
+    .num_params=1,
+    .param_types = command_parameters7,
+    .max_size=64,
+};
+const struct command_encoder command_encoder_118 PROGMEM = {    
+    // debug_result val=%u
+    .encoded_msgid=118, // msgid=-10
+    .num_params=1,
+    .param_types = command_parameters5,
+    .max_size=11,
+};
+const struct command_encoder command_encoder_119 PROGMEM = {    
+    // stepper_position oid=%c pos=%i
+    .encoded_msgid=119, // msgid=-9
+    .num_params=2,
+    .param_types = command_parameters8,
+    .max_size=13,
+};
+const struct command_encoder command_encoder_120 PROGMEM = {    
+    // endstop_state oid=%c homing=%c next_clock=%u pin_value=%c
+    .encoded_msgid=120, // msgid=-8
+    .num_params=4,
+    .param_types = command_parameters9,
+    .max_size=17,
+};
+const struct command_encoder command_encoder_121 PROGMEM = {    
+    // trsync_state oid=%c can_trigger=%c trigger_reason=%c clock=%u
+    .encoded_msgid=121, // msgid=-7
+    .num_params=4,
+    .param_types = command_parameters10,
+    .max_size=17,
+};
+const struct command_encoder command_encoder_122 PROGMEM = {    
+    // analog_in_state oid=%c next_clock=%u value=%hu
+    .encoded_msgid=122, // msgid=-6
+    .num_params=3,
+    .param_types = command_parameters11,
+    .max_size=16,
+};
+const struct command_encoder command_encoder_123 PROGMEM = {    
+    // spi_transfer_response oid=%c response=%*s
+    .encoded_msgid=123, // msgid=-5
+    .num_params=2,
+    .param_types = command_parameters12,
+    .max_size=64,
+};
+const struct command_encoder command_encoder_124 PROGMEM = {    
+    // i2c_read_response oid=%c response=%*s
+    .encoded_msgid=124, // msgid=-4
+    .num_params=2,
+    .param_types = command_parameters12,
+    .max_size=64,
+};
+const struct command_encoder command_encoder_125 PROGMEM = {    
+    // buttons_state oid=%c ack_count=%c state=%*s
+    .encoded_msgid=125, // msgid=-3
+    .num_params=3,
+    .param_types = command_parameters13,
+    .max_size=64,
+};
+const struct command_encoder command_encoder_126 PROGMEM = {    
+    // tmcuart_response oid=%c read=%*s
+    .encoded_msgid=126, // msgid=-2
+    .num_params=2,
+    .param_types = command_parameters12,
+    .max_size=64,
+};
+const struct command_encoder command_encoder_127 PROGMEM = {    
+    // neopixel_result oid=%c success=%c
+    .encoded_msgid=127, // msgid=-1
+    .num_params=2,
+    .param_types = command_parameters14,
+    .max_size=10,
+};
+const struct command_encoder command_encoder_128 PROGMEM = {    
+    // counter_state oid=%c next_clock=%u count=%u count_clock=%u
+    .encoded_msgid=128, // msgid=128
+    .num_params=4,
+    .param_types = command_parameters15,
+    .max_size=24,
+};
+const struct command_encoder command_encoder_129 PROGMEM = {    
+    // thermocouple_result oid=%c next_clock=%u value=%u fault=%c
+    .encoded_msgid=129, // msgid=129
+    .num_params=4,
+    .param_types = command_parameters16,
+    .max_size=21,
+};
+const struct command_encoder command_encoder_130 PROGMEM = {    
+    // ldc1612_home_state oid=%c homing=%c trigger_clock=%u
+    .encoded_msgid=130, // msgid=130
+    .num_params=3,
+    .param_types = command_parameters17,
+    .max_size=16,
+};
+const struct command_encoder command_encoder_131 PROGMEM = {    
+    // spi_angle_transfer_response oid=%c clock=%u response=%*s
+    .encoded_msgid=131, // msgid=131
+    .num_params=3,
+    .param_types = command_parameters18,
+    .max_size=64,
+};
+const struct command_encoder command_encoder_132 PROGMEM = {    
+    // sensor_bulk_status oid=%c clock=%u query_ticks=%u next_sequence=%hu buffered=%u possible_overflows=%hu
+    .encoded_msgid=132, // msgid=132
+    .num_params=6,
+    .param_types = command_parameters19,
+    .max_size=30,
+};
+const struct command_encoder command_encoder_133 PROGMEM = {    
+    // sensor_bulk_data oid=%c sequence=%hu data=%*s
+    .encoded_msgid=133, // msgid=133
+    .num_params=3,
+    .param_types = command_parameters20,
+    .max_size=64,
+};
+const struct command_encoder command_encoder_134 PROGMEM = {    
+    // load_cell_probe_state oid=%c is_homing_trigger=%c trigger_ticks=%u
+    .encoded_msgid=134, // msgid=134
+    .num_params=3,
+    .param_types = command_parameters17,
+    .max_size=16,
+};
+const struct command_encoder command_encoder_135 PROGMEM = {    
+    // ds18b20_result oid=%c next_clock=%u value=%i fault=%u
+    .encoded_msgid=135, // msgid=135
+    .num_params=4,
+    .param_types = command_parameters21,
+    .max_size=24,
+};
+
+const __always_inline struct command_encoder *
+ctr_lookup_encoder(const char *str)
+{
+    if (__builtin_strcmp(str, "starting") == 0)
+        return &command_encoder_110;
+    if (__builtin_strcmp(str, "is_shutdown static_string_id=%hu") == 0)
+        return &command_encoder_111;
+    if (__builtin_strcmp(str, "shutdown clock=%u static_string_id=%hu") == 0)
+        return &command_encoder_112;
+    if (__builtin_strcmp(str, "identify_response offset=%u data=%.*s") == 0)
+        return &command_encoder_0;
+    if (__builtin_strcmp(str, "stats count=%u sum=%u sumsq=%u") == 0)
+        return &command_encoder_113;
+    if (__builtin_strcmp(str, "uptime high=%u clock=%u") == 0)
+        return &command_encoder_114;
+    if (__builtin_strcmp(str, "clock clock=%u") == 0)
+        return &command_encoder_115;
+    if (__builtin_strcmp(str, "config is_config=%c crc=%u is_shutdown=%c move_count=%hu") == 0)
+        return &command_encoder_116;
+    if (__builtin_strcmp(str, "pong data=%*s") == 0)
+        return &command_encoder_117;
+    if (__builtin_strcmp(str, "debug_result val=%u") == 0)
+        return &command_encoder_118;
+    if (__builtin_strcmp(str, "stepper_position oid=%c pos=%i") == 0)
+        return &command_encoder_119;
+    if (__builtin_strcmp(str, "endstop_state oid=%c homing=%c next_clock=%u pin_value=%c") == 0)
+        return &command_encoder_120;
+    if (__builtin_strcmp(str, "trsync_state oid=%c can_trigger=%c trigger_reason=%c clock=%u") == 0)
+        return &command_encoder_121;
+    if (__builtin_strcmp(str, "analog_in_state oid=%c next_clock=%u value=%hu") == 0)
+        return &command_encoder_122;
+    if (__builtin_strcmp(str, "spi_transfer_response oid=%c response=%*s") == 0)
+        return &command_encoder_123;
+    if (__builtin_strcmp(str, "i2c_read_response oid=%c response=%*s") == 0)
+        return &command_encoder_124;
+    if (__builtin_strcmp(str, "buttons_state oid=%c ack_count=%c state=%*s") == 0)
+        return &command_encoder_125;
+    if (__builtin_strcmp(str, "tmcuart_response oid=%c read=%*s") == 0)
+        return &command_encoder_126;
+    if (__builtin_strcmp(str, "neopixel_result oid=%c success=%c") == 0)
+        return &command_encoder_127;
+    if (__builtin_strcmp(str, "counter_state oid=%c next_clock=%u count=%u count_clock=%u") == 0)
+        return &command_encoder_128;
+    if (__builtin_strcmp(str, "thermocouple_result oid=%c next_clock=%u value=%u fault=%c") == 0)
+        return &command_encoder_129;
+    if (__builtin_strcmp(str, "ldc1612_home_state oid=%c homing=%c trigger_clock=%u") == 0)
+        return &command_encoder_130;
+    if (__builtin_strcmp(str, "spi_angle_transfer_response oid=%c clock=%u response=%*s") == 0)
+        return &command_encoder_131;
+    if (__builtin_strcmp(str, "sensor_bulk_status oid=%c clock=%u query_ticks=%u next_sequence=%hu buffered=%u possible_overflows=%hu") == 0)
+        return &command_encoder_132;
+    if (__builtin_strcmp(str, "sensor_bulk_data oid=%c sequence=%hu data=%*s") == 0)
+        return &command_encoder_133;
+    if (__builtin_strcmp(str, "load_cell_probe_state oid=%c is_homing_trigger=%c trigger_ticks=%u") == 0)
+        return &command_encoder_134;
+    if (__builtin_strcmp(str, "ds18b20_result oid=%c next_clock=%u value=%i fault=%u") == 0)
+        return &command_encoder_135;
+    return NULL;
+}
+
+const __always_inline struct command_encoder *
+ctr_lookup_output(const char *str)
+{
+    
+    return NULL;
+}
+
+extern void ads1220_attach_load_cell_probe(uint32_t*);
+extern void command_allocate_oids(uint32_t*);
+extern void command_buttons_ack(uint32_t*);
+extern void command_buttons_add(uint32_t*);
+extern void command_buttons_query(uint32_t*);
+extern void command_clear_shutdown(uint32_t*);
+extern void command_config_ads1220(uint32_t*);
+extern void command_config_adxl345(uint32_t*);
+extern void command_config_analog_in(uint32_t*);
+extern void command_config_buttons(uint32_t*);
+extern void command_config_counter(uint32_t*);
+extern void command_config_digital_out(uint32_t*);
+extern void command_config_ds18b20(uint32_t*);
+extern void command_config_endstop(uint32_t*);
+extern void command_config_hd44780(uint32_t*);
+extern void command_config_hx71x(uint32_t*);
+extern void command_config_i2c(uint32_t*);
+extern void command_config_icm20948(uint32_t*);
+extern void command_config_ldc1612(uint32_t*);
+extern void command_config_ldc1612_with_intb(uint32_t*);
+extern void command_config_lis2dw(uint32_t*);
+extern void command_config_load_cell_probe(uint32_t*);
+extern void command_config_mpu9250(uint32_t*);
+extern void command_config_neopixel(uint32_t*);
+extern void command_config_pca9685(uint32_t*);
+extern void command_config_pwm_out(uint32_t*);
+extern void command_config_reset(uint32_t*);
+extern void command_config_sos_filter(uint32_t*);
+extern void command_config_spi(uint32_t*);
+extern void command_config_spi_angle(uint32_t*);
+extern void command_config_spi_shutdown(uint32_t*);
+extern void command_config_spi_without_cs(uint32_t*);
+extern void command_config_st7920(uint32_t*);
+extern void command_config_stepper(uint32_t*);
+extern void command_config_thermocouple(uint32_t*);
+extern void command_config_tmcuart(uint32_t*);
+extern void command_config_trsync(uint32_t*);
+extern void command_debug_nop(uint32_t*);
+extern void command_debug_ping(uint32_t*);
+extern void command_debug_read(uint32_t*);
+extern void command_debug_write(uint32_t*);
+extern void command_emergency_stop(uint32_t*);
+extern void command_endstop_home(uint32_t*);
+extern void command_endstop_query_state(uint32_t*);
+extern void command_finalize_config(uint32_t*);
+extern void command_get_clock(uint32_t*);
+extern void command_get_config(uint32_t*);
+extern void command_get_uptime(uint32_t*);
+extern void command_hd44780_send_cmds(uint32_t*);
+extern void command_hd44780_send_data(uint32_t*);
+extern void command_i2c_read(uint32_t*);
+extern void command_i2c_set_bus(uint32_t*);
+extern void command_i2c_set_sw_bus(uint32_t*);
+extern void command_i2c_write(uint32_t*);
+extern void command_identify(uint32_t*);
+extern void command_ldc1612_setup_home(uint32_t*);
+extern void command_load_cell_probe_home(uint32_t*);
+extern void command_load_cell_probe_query_state(uint32_t*);
+extern void command_load_cell_probe_set_range(uint32_t*);
+extern void command_neopixel_send(uint32_t*);
+extern void command_neopixel_update(uint32_t*);
+extern void command_query_ads1220(uint32_t*);
+extern void command_query_ads1220_status(uint32_t*);
+extern void command_query_adxl345(uint32_t*);
+extern void command_query_adxl345_status(uint32_t*);
+extern void command_query_analog_in(uint32_t*);
+extern void command_query_counter(uint32_t*);
+extern void command_query_ds18b20(uint32_t*);
+extern void command_query_hx71x(uint32_t*);
+extern void command_query_hx71x_status(uint32_t*);
+extern void command_query_icm20948(uint32_t*);
+extern void command_query_icm20948_status(uint32_t*);
+extern void command_query_ldc1612(uint32_t*);
+extern void command_query_ldc1612_home_state(uint32_t*);
+extern void command_query_lis2dw(uint32_t*);
+extern void command_query_lis2dw_status(uint32_t*);
+extern void command_query_mpu9250(uint32_t*);
+extern void command_query_mpu9250_status(uint32_t*);
+extern void command_query_spi_angle(uint32_t*);
+extern void command_query_status_ldc1612(uint32_t*);
+extern void command_query_thermocouple(uint32_t*);
+extern void command_queue_digital_out(uint32_t*);
+extern void command_queue_pca9685_out(uint32_t*);
+extern void command_queue_pwm_out(uint32_t*);
+extern void command_queue_step(uint32_t*);
+extern void command_reset_step_clock(uint32_t*);
+extern void command_set_digital_out(uint32_t*);
+extern void command_set_digital_out_pwm_cycle(uint32_t*);
+extern void command_set_next_step_dir(uint32_t*);
+extern void command_set_pca9685_out(uint32_t*);
+extern void command_set_pwm_out(uint32_t*);
+extern void command_sos_filter_activate(uint32_t*);
+extern void command_sos_filter_set_section(uint32_t*);
+extern void command_sos_filter_set_state(uint32_t*);
+extern void command_spi_angle_transfer(uint32_t*);
+extern void command_spi_send(uint32_t*);
+extern void command_spi_set_bus(uint32_t*);
+extern void command_spi_set_sw_bus(uint32_t*);
+extern void command_spi_transfer(uint32_t*);
+extern void command_st7920_send_cmds(uint32_t*);
+extern void command_st7920_send_data(uint32_t*);
+extern void command_stepper_get_position(uint32_t*);
+extern void command_stepper_stop_on_trigger(uint32_t*);
+extern void command_tmcuart_send(uint32_t*);
+extern void command_trsync_set_timeout(uint32_t*);
+extern void command_trsync_start(uint32_t*);
+extern void command_trsync_trigger(uint32_t*);
+extern void command_update_digital_out(uint32_t*);
+extern void hx71x_attach_load_cell_probe(uint32_t*);
+
+const struct command_parser command_index[] PROGMEM = {
+{
+}, {
+    // identify offset=%u count=%c
+    .encoded_msgid=1, // msgid=1
+    .num_params=2,
+    .param_types = command_parameters22,
+    .num_args=2,
+    .flags=0x01,
+    .func=command_identify
+}, {
+    // clear_shutdown
+    .encoded_msgid=2, // msgid=2
+    .num_params=0,
+    .param_types = 0,
+    .num_args=0,
+    .flags=0x01,
+    .func=command_clear_shutdown
+}, {
+    // emergency_stop
+    .encoded_msgid=3, // msgid=3
+    .num_params=0,
+    .param_types = 0,
+    .num_args=0,
+    .flags=0x01,
+    .func=command_emergency_stop
+}, {
+    // get_uptime
+    .encoded_msgid=4, // msgid=4
+    .num_params=0,
+    .param_types = 0,
+    .num_args=0,
+    .flags=0x01,
+    .func=command_get_uptime
+}, {
+    // get_clock
+    .encoded_msgid=5, // msgid=5
+    .num_params=0,
+    .param_types = 0,
+    .num_args=0,
+    .flags=0x01,
+    .func=command_get_clock
+}, {
+    // finalize_config crc=%u
+    .encoded_msgid=6, // msgid=6
+    .num_params=1,
+    .param_types = command_parameters5,
+    .num_args=1,
+    .flags=0,
+    .func=command_finalize_config
+}, {
+    // get_config
+    .encoded_msgid=7, // msgid=7
+    .num_params=0,
+    .param_types = 0,
+    .num_args=0,
+    .flags=0x01,
+    .func=command_get_config
+}, {
+    // allocate_oids count=%c
+    .encoded_msgid=8, // msgid=8
+    .num_params=1,
+    .param_types = command_parameters23,
+    .num_args=1,
+    .flags=0,
+    .func=command_allocate_oids
+}, {
+    // debug_nop
+    .encoded_msgid=9, // msgid=9
+    .num_params=0,
+    .param_types = 0,
+    .num_args=0,
+    .flags=0x01,
+    .func=command_debug_nop
+}, {
+    // debug_ping data=%*s
+    .encoded_msgid=10, // msgid=10
+    .num_params=1,
+    .param_types = command_parameters7,
+    .num_args=2,
+    .flags=0x01,
+    .func=command_debug_ping
+}, {
+    // debug_write order=%c addr=%u val=%u
+    .encoded_msgid=11, // msgid=11
+    .num_params=3,
+    .param_types = command_parameters24,
+    .num_args=3,
+    .flags=0x01,
+    .func=command_debug_write
+}, {
+    // debug_read order=%c addr=%u
+    .encoded_msgid=12, // msgid=12
+    .num_params=2,
+    .param_types = command_parameters25,
+    .num_args=2,
+    .flags=0x01,
+    .func=command_debug_read
+}, {
+    // set_digital_out pin=%u value=%c
+    .encoded_msgid=13, // msgid=13
+    .num_params=2,
+    .param_types = command_parameters22,
+    .num_args=2,
+    .flags=0,
+    .func=command_set_digital_out
+}, {
+    // update_digital_out oid=%c value=%c
+    .encoded_msgid=14, // msgid=14
+    .num_params=2,
+    .param_types = command_parameters14,
+    .num_args=2,
+    .flags=0,
+    .func=command_update_digital_out
+}, {
+    // queue_digital_out oid=%c clock=%u on_ticks=%u
+    .encoded_msgid=15, // msgid=15
+    .num_params=3,
+    .param_types = command_parameters24,
+    .num_args=3,
+    .flags=0,
+    .func=command_queue_digital_out
+}, {
+    // set_digital_out_pwm_cycle oid=%c cycle_ticks=%u
+    .encoded_msgid=16, // msgid=16
+    .num_params=2,
+    .param_types = command_parameters25,
+    .num_args=2,
+    .flags=0,
+    .func=command_set_digital_out_pwm_cycle
+}, {
+    // config_digital_out oid=%c pin=%u value=%c default_value=%c max_duration=%u
+    .encoded_msgid=17, // msgid=17
+    .num_params=5,
+    .param_types = command_parameters26,
+    .num_args=5,
+    .flags=0,
+    .func=command_config_digital_out
+}, {
+    // stepper_stop_on_trigger oid=%c trsync_oid=%c
+    .encoded_msgid=18, // msgid=18
+    .num_params=2,
+    .param_types = command_parameters14,
+    .num_args=2,
+    .flags=0,
+    .func=command_stepper_stop_on_trigger
+}, {
+    // stepper_get_position oid=%c
+    .encoded_msgid=19, // msgid=19
+    .num_params=1,
+    .param_types = command_parameters23,
+    .num_args=1,
+    .flags=0,
+    .func=command_stepper_get_position
+}, {
+    // reset_step_clock oid=%c clock=%u
+    .encoded_msgid=20, // msgid=20
+    .num_params=2,
+    .param_types = command_parameters25,
+    .num_args=2,
+    .flags=0,
+    .func=command_reset_step_clock
+}, {
+    // set_next_step_dir oid=%c dir=%c
+    .encoded_msgid=21, // msgid=21
+    .num_params=2,
+    .param_types = command_parameters14,
+    .num_args=2,
+    .flags=0,
+    .func=command_set_next_step_dir
+}, {
+    // queue_step oid=%c interval=%u count=%hu add=%hi
+    .encoded_msgid=22, // msgid=22
+    .num_params=4,
+    .param_types = command_parameters27,
+    .num_args=4,
+    .flags=0,
+    .func=command_queue_step
+}, {
+    // config_stepper oid=%c step_pin=%c dir_pin=%c invert_step=%c step_pulse_ticks=%u
+    .encoded_msgid=23, // msgid=23
+    .num_params=5,
+    .param_types = command_parameters28,
+    .num_args=5,
+    .flags=0,
+    .func=command_config_stepper
+}, {
+    // endstop_query_state oid=%c
+    .encoded_msgid=24, // msgid=24
+    .num_params=1,
+    .param_types = command_parameters23,
+    .num_args=1,
+    .flags=0,
+    .func=command_endstop_query_state
+}, {
+    // endstop_home oid=%c clock=%u sample_ticks=%u sample_count=%c rest_ticks=%u pin_value=%c trsync_oid=%c trigger_reason=%c
+    .encoded_msgid=25, // msgid=25
+    .num_params=8,
+    .param_types = command_parameters29,
+    .num_args=8,
+    .flags=0,
+    .func=command_endstop_home
+}, {
+    // config_endstop oid=%c pin=%c pull_up=%c
+    .encoded_msgid=26, // msgid=26
+    .num_params=3,
+    .param_types = command_parameters30,
+    .num_args=3,
+    .flags=0,
+    .func=command_config_endstop
+}, {
+    // trsync_trigger oid=%c reason=%c
+    .encoded_msgid=27, // msgid=27
+    .num_params=2,
+    .param_types = command_parameters14,
+    .num_args=2,
+    .flags=0,
+    .func=command_trsync_trigger
+}, {
+    // trsync_set_timeout oid=%c clock=%u
+    .encoded_msgid=28, // msgid=28
+    .num_params=2,
+    .param_types = command_parameters25,
+    .num_args=2,
+    .flags=0,
+    .func=command_trsync_set_timeout
+}, {
+    // trsync_start oid=%c report_clock=%u report_ticks=%u expire_reason=%c
+    .encoded_msgid=29, // msgid=29
+    .num_params=4,
+    .param_types = command_parameters16,
+    .num_args=4,
+    .flags=0,
+    .func=command_trsync_start
+}, {
+    // config_trsync oid=%c
+    .encoded_msgid=30, // msgid=30
+    .num_params=1,
+    .param_types = command_parameters23,
+    .num_args=1,
+    .flags=0,
+    .func=command_config_trsync
+}, {
+    // query_analog_in oid=%c clock=%u sample_ticks=%u sample_count=%c rest_ticks=%u min_value=%hu max_value=%hu range_check_count=%c
+    .encoded_msgid=31, // msgid=31
+    .num_params=8,
+    .param_types = command_parameters31,
+    .num_args=8,
+    .flags=0,
+    .func=command_query_analog_in
+}, {
+    // config_analog_in oid=%c pin=%u
+    .encoded_msgid=32, // msgid=32
+    .num_params=2,
+    .param_types = command_parameters25,
+    .num_args=2,
+    .flags=0,
+    .func=command_config_analog_in
+}, {
+    // config_spi_shutdown oid=%c spi_oid=%c shutdown_msg=%*s
+    .encoded_msgid=33, // msgid=33
+    .num_params=3,
+    .param_types = command_parameters13,
+    .num_args=4,
+    .flags=0,
+    .func=command_config_spi_shutdown
+}, {
+    // spi_send oid=%c data=%*s
+    .encoded_msgid=34, // msgid=34
+    .num_params=2,
+    .param_types = command_parameters12,
+    .num_args=3,
+    .flags=0,
+    .func=command_spi_send
+}, {
+    // spi_transfer oid=%c data=%*s
+    .encoded_msgid=35, // msgid=35
+    .num_params=2,
+    .param_types = command_parameters12,
+    .num_args=3,
+    .flags=0,
+    .func=command_spi_transfer
+}, {
+    // spi_set_bus oid=%c spi_bus=%u mode=%u rate=%u
+    .encoded_msgid=36, // msgid=36
+    .num_params=4,
+    .param_types = command_parameters15,
+    .num_args=4,
+    .flags=0,
+    .func=command_spi_set_bus
+}, {
+    // config_spi_without_cs oid=%c
+    .encoded_msgid=37, // msgid=37
+    .num_params=1,
+    .param_types = command_parameters23,
+    .num_args=1,
+    .flags=0,
+    .func=command_config_spi_without_cs
+}, {
+    // config_spi oid=%c pin=%u cs_active_high=%c
+    .encoded_msgid=38, // msgid=38
+    .num_params=3,
+    .param_types = command_parameters32,
+    .num_args=3,
+    .flags=0,
+    .func=command_config_spi
+}, {
+    // i2c_read oid=%c reg=%*s read_len=%u
+    .encoded_msgid=39, // msgid=39
+    .num_params=3,
+    .param_types = command_parameters33,
+    .num_args=4,
+    .flags=0,
+    .func=command_i2c_read
+}, {
+    // i2c_write oid=%c data=%*s
+    .encoded_msgid=40, // msgid=40
+    .num_params=2,
+    .param_types = command_parameters12,
+    .num_args=3,
+    .flags=0,
+    .func=command_i2c_write
+}, {
+    // i2c_set_bus oid=%c i2c_bus=%u rate=%u address=%u
+    .encoded_msgid=41, // msgid=41
+    .num_params=4,
+    .param_types = command_parameters15,
+    .num_args=4,
+    .flags=0,
+    .func=command_i2c_set_bus
+}, {
+    // config_i2c oid=%c
+    .encoded_msgid=42, // msgid=42
+    .num_params=1,
+    .param_types = command_parameters23,
+    .num_args=1,
+    .flags=0,
+    .func=command_config_i2c
+}, {
+    // set_pwm_out pin=%u cycle_ticks=%u value=%hu
+    .encoded_msgid=43, // msgid=43
+    .num_params=3,
+    .param_types = command_parameters34,
+    .num_args=3,
+    .flags=0,
+    .func=command_set_pwm_out
+}, {
+    // queue_pwm_out oid=%c clock=%u value=%hu
+    .encoded_msgid=44, // msgid=44
+    .num_params=3,
+    .param_types = command_parameters11,
+    .num_args=3,
+    .flags=0,
+    .func=command_queue_pwm_out
+}, {
+    // config_pwm_out oid=%c pin=%u cycle_ticks=%u value=%hu default_value=%hu max_duration=%u
+    .encoded_msgid=45, // msgid=45
+    .num_params=6,
+    .param_types = command_parameters35,
+    .num_args=6,
+    .flags=0,
+    .func=command_config_pwm_out
+}, {
+    // buttons_ack oid=%c count=%c
+    .encoded_msgid=46, // msgid=46
+    .num_params=2,
+    .param_types = command_parameters14,
+    .num_args=2,
+    .flags=0,
+    .func=command_buttons_ack
+}, {
+    // buttons_query oid=%c clock=%u rest_ticks=%u retransmit_count=%c invert=%c
+    .encoded_msgid=47, // msgid=47
+    .num_params=5,
+    .param_types = command_parameters36,
+    .num_args=5,
+    .flags=0,
+    .func=command_buttons_query
+}, {
+    // buttons_add oid=%c pos=%c pin=%u pull_up=%c
+    .encoded_msgid=48, // msgid=48
+    .num_params=4,
+    .param_types = command_parameters9,
+    .num_args=4,
+    .flags=0,
+    .func=command_buttons_add
+}, {
+    // config_buttons oid=%c button_count=%c
+    .encoded_msgid=49, // msgid=49
+    .num_params=2,
+    .param_types = command_parameters14,
+    .num_args=2,
+    .flags=0,
+    .func=command_config_buttons
+}, {
+    // tmcuart_send oid=%c write=%*s read=%c
+    .encoded_msgid=50, // msgid=50
+    .num_params=3,
+    .param_types = command_parameters37,
+    .num_args=4,
+    .flags=0,
+    .func=command_tmcuart_send
+}, {
+    // config_tmcuart oid=%c rx_pin=%u pull_up=%c tx_pin=%u bit_time=%u
+    .encoded_msgid=51, // msgid=51
+    .num_params=5,
+    .param_types = command_parameters38,
+    .num_args=5,
+    .flags=0,
+    .func=command_config_tmcuart
+}, {
+    // neopixel_send oid=%c
+    .encoded_msgid=52, // msgid=52
+    .num_params=1,
+    .param_types = command_parameters23,
+    .num_args=1,
+    .flags=0,
+    .func=command_neopixel_send
+}, {
+    // neopixel_update oid=%c pos=%hu data=%*s
+    .encoded_msgid=53, // msgid=53
+    .num_params=3,
+    .param_types = command_parameters20,
+    .num_args=4,
+    .flags=0,
+    .func=command_neopixel_update
+}, {
+    // config_neopixel oid=%c pin=%u data_size=%hu bit_max_ticks=%u reset_min_ticks=%u
+    .encoded_msgid=54, // msgid=54
+    .num_params=5,
+    .param_types = command_parameters39,
+    .num_args=5,
+    .flags=0,
+    .func=command_config_neopixel
+}, {
+    // query_counter oid=%c clock=%u poll_ticks=%u sample_ticks=%u
+    .encoded_msgid=55, // msgid=55
+    .num_params=4,
+    .param_types = command_parameters15,
+    .num_args=4,
+    .flags=0,
+    .func=command_query_counter
+}, {
+    // config_counter oid=%c pin=%u pull_up=%c
+    .encoded_msgid=56, // msgid=56
+    .num_params=3,
+    .param_types = command_parameters32,
+    .num_args=3,
+    .flags=0,
+    .func=command_config_counter
+}, {
+    // st7920_send_data oid=%c data=%*s
+    .encoded_msgid=57, // msgid=57
+    .num_params=2,
+    .param_types = command_parameters12,
+    .num_args=3,
+    .flags=0,
+    .func=command_st7920_send_data
+}, {
+    // st7920_send_cmds oid=%c cmds=%*s
+    .encoded_msgid=58, // msgid=58
+    .num_params=2,
+    .param_types = command_parameters12,
+    .num_args=3,
+    .flags=0,
+    .func=command_st7920_send_cmds
+}, {
+    // config_st7920 oid=%c cs_pin=%u sclk_pin=%u sid_pin=%u sync_delay_ticks=%u cmd_delay_ticks=%u
+    .encoded_msgid=59, // msgid=59
+    .num_params=6,
+    .param_types = command_parameters40,
+    .num_args=6,
+    .flags=0,
+    .func=command_config_st7920
+}, {
+    // hd44780_send_data oid=%c data=%*s
+    .encoded_msgid=60, // msgid=60
+    .num_params=2,
+    .param_types = command_parameters12,
+    .num_args=3,
+    .flags=0,
+    .func=command_hd44780_send_data
+}, {
+    // hd44780_send_cmds oid=%c cmds=%*s
+    .encoded_msgid=61, // msgid=61
+    .num_params=2,
+    .param_types = command_parameters12,
+    .num_args=3,
+    .flags=0,
+    .func=command_hd44780_send_cmds
+}, {
+    // config_hd44780 oid=%c rs_pin=%u e_pin=%u d4_pin=%u d5_pin=%u d6_pin=%u d7_pin=%u delay_ticks=%u
+    .encoded_msgid=62, // msgid=62
+    .num_params=8,
+    .param_types = command_parameters41,
+    .num_args=8,
+    .flags=0,
+    .func=command_config_hd44780
+}, {
+    // spi_set_sw_bus oid=%c miso_pin=%u mosi_pin=%u sclk_pin=%u mode=%u pulse_ticks=%u
+    .encoded_msgid=63, // msgid=63
+    .num_params=6,
+    .param_types = command_parameters40,
+    .num_args=6,
+    .flags=0,
+    .func=command_spi_set_sw_bus
+}, {
+    // i2c_set_sw_bus oid=%c scl_pin=%u sda_pin=%u pulse_ticks=%u address=%u
+    .encoded_msgid=64, // msgid=64
+    .num_params=5,
+    .param_types = command_parameters42,
+    .num_args=5,
+    .flags=0,
+    .func=command_i2c_set_sw_bus
+}, {
+    // query_thermocouple oid=%c clock=%u rest_ticks=%u min_value=%u max_value=%u max_invalid_count=%c
+    .encoded_msgid=65, // msgid=65
+    .num_params=6,
+    .param_types = command_parameters43,
+    .num_args=6,
+    .flags=0,
+    .func=command_query_thermocouple
+}, {
+    // config_thermocouple oid=%c spi_oid=%c thermocouple_type=%c
+    .encoded_msgid=66, // msgid=66
+    .num_params=3,
+    .param_types = command_parameters30,
+    .num_args=3,
+    .flags=0,
+    .func=command_config_thermocouple
+}, {
+    // query_adxl345_status oid=%c
+    .encoded_msgid=67, // msgid=67
+    .num_params=1,
+    .param_types = command_parameters23,
+    .num_args=1,
+    .flags=0,
+    .func=command_query_adxl345_status
+}, {
+    // query_adxl345 oid=%c rest_ticks=%u
+    .encoded_msgid=68, // msgid=68
+    .num_params=2,
+    .param_types = command_parameters25,
+    .num_args=2,
+    .flags=0,
+    .func=command_query_adxl345
+}, {
+    // config_adxl345 oid=%c spi_oid=%c
+    .encoded_msgid=69, // msgid=69
+    .num_params=2,
+    .param_types = command_parameters14,
+    .num_args=2,
+    .flags=0,
+    .func=command_config_adxl345
+}, {
+    // query_lis2dw_status oid=%c
+    .encoded_msgid=70, // msgid=70
+    .num_params=1,
+    .param_types = command_parameters23,
+    .num_args=1,
+    .flags=0,
+    .func=command_query_lis2dw_status
+}, {
+    // query_lis2dw oid=%c rest_ticks=%u
+    .encoded_msgid=71, // msgid=71
+    .num_params=2,
+    .param_types = command_parameters25,
+    .num_args=2,
+    .flags=0,
+    .func=command_query_lis2dw
+}, {
+    // config_lis2dw oid=%c bus_oid=%c bus_oid_type=%c lis_chip_type=%c
+    .encoded_msgid=72, // msgid=72
+    .num_params=4,
+    .param_types = command_parameters44,
+    .num_args=4,
+    .flags=0,
+    .func=command_config_lis2dw
+}, {
+    // query_mpu9250_status oid=%c
+    .encoded_msgid=73, // msgid=73
+    .num_params=1,
+    .param_types = command_parameters23,
+    .num_args=1,
+    .flags=0,
+    .func=command_query_mpu9250_status
+}, {
+    // query_mpu9250 oid=%c rest_ticks=%u
+    .encoded_msgid=74, // msgid=74
+    .num_params=2,
+    .param_types = command_parameters25,
+    .num_args=2,
+    .flags=0,
+    .func=command_query_mpu9250
+}, {
+    // config_mpu9250 oid=%c i2c_oid=%c
+    .encoded_msgid=75, // msgid=75
+    .num_params=2,
+    .param_types = command_parameters14,
+    .num_args=2,
+    .flags=0,
+    .func=command_config_mpu9250
+}, {
+    // query_icm20948_status oid=%c
+    .encoded_msgid=76, // msgid=76
+    .num_params=1,
+    .param_types = command_parameters23,
+    .num_args=1,
+    .flags=0,
+    .func=command_query_icm20948_status
+}, {
+    // query_icm20948 oid=%c rest_ticks=%u
+    .encoded_msgid=77, // msgid=77
+    .num_params=2,
+    .param_types = command_parameters25,
+    .num_args=2,
+    .flags=0,
+    .func=command_query_icm20948
+}, {
+    // config_icm20948 oid=%c i2c_oid=%c
+    .encoded_msgid=78, // msgid=78
+    .num_params=2,
+    .param_types = command_parameters14,
+    .num_args=2,
+    .flags=0,
+    .func=command_config_icm20948
+}, {
+    // query_hx71x_status oid=%c
+    .encoded_msgid=79, // msgid=79
+    .num_params=1,
+    .param_types = command_parameters23,
+    .num_args=1,
+    .flags=0,
+    .func=command_query_hx71x_status
+}, {
+    // query_hx71x oid=%c rest_ticks=%u
+    .encoded_msgid=80, // msgid=80
+    .num_params=2,
+    .param_types = command_parameters25,
+    .num_args=2,
+    .flags=0,
+    .func=command_query_hx71x
+}, {
+    // hx71x_attach_load_cell_probe oid=%c load_cell_probe_oid=%c
+    .encoded_msgid=81, // msgid=81
+    .num_params=2,
+    .param_types = command_parameters14,
+    .num_args=2,
+    .flags=0,
+    .func=hx71x_attach_load_cell_probe
+}, {
+    // config_hx71x oid=%c gain_channel=%c dout_pin=%u sclk_pin=%u
+    .encoded_msgid=82, // msgid=82
+    .num_params=4,
+    .param_types = command_parameters45,
+    .num_args=4,
+    .flags=0,
+    .func=command_config_hx71x
+}, {
+    // query_ads1220_status oid=%c
+    .encoded_msgid=83, // msgid=83
+    .num_params=1,
+    .param_types = command_parameters23,
+    .num_args=1,
+    .flags=0,
+    .func=command_query_ads1220_status
+}, {
+    // query_ads1220 oid=%c rest_ticks=%u
+    .encoded_msgid=84, // msgid=84
+    .num_params=2,
+    .param_types = command_parameters25,
+    .num_args=2,
+    .flags=0,
+    .func=command_query_ads1220
+}, {
+    // ads1220_attach_load_cell_probe oid=%c load_cell_probe_oid=%c
+    .encoded_msgid=85, // msgid=85
+    .num_params=2,
+    .param_types = command_parameters14,
+    .num_args=2,
+    .flags=0,
+    .func=ads1220_attach_load_cell_probe
+}, {
+    // config_ads1220 oid=%c spi_oid=%c data_ready_pin=%u
+    .encoded_msgid=86, // msgid=86
+    .num_params=3,
+    .param_types = command_parameters17,
+    .num_args=3,
+    .flags=0,
+    .func=command_config_ads1220
+}, {
+    // query_status_ldc1612 oid=%c
+    .encoded_msgid=87, // msgid=87
+    .num_params=1,
+    .param_types = command_parameters23,
+    .num_args=1,
+    .flags=0,
+    .func=command_query_status_ldc1612
+}, {
+    // query_ldc1612 oid=%c rest_ticks=%u
+    .encoded_msgid=88, // msgid=88
+    .num_params=2,
+    .param_types = command_parameters25,
+    .num_args=2,
+    .flags=0,
+    .func=command_query_ldc1612
+}, {
+    // query_ldc1612_home_state oid=%c
+    .encoded_msgid=89, // msgid=89
+    .num_params=1,
+    .param_types = command_parameters23,
+    .num_args=1,
+    .flags=0,
+    .func=command_query_ldc1612_home_state
+}, {
+    // ldc1612_setup_home oid=%c clock=%u threshold=%u trsync_oid=%c trigger_reason=%c error_reason=%c
+    .encoded_msgid=90, // msgid=90
+    .num_params=6,
+    .param_types = command_parameters46,
+    .num_args=6,
+    .flags=0,
+    .func=command_ldc1612_setup_home
+}, {
+    // config_ldc1612_with_intb oid=%c i2c_oid=%c intb_pin=%c
+    .encoded_msgid=91, // msgid=91
+    .num_params=3,
+    .param_types = command_parameters30,
+    .num_args=3,
+    .flags=0,
+    .func=command_config_ldc1612_with_intb
+}, {
+    // config_ldc1612 oid=%c i2c_oid=%c
+    .encoded_msgid=92, // msgid=92
+    .num_params=2,
+    .param_types = command_parameters14,
+    .num_args=2,
+    .flags=0,
+    .func=command_config_ldc1612
+}, {
+    // spi_angle_transfer oid=%c data=%*s
+    .encoded_msgid=93, // msgid=93
+    .num_params=2,
+    .param_types = command_parameters12,
+    .num_args=3,
+    .flags=0,
+    .func=command_spi_angle_transfer
+}, {
+    // query_spi_angle oid=%c clock=%u rest_ticks=%u time_shift=%c
+    .encoded_msgid=94, // msgid=94
+    .num_params=4,
+    .param_types = command_parameters16,
+    .num_args=4,
+    .flags=0,
+    .func=command_query_spi_angle
+}, {
+    // config_spi_angle oid=%c spi_oid=%c spi_angle_type=%c
+    .encoded_msgid=95, // msgid=95
+    .num_params=3,
+    .param_types = command_parameters30,
+    .num_args=3,
+    .flags=0,
+    .func=command_config_spi_angle
+}, {
+    // sos_filter_set_active oid=%c n_sections=%c coeff_int_bits=%c
+    .encoded_msgid=96, // msgid=-32
+    .num_params=3,
+    .param_types = command_parameters30,
+    .num_args=3,
+    .flags=0,
+    .func=command_sos_filter_activate
+}, {
+    // sos_filter_set_state oid=%c section_idx=%c state0=%i state1=%i
+    .encoded_msgid=97, // msgid=-31
+    .num_params=4,
+    .param_types = command_parameters47,
+    .num_args=4,
+    .flags=0,
+    .func=command_sos_filter_set_state
+}, {
+    // sos_filter_set_section oid=%c section_idx=%c sos0=%i sos1=%i sos2=%i sos3=%i sos4=%i
+    .encoded_msgid=98, // msgid=-30
+    .num_params=7,
+    .param_types = command_parameters48,
+    .num_args=7,
+    .flags=0,
+    .func=command_sos_filter_set_section
+}, {
+    // config_sos_filter oid=%c max_sections=%c
+    .encoded_msgid=99, // msgid=-29
+    .num_params=2,
+    .param_types = command_parameters14,
+    .num_args=2,
+    .flags=0,
+    .func=command_config_sos_filter
+}, {
+    // load_cell_probe_query_state oid=%c
+    .encoded_msgid=100, // msgid=-28
+    .num_params=1,
+    .param_types = command_parameters23,
+    .num_args=1,
+    .flags=0,
+    .func=command_load_cell_probe_query_state
+}, {
+    // load_cell_probe_home oid=%c trsync_oid=%c trigger_reason=%c error_reason=%c clock=%u rest_ticks=%u timeout=%u
+    .encoded_msgid=101, // msgid=-27
+    .num_params=7,
+    .param_types = command_parameters49,
+    .num_args=7,
+    .flags=0,
+    .func=command_load_cell_probe_home
+}, {
+    // load_cell_probe_set_range oid=%c safety_counts_min=%i safety_counts_max=%i tare_counts=%i trigger_grams=%u grams_per_count=%i
+    .encoded_msgid=102, // msgid=-26
+    .num_params=6,
+    .param_types = command_parameters50,
+    .num_args=6,
+    .flags=0,
+    .func=command_load_cell_probe_set_range
+}, {
+    // config_load_cell_probe oid=%c sos_filter_oid=%c
+    .encoded_msgid=103, // msgid=-25
+    .num_params=2,
+    .param_types = command_parameters14,
+    .num_args=2,
+    .flags=0,
+    .func=command_config_load_cell_probe
+}, {
+    // config_reset
+    .encoded_msgid=104, // msgid=-24
+    .num_params=0,
+    .param_types = 0,
+    .num_args=0,
+    .flags=0x01,
+    .func=command_config_reset
+}, {
+    // set_pca9685_out bus=%c addr=%c channel=%c cycle_ticks=%u value=%hu
+    .encoded_msgid=105, // msgid=-23
+    .num_params=5,
+    .param_types = command_parameters51,
+    .num_args=5,
+    .flags=0,
+    .func=command_set_pca9685_out
+}, {
+    // queue_pca9685_out oid=%c clock=%u value=%hu
+    .encoded_msgid=106, // msgid=-22
+    .num_params=3,
+    .param_types = command_parameters11,
+    .num_args=3,
+    .flags=0,
+    .func=command_queue_pca9685_out
+}, {
+    // config_pca9685 oid=%c bus=%c addr=%c channel=%c cycle_ticks=%u value=%hu default_value=%hu max_duration=%u
+    .encoded_msgid=107, // msgid=-21
+    .num_params=8,
+    .param_types = command_parameters52,
+    .num_args=8,
+    .flags=0,
+    .func=command_config_pca9685
+}, {
+    // query_ds18b20 oid=%c clock=%u rest_ticks=%u min_value=%i max_value=%i
+    .encoded_msgid=108, // msgid=-20
+    .num_params=5,
+    .param_types = command_parameters53,
+    .num_args=5,
+    .flags=0,
+    .func=command_query_ds18b20
+}, {
+    // config_ds18b20 oid=%c serial=%*s max_error_count=%c
+    .encoded_msgid=109, // msgid=-19
+    .num_params=3,
+    .param_types = command_parameters37,
+    .num_args=4,
+    .flags=0,
+    .func=command_config_ds18b20
+},
+};
+
+const uint16_t command_index_size PROGMEM = ARRAY_SIZE(command_index);
+
+// version: b156499-dirty-20261018_050218-vm
+// build_versions: gcc: (Debian 12.2.0-14+deb12u1) 12.2.0 binutils: (GNU Binutils for Debian) 2.40
+
+const uint8_t command_identify_data[] PROGMEM = {
+    0x78, 0xda, 0xa5, 0x1a, 0x6b, 0x6f, 0xe3, 0x36,
+    0xf2, 0xaf, 0x10, 0x06, 0x16, 0x6d, 0xef, 0x92,
+    0xad, 0xf5, 0xb0, 0x6c, 0x07, 0xd8, 0x0f, 0xd9,
+    0x24, 0xdd, 0x06, 0xdd, 0x47, 0x9a, 0x64, 0xaf,
+    0x05, 0x0e, 0x07, 0x41, 0x91, 0x68, 0x9b, 0x58,
+    0xbd, 0x2a, 0x4a, 0x79, 0x5c, 0xb1, 0xff, 0xfd,
+    0x66, 0x38, 0x7c, 0x49, 0x76, 0xd2, 0xc7, 0x05,
+    0x08, 0x2c, 0x71, 0x66, 0xc8, 0xe1, 0x70, 0x66,
+    0x38, 0x0f, 0xfd, 0x3e, 0xcb, 0xda, 0x76, 0x76,
+    0x32, 0xfb, 0xa9, 0x14, 0x6d, 0xcb, 0xbb, 0xd9,
+    0xd1, 0xec, 0x6e, 0x10, 0x65, 0x91, 0xde, 0xf3,
+    0x4e, 0x8a, 0xa6, 0x96, 0x00, 0xda, 0xe6, 0xf9,
+    0x09, 0xfb, 0xf6, 0x9c, 0xdf, 0x89, 0xac, 0x66,
+    0x41, 0xf8, 0x3a, 0x7c, 0x3d, 0x3f, 0x0e, 0xe2,
+    0x7f, 0x16, 0xfc, 0x2e, 0x08, 0x87, 0xe0, 0x3b,
+    0x3d, 0xc4, 0xee, 0x44, 0x3d, 0xf4, 0xa2, 0x94,
+    0x80, 0xfb, 0xee, 0xe3, 0x67, 0xf6, 0x56, 0xbf,
+    0xb2, 0x4d, 0xd3, 0x31, 0x22, 0xfe, 0x8e, 0x85,
+    0xaf, 0xe3, 0x39, 0x2c, 0x91, 0x37, 0x55, 0x95,
+    0xd5, 0x05, 0x4c, 0xfe, 0xfb, 0x2c, 0x2b, 0x64,
+    0x10, 0x86, 0xf3, 0x34, 0xeb, 0xfb, 0x2c, 0xdf,
+    0xa5, 0x65, 0x93, 0x15, 0x69, 0xce, 0xcb, 0x32,
+    0x6d, 0xbb, 0xe6, 0x8e, 0xb3, 0x46, 0x14, 0x6f,
+    0x5e, 0xe5, 0x6c, 0x32, 0x9c, 0xd2, 0xf0, 0xec,
+    0x64, 0xb5, 0x38, 0x9a, 0x65, 0x65, 0xd9, 0xe4,
+    0x59, 0xaf, 0x06, 0x25, 0xcb, 0x9b, 0xa1, 0xee,
+    0x09, 0x86, 0x7b, 0xe9, 0x7b, 0xd8, 0x44, 0x9a,
+    0xe5, 0x5f, 0xcc, 0x4c, 0x0e, 0x1e, 0x27, 0x1e,
+    0x42, 0x51, 0x18, 0x84, 0xb6, 0x91, 0xea, 0x47,
+    0xd4, 0x6f, 0x5e, 0x0d, 0xac, 0x1d, 0x60, 0xcd,
+    0xa1, 0x25, 0x02, 0x6f, 0xc6, 0xdf, 0x06, 0xde,
+    0x3d, 0xd9, 0x39, 0x81, 0x81, 0x2f, 0x88, 0xdd,
+    0x71, 0xd9, 0xa7, 0xbd, 0xc8, 0xbf, 0x48, 0x7a,
+    0xeb, 0xbb, 0xac, 0x96, 0x95, 0xe8, 0x53, 0xb3,
+    0x2a, 0x13, 0x35, 0x48, 0x56, 0xaf, 0xbf, 0x04,
+    0x49, 0x94, 0x3c, 0xeb, 0x52, 0xb9, 0x1b, 0xfa,
+    0xa2, 0x79, 0xa8, 0x67, 0x27, 0x21, 0x0a, 0xa7,
+    0xde, 0x88, 0x6d, 0xaa, 0xe5, 0x62, 0x96, 0x90,
+    0xad, 0xd0, 0x9b, 0x66, 0x45, 0xd6, 0x67, 0x69,
+    0xc7, 0xb3, 0xe2, 0x29, 0x25, 0x26, 0x61, 0xab,
+    0x89, 0x47, 0xf7, 0x58, 0x46, 0xf1, 0x62, 0x9f,
+    0x6e, 0x76, 0x92, 0xac, 0x1d, 0x56, 0x9d, 0x95,
+    0xcd, 0x36, 0x15, 0xb5, 0xdd, 0xb5, 0x9e, 0x29,
+    0x72, 0x1c, 0xe8, 0xad, 0x1a, 0x0c, 0x7a, 0x4d,
+    0x3d, 0xf9, 0xb9, 0xe9, 0xd4, 0x20, 0xef, 0xc6,
+    0x93, 0x8d, 0x64, 0xb7, 0x70, 0x1c, 0x16, 0x62,
+    0x2b, 0xfa, 0xac, 0x4c, 0x9b, 0xa1, 0x9f, 0x10,
+    0xdc, 0x67, 0xe5, 0xc0, 0xd5, 0x16, 0xf9, 0x26,
+    0x1b, 0xca, 0x3e, 0xb5, 0x03, 0x55, 0xf6, 0x98,
+    0x16, 0x43, 0x97, 0xf5, 0xa0, 0x93, 0x8a, 0xcf,
+    0x60, 0xe9, 0xe6, 0x93, 0xc1, 0xea, 0xce, 0x93,
+    0x14, 0xef, 0x44, 0x56, 0xbe, 0x79, 0xf5, 0x0f,
+    0xa9, 0xa8, 0x78, 0xd7, 0x35, 0x9d, 0xc7, 0xf5,
+    0x71, 0xe0, 0xd8, 0xe6, 0xa0, 0x83, 0x7d, 0xd3,
+    0x8e, 0xb8, 0xc8, 0x47, 0x6c, 0x87, 0x8e, 0xed,
+    0x5d, 0x11, 0xc7, 0xcb, 0x95, 0x5d, 0xa6, 0x93,
+    0x5a, 0xfa, 0x8c, 0x9b, 0x87, 0x22, 0xb6, 0x4f,
+    0x0b, 0xfb, 0x94, 0xd8, 0xa7, 0xa5, 0x7d, 0xe2,
+    0x65, 0xf6, 0x64, 0xd5, 0x04, 0xce, 0xc5, 0xc9,
+    0x7c, 0xf7, 0xb8, 0x0c, 0x1e, 0xcd, 0x12, 0xdb,
+    0x4c, 0x80, 0xbc, 0x77, 0x59, 0x5d, 0xf3, 0x52,
+    0x49, 0x05, 0x24, 0x66, 0xe6, 0x90, 0x79, 0xf9,
+    0xc5, 0x1d, 0xbf, 0x9b, 0x40, 0x84, 0x39, 0x33,
+    0xe7, 0x1d, 0x7b, 0xc3, 0x79, 0x15, 0xce, 0xd7,
+    0xf1, 0xca, 0x4c, 0x0d, 0x68, 0x56, 0x2d, 0x96,
+    0x2b, 0x8b, 0x56, 0x16, 0x79, 0x90, 0x04, 0xe1,
+    0x21, 0xac, 0x75, 0x38, 0xc5, 0x4a, 0x1f, 0x44,
+    0xbf, 0x03, 0x15, 0xea, 0xef, 0xf6, 0xf1, 0x19,
+    0x0e, 0x13, 0x7f, 0x48, 0x1b, 0x38, 0x5a, 0x21,
+    0xc3, 0xe2, 0xc1, 0xe9, 0x94, 0x4c, 0xc7, 0x8f,
+    0x69, 0xff, 0xd4, 0xaa, 0x13, 0x07, 0x44, 0xd8,
+    0xbb, 0x68, 0xcd, 0x00, 0xf0, 0xe9, 0x71, 0x70,
+    0xd8, 0x4b, 0xc8, 0x46, 0xa6, 0x1b, 0x51, 0x82,
+    0x26, 0x5a, 0xb6, 0x8f, 0xc3, 0x85, 0xa5, 0xaa,
+    0xda, 0x61, 0x1d, 0x2e, 0xe6, 0x07, 0x65, 0xe0,
+    0xb0, 0x6a, 0xde, 0xb4, 0xe2, 0x91, 0x97, 0x13,
+    0xdd, 0x54, 0x56, 0x27, 0xc5, 0x7f, 0x81, 0x97,
+    0xdd, 0x00, 0xce, 0xae, 0x4f, 0x51, 0xbb, 0x3c,
+    0x5b, 0x97, 0x1c, 0x86, 0xe0, 0xc0, 0xdc, 0xb9,
+    0x2e, 0x62, 0x3b, 0x69, 0x9b, 0x67, 0xeb, 0x64,
+    0xb5, 0xf0, 0xf6, 0x8d, 0x3f, 0xe0, 0x75, 0x3a,
+    0xe5, 0x3f, 0xdc, 0x19, 0xe7, 0x4f, 0xe0, 0x12,
+    0xdc, 0xb4, 0xda, 0x00, 0x76, 0xc3, 0xd4, 0x24,
+    0x60, 0x64, 0xcf, 0x26, 0x8e, 0x43, 0x27, 0xe7,
+    0xf6, 0xa1, 0x3a, 0x60, 0x60, 0xff, 0xcf, 0xec,
+    0xb1, 0x13, 0x91, 0xda, 0x2c, 0xae, 0xe7, 0x36,
+    0xe8, 0x44, 0x6f, 0x96, 0xc4, 0x09, 0x24, 0xcf,
+    0x91, 0x5e, 0xea, 0xa3, 0x70, 0x96, 0x07, 0x6e,
+    0x69, 0xca, 0x1a, 0x7a, 0xe9, 0x5e, 0xdc, 0xf3,
+    0x74, 0x27, 0xb6, 0x3b, 0x45, 0x10, 0xad, 0x7c,
+    0x7c, 0xf0, 0x59, 0xdb, 0x92, 0x1f, 0xf0, 0x87,
+    0x16, 0xe6, 0x54, 0x65, 0xbd, 0x18, 0x51, 0x1a,
+    0xff, 0x7a, 0x88, 0x58, 0x83, 0xd2, 0x4a, 0x6e,
+    0xd1, 0x67, 0xc0, 0xaa, 0xd1, 0x88, 0x16, 0x95,
+    0x1c, 0xed, 0x2e, 0x97, 0xd6, 0xae, 0x22, 0xe7,
+    0x7b, 0x64, 0xbf, 0x5c, 0x3b, 0xd7, 0x93, 0xcb,
+    0x03, 0xe6, 0xc9, 0x24, 0x68, 0xb5, 0x79, 0x7c,
+    0xaa, 0xf3, 0x74, 0x6c, 0xfe, 0x2c, 0xaf, 0x8a,
+    0x74, 0xea, 0x11, 0x16, 0x9e, 0xa4, 0x7a, 0x8e,
+    0x17, 0xb3, 0x65, 0x1d, 0x5e, 0xb5, 0x5d, 0xb1,
+    0x42, 0x74, 0xe6, 0x91, 0xae, 0x15, 0x85, 0xec,
+    0xb0, 0x86, 0x52, 0x72, 0x6f, 0xd2, 0xd0, 0x6d,
+    0xac, 0xdf, 0xf1, 0xae, 0x6a, 0xc0, 0x29, 0xb6,
+    0x07, 0x25, 0xea, 0x83, 0x9d, 0x50, 0x13, 0xe7,
+    0x0b, 0xfb, 0x2a, 0x1f, 0xb2, 0xce, 0x6a, 0x57,
+    0xf7, 0x98, 0xee, 0xb9, 0x7c, 0xd6, 0xdb, 0x41,
+    0x34, 0x96, 0x5e, 0x54, 0x9c, 0xb6, 0xe6, 0x74,
+    0xb4, 0xef, 0x50, 0x1e, 0x4e, 0xac, 0xf3, 0xa3,
+    0x19, 0x04, 0x15, 0x03, 0x98, 0x60, 0x03, 0x21,
+    0xc9, 0xda, 0xbc, 0xc1, 0x2c, 0x5b, 0x65, 0x7e,
+    0x74, 0x3e, 0x81, 0x45, 0xc3, 0x3b, 0x90, 0x35,
+    0x5d, 0xc1, 0x3b, 0x67, 0x4c, 0x78, 0x35, 0x84,
+    0x06, 0xe1, 0xa1, 0x13, 0x3d, 0xdf, 0xc3, 0x40,
+    0xb5, 0x27, 0x44, 0x60, 0x85, 0x57, 0xbc, 0xdb,
+    0xf2, 0x3a, 0x7f, 0x4a, 0xf1, 0x26, 0x00, 0x26,
+    0x60, 0x88, 0x6e, 0x85, 0x74, 0xd7, 0x54, 0x7c,
+    0xef, 0x86, 0x97, 0x59, 0xd5, 0xfa, 0x26, 0xa4,
+    0xdf, 0xed, 0xfd, 0x3e, 0x8e, 0x00, 0x80, 0x75,
+    0x77, 0x87, 0xd1, 0x76, 0xad, 0x8c, 0x3b, 0xb1,
+    0xdd, 0x82, 0xa3, 0x82, 0x4d, 0xc8, 0x86, 0xdc,
+    0x24, 0xba, 0x2a, 0xb3, 0xb8, 0x8a, 0x2f, 0x80,
+    0xa7, 0xac, 0xe7, 0x56, 0x40, 0x68, 0x6e, 0x1b,
+    0x01, 0x37, 0x37, 0x78, 0xa1, 0x94, 0x64, 0xc8,
+    0xf2, 0x2e, 0xa7, 0x3b, 0xe4, 0x68, 0xb6, 0x05,
+    0x07, 0xa4, 0xf8, 0x04, 0x21, 0xeb, 0x37, 0x85,
+    0x03, 0xde, 0x8d, 0x5e, 0x87, 0x16, 0x4f, 0x01,
+    0x2c, 0xf9, 0x68, 0xa6, 0x2f, 0x33, 0x30, 0xd0,
+    0x1a, 0x1c, 0x69, 0x55, 0xd8, 0x5b, 0x1e, 0x9f,
+    0x49, 0xce, 0x49, 0x30, 0x41, 0xc3, 0x23, 0x60,
+    0x5e, 0x0c, 0xa2, 0xd1, 0xe0, 0x38, 0xd4, 0xad,
+    0xf5, 0x77, 0x23, 0x38, 0x58, 0x06, 0x3d, 0x31,
+    0x1d, 0xa6, 0xd6, 0x27, 0xae, 0x6c, 0x91, 0xe1,
+    0x58, 0x5a, 0x72, 0x1d, 0x99, 0xac, 0x09, 0x11,
+    0xfd, 0x2c, 0xf8, 0x4f, 0xdf, 0x8b, 0x2b, 0x77,
+    0x0a, 0x3e, 0x18, 0x84, 0x85, 0xbf, 0x78, 0xce,
+    0x5c, 0x92, 0xd2, 0xc7, 0x81, 0xa3, 0x92, 0x0f,
+    0x3e, 0x21, 0x98, 0xa8, 0x35, 0xcb, 0x22, 0xf3,
+    0x14, 0xd8, 0x33, 0x9a, 0xd1, 0x54, 0x49, 0x4c,
+    0x53, 0x69, 0xad, 0x9a, 0x0a, 0x22, 0x06, 0x41,
+    0x88, 0x82, 0xd7, 0xbd, 0xd8, 0x40, 0x60, 0xb8,
+    0xd9, 0xc0, 0x8a, 0xca, 0xbc, 0x6d, 0xe4, 0x01,
+    0x9c, 0x98, 0x9b, 0x13, 0x60, 0xc3, 0x33, 0x0a,
+    0xd6, 0xef, 0x60, 0xc1, 0x5d, 0x53, 0x16, 0xea,
+    0xe5, 0x65, 0x95, 0x61, 0x14, 0xdc, 0x78, 0x2a,
+    0xb4, 0x06, 0x26, 0xa6, 0x92, 0xf6, 0x97, 0xf9,
+    0x8b, 0x13, 0x3e, 0x17, 0xd9, 0xa2, 0x1e, 0x81,
+    0x53, 0xd4, 0xb7, 0xce, 0x72, 0x7f, 0xcd, 0x43,
+    0xea, 0x7b, 0x1c, 0xae, 0xf6, 0x11, 0xf1, 0x5c,
+    0x20, 0x48, 0xde, 0x3a, 0x37, 0x94, 0x6d, 0x78,
+    0xff, 0x44, 0x06, 0x25, 0xf1, 0x42, 0x7d, 0xf3,
+    0x4a, 0x4c, 0x07, 0xb3, 0x47, 0x1c, 0xec, 0xb3,
+    0x4e, 0x1b, 0x9e, 0x54, 0xaf, 0x7a, 0x33, 0xdb,
+    0x2e, 0xab, 0x14, 0x93, 0xea, 0x21, 0x05, 0xdf,
+    0x69, 0xac, 0x53, 0x20, 0x0f, 0x60, 0x28, 0xe6,
+    0x86, 0x57, 0x6a, 0x6d, 0xd9, 0x5b, 0x84, 0x1e,
+    0x64, 0x68, 0x0b, 0xc7, 0x3a, 0xa5, 0x04, 0xbb,
+    0xc1, 0x3b, 0xec, 0x05, 0xf8, 0x09, 0xda, 0xe3,
+    0x24, 0x4e, 0x1f, 0xc9, 0x09, 0xb4, 0x3b, 0x9e,
+    0xe0, 0x29, 0x99, 0x0c, 0xee, 0x2e, 0x59, 0x79,
+    0x13, 0x8d, 0x02, 0xf7, 0xc9, 0x44, 0xc9, 0x6a,
+    0x82, 0x37, 0x9d, 0x28, 0x59, 0x5a, 0x84, 0x69,
+    0x6c, 0xff, 0x37, 0x9d, 0x57, 0xe5, 0x9c, 0x97,
+    0x8e, 0x07, 0xdc, 0x9b, 0x3a, 0x32, 0x88, 0xcf,
+    0x78, 0xfe, 0xc5, 0x8b, 0xad, 0xa3, 0xc0, 0xf0,
+    0x30, 0x49, 0x08, 0x2c, 0x07, 0x6d, 0x03, 0x27,
+    0x3f, 0x5d, 0xdf, 0xbb, 0xf7, 0x16, 0x66, 0x82,
+    0x49, 0x50, 0xff, 0x8c, 0x1e, 0x7a, 0x2c, 0x0a,
+    0x9f, 0x43, 0x75, 0xd2, 0x73, 0x33, 0xd7, 0x28,
+    0xa8, 0x9e, 0x1e, 0xd0, 0x18, 0x6b, 0x2a, 0xd5,
+    0xe5, 0xda, 0x80, 0xa7, 0x11, 0xf4, 0x64, 0x9e,
+    0xe5, 0x72, 0x8a, 0xb8, 0x37, 0x55, 0x62, 0x30,
+    0x26, 0x51, 0xf6, 0x94, 0xa3, 0xd5, 0x04, 0x4f,
+    0x19, 0xf0, 0xc4, 0x96, 0x56, 0x96, 0xaf, 0x71,
+    0x40, 0x3d, 0xe5, 0x2a, 0x18, 0xa3, 0xed, 0xf1,
+    0x64, 0x77, 0x3f, 0x89, 0x8d, 0xa7, 0xf3, 0xc4,
+    0x13, 0xbc, 0xbd, 0x89, 0xac, 0x1a, 0xef, 0x45,
+    0x6a, 0x2f, 0xb8, 0x10, 0x08, 0xcc, 0xc4, 0x86,
+    0x54, 0x67, 0x6d, 0x57, 0xa0, 0x99, 0x27, 0x42,
+    0x82, 0x1d, 0x5b, 0x01, 0x1f, 0x0a, 0x5e, 0xfe,
+    0x58, 0x3f, 0x46, 0x1a, 0x4c, 0x2f, 0x10, 0x34,
+    0xc1, 0x5d, 0x5a, 0x78, 0x0a, 0x9c, 0x90, 0xfe,
+    0x0d, 0xfc, 0x50, 0x92, 0x6a, 0xd7, 0x68, 0xfc,
+    0x20, 0x3f, 0xb0, 0x24, 0x3a, 0xc6, 0x3f, 0x48,
+    0x62, 0x2d, 0x07, 0x15, 0x33, 0xb4, 0x14, 0xe3,
+    0x20, 0xfd, 0x10, 0x76, 0x1c, 0x1b, 0x64, 0x8c,
+    0xe9, 0x98, 0xcb, 0xae, 0x78, 0x47, 0x61, 0x8c,
+    0xb9, 0x60, 0x76, 0xea, 0xb2, 0x82, 0x5f, 0xd0,
+    0x7d, 0x5c, 0x81, 0x12, 0x12, 0x15, 0x08, 0xaa,
+    0x79, 0xa7, 0x8b, 0x00, 0x16, 0x1c, 0x3e, 0xe2,
+    0xf8, 0x5b, 0x9d, 0x24, 0xe2, 0xb0, 0xbd, 0x68,
+    0x0f, 0x49, 0xb1, 0xad, 0x32, 0x09, 0x3b, 0xe7,
+    0x28, 0xad, 0x00, 0xa2, 0x84, 0x88, 0x6a, 0xfe,
+    0xa8, 0x59, 0x80, 0x50, 0xd5, 0xde, 0x98, 0xa2,
+    0xa3, 0x68, 0x26, 0x20, 0x24, 0x5f, 0x6c, 0x7f,
+    0x3d, 0x2f, 0x42, 0x79, 0x6a, 0x16, 0x8d, 0x34,
+    0xff, 0x20, 0xd7, 0x01, 0x99, 0x22, 0x81, 0x4b,
+    0x15, 0x91, 0x96, 0x52, 0x0f, 0xc3, 0x62, 0xed,
+    0x27, 0x2e, 0x20, 0x60, 0xbe, 0xd9, 0x60, 0x9e,
+    0x9b, 0x42, 0x20, 0xab, 0x53, 0x19, 0x2c, 0x93,
+    0x4c, 0xa6, 0xd0, 0x24, 0xae, 0x0c, 0xa1, 0x5e,
+    0x53, 0x51, 0x3c, 0xea, 0xd4, 0x74, 0xae, 0x6e,
+    0xb2, 0x46, 0x06, 0xfa, 0x37, 0xd4, 0xbf, 0x91,
+    0xfe, 0x8d, 0xc9, 0x6f, 0x61, 0x18, 0x3c, 0x9d,
+    0xda, 0xb3, 0xfd, 0xbd, 0x89, 0x11, 0x46, 0x53,
+    0xe3, 0x53, 0xa0, 0x27, 0x41, 0xe1, 0xba, 0xbc,
+    0x08, 0xcb, 0x50, 0x1b, 0xe7, 0x8e, 0xdd, 0x3d,
+    0xb6, 0x8e, 0x08, 0xcf, 0xbb, 0x09, 0x3d, 0x68,
+    0x14, 0x1b, 0xe8, 0x28, 0xe4, 0xc2, 0x21, 0x1d,
+    0x72, 0x55, 0x4d, 0xc1, 0xbd, 0xd0, 0x0b, 0x48,
+    0x12, 0x47, 0x32, 0x8e, 0xb7, 0x2a, 0x21, 0x1b,
+    0x13, 0x65, 0x55, 0x8d, 0x14, 0x87, 0x52, 0x25,
+    0x33, 0xdd, 0x34, 0x75, 0x49, 0x34, 0x9b, 0xcf,
+    0x6f, 0x24, 0x02, 0x33, 0xa4, 0x64, 0xec, 0xa5,
+    0x98, 0x76, 0xb1, 0x1a, 0x63, 0x1d, 0x0e, 0x69,
+    0x17, 0x4b, 0xc4, 0x52, 0x69, 0x57, 0x8a, 0x71,
+    0x33, 0x5c, 0xff, 0xc2, 0x3b, 0x5a, 0xd0, 0xef,
+    0xb5, 0x43, 0x50, 0xd1, 0x3a, 0x7a, 0x04, 0x0a,
+    0x3f, 0x0e, 0x06, 0x5a, 0x40, 0x01, 0x0b, 0xeb,
+    0xa4, 0x69, 0x24, 0x6b, 0x15, 0x4b, 0xda, 0x58,
+    0x97, 0xe2, 0x10, 0x38, 0x7f, 0x4d, 0x8d, 0x42,
+    0xd4, 0xa1, 0xd6, 0x01, 0xf3, 0x5d, 0x39, 0xbc,
+    0xde, 0x4f, 0xc6, 0x78, 0xdb, 0x74, 0x3a, 0x13,
+    0x20, 0x8f, 0xa8, 0xde, 0xad, 0x21, 0xf0, 0xc7,
+    0x56, 0x40, 0xe0, 0xe4, 0xe7, 0x1d, 0x6b, 0x3b,
+    0xd3, 0x64, 0x17, 0x3e, 0x12, 0x08, 0x85, 0xa2,
+    0xa2, 0x43, 0xbe, 0xd1, 0x73, 0x18, 0xf1, 0x57,
+    0x93, 0xe0, 0x61, 0x79, 0xf7, 0xf4, 0xfc, 0x2c,
+    0xfd, 0x70, 0xfa, 0x2b, 0x86, 0xc7, 0x98, 0x94,
+    0x9f, 0xbd, 0xff, 0x74, 0xf6, 0x53, 0xfa, 0xc3,
+    0xf5, 0xc5, 0xcf, 0xb8, 0x51, 0xfa, 0x3b, 0x9a,
+    0x7d, 0x38, 0xfb, 0x3c, 0x3b, 0x99, 0x95, 0xa2,
+    0x1e, 0x1e, 0x67, 0x47, 0xb3, 0xab, 0xb3, 0x53,
+    0xe5, 0x10, 0x0c, 0x19, 0x68, 0xd4, 0xd5, 0x2f,
+    0x1f, 0xe8, 0x35, 0x0a, 0x97, 0x18, 0x09, 0xdd,
+    0xdc, 0x9e, 0xde, 0xde, 0xa4, 0x37, 0x9f, 0x3f,
+    0xdc, 0xfc, 0x9c, 0xbe, 0x3d, 0xbd, 0xb9, 0xc0,
+    0xdc, 0x29, 0xc1, 0xe1, 0x8b, 0xab, 0xab, 0x8b,
+    0xeb, 0x14, 0x7f, 0xd3, 0xb7, 0x9f, 0x6e, 0x7f,
+    0x4c, 0x2f, 0xce, 0xdf, 0x01, 0x30, 0xf8, 0x8a,
+    0x89, 0xd5, 0x00, 0xa9, 0x9e, 0x2a, 0x67, 0xa8,
+    0xba, 0xb3, 0x5f, 0x6f, 0xc2, 0x77, 0x88, 0xec,
+    0x55, 0x88, 0x0e, 0x6a, 0x36, 0x3b, 0x99, 0x7f,
+    0xa5, 0x50, 0x1f, 0x90, 0x34, 0xec, 0xf5, 0x7c,
+    0x76, 0xf2, 0xef, 0xf9, 0x51, 0xb0, 0xf8, 0xcf,
+    0x57, 0x17, 0xc6, 0xab, 0x68, 0xf9, 0x04, 0x31,
+    0x2e, 0xc3, 0xb3, 0xf4, 0xfc, 0xf4, 0xf6, 0x34,
+    0xbd, 0xb8, 0xbe, 0xfe, 0x74, 0xad, 0xea, 0xb8,
+    0x38, 0x84, 0x7c, 0x7e, 0xbe, 0x31, 0x83, 0x30,
+    0xfb, 0xe5, 0xc7, 0x7f, 0x9d, 0xbe, 0xbf, 0x3c,
+    0x4f, 0xaf, 0x2f, 0x4e, 0xcf, 0x15, 0x81, 0xca,
+    0x38, 0x6f, 0x2e, 0x3e, 0xde, 0x7c, 0xba, 0x86,
+    0xc1, 0xab, 0x4f, 0xd7, 0xb7, 0x16, 0x1d, 0x99,
+    0x18, 0x55, 0xc1, 0x70, 0xa1, 0xf7, 0x97, 0x37,
+    0xe1, 0xf9, 0x2f, 0x00, 0x3c, 0xc2, 0xc7, 0xe8,
+    0xfc, 0x47, 0xda, 0x1d, 0xd8, 0x8f, 0x2a, 0xa6,
+    0xab, 0xd0, 0x0f, 0x59, 0x55, 0x72, 0x5b, 0xfd,
+    0x07, 0x12, 0xbf, 0x56, 0x34, 0xc4, 0x7b, 0xb8,
+    0x32, 0xef, 0x38, 0xe3, 0xfc, 0xfb, 0xe7, 0x20,
+    0x81, 0x85, 0xc0, 0xf8, 0x04, 0x16, 0x5a, 0xd8,
+    0x02, 0xe2, 0x99, 0x31, 0x2c, 0xb2, 0xb0, 0x15,
+    0xa4, 0x4a, 0x63, 0x58, 0x6c, 0x61, 0x41, 0x00,
+    0x81, 0xf6, 0x18, 0xb8, 0x70, 0xc0, 0x38, 0x9e,
+    0x72, 0x93, 0x38, 0xe0, 0x32, 0x9c, 0xb2, 0xb3,
+    0x74, 0xac, 0xce, 0x83, 0x29, 0x3f, 0x2b, 0x07,
+    0x8c, 0xe6, 0x86, 0x21, 0xb8, 0x24, 0x68, 0xf7,
+    0xf0, 0x80, 0xa0, 0x64, 0xb1, 0x00, 0x97, 0x15,
+    0x24, 0x0e, 0x14, 0x78, 0x20, 0x60, 0xd5, 0x07,
+    0x85, 0x1e, 0x08, 0xd4, 0xd0, 0x07, 0x45, 0x1e,
+    0x08, 0x82, 0x7e, 0x1f, 0x14, 0x3b, 0x50, 0x02,
+    0xda, 0xee, 0x83, 0x16, 0x1e, 0x28, 0x18, 0xb3,
+    0x91, 0x78, 0xa0, 0x68, 0xcc, 0xc6, 0xd2, 0x03,
+    0xc5, 0x8a, 0x8d, 0xaf, 0x23, 0x6f, 0xaf, 0x55,
+    0x25, 0x0b, 0xa2, 0x28, 0x52, 0x9a, 0x92, 0xc9,
+    0xc5, 0x3c, 0x5e, 0x16, 0x4a, 0x03, 0xab, 0x3e,
+    0x59, 0x05, 0x89, 0x52, 0x3b, 0x7c, 0x0c, 0x13,
+    0xa9, 0x0a, 0x02, 0x7d, 0xc9, 0x17, 0xf3, 0x20,
+    0xbc, 0x03, 0xd5, 0xd5, 0x93, 0x69, 0xdd, 0x87,
+    0xc7, 0x82, 0xdf, 0xcf, 0x8d, 0xfe, 0x23, 0x1b,
+    0x34, 0x14, 0xa8, 0x21, 0xb4, 0x3b, 0x6f, 0x30,
+    0x54, 0x83, 0x8b, 0x20, 0xf4, 0x07, 0x23, 0x35,
+    0xb8, 0x34, 0x12, 0xa3, 0xc1, 0x58, 0x0d, 0x06,
+    0xf3, 0x30, 0xf6, 0x47, 0x17, 0x34, 0x1a, 0xae,
+    0x46, 0x4b, 0x25, 0x34, 0x6a, 0x4f, 0x8a, 0x46,
+    0x97, 0x34, 0x0a, 0xde, 0xdc, 0x88, 0x00, 0x2e,
+    0x40, 0x81, 0xde, 0xb0, 0x13, 0x35, 0xe4, 0x3f,
+    0x85, 0xf6, 0x3f, 0x4c, 0xf9, 0xa9, 0x0d, 0xe5,
+    0x2c, 0x54, 0xd2, 0x3f, 0x2d, 0x4b, 0xa6, 0xdd,
+    0x8c, 0x09, 0x32, 0x24, 0xab, 0x06, 0xd9, 0xb3,
+    0x5d, 0x06, 0x61, 0x00, 0x44, 0x98, 0x98, 0x9b,
+    0x70, 0x3f, 0x86, 0xa0, 0x4b, 0xe8, 0xb4, 0x54,
+    0x8d, 0x17, 0x66, 0xca, 0x30, 0x05, 0x45, 0x48,
+    0x67, 0x59, 0xcd, 0xea, 0xa6, 0x87, 0xbb, 0x19,
+    0xfe, 0x9b, 0x0d, 0xc4, 0x20, 0x0f, 0x15, 0x11,
+    0x33, 0x45, 0xcc, 0x1e, 0x76, 0x02, 0x9e, 0xc9,
+    0x7f, 0x4a, 0xd6, 0xc2, 0x0d, 0x00, 0x2c, 0x52,
+    0x08, 0x06, 0xb4, 0xdf, 0xf4, 0x18, 0xf2, 0x30,
+    0x29, 0xb6, 0x30, 0x2b, 0xac, 0x9e, 0xf5, 0x4c,
+    0x48, 0x96, 0xe9, 0xb5, 0x28, 0x36, 0xa1, 0xf2,
+    0x90, 0x46, 0x96, 0x88, 0x8a, 0xbe, 0x97, 0x8a,
+    0x58, 0x34, 0xaa, 0x22, 0x3e, 0x15, 0x57, 0xc3,
+    0x72, 0xbc, 0x66, 0xa6, 0x72, 0x68, 0xe9, 0xc1,
+    0x29, 0x9d, 0x51, 0xe7, 0x8d, 0xb5, 0x59, 0x27,
+    0x01, 0xa4, 0x1c, 0x98, 0xaa, 0x0f, 0x19, 0x40,
+    0xc7, 0x21, 0xda, 0x94, 0xbd, 0xea, 0x9e, 0x9d,
+    0x35, 0x43, 0x59, 0xd0, 0xbe, 0xd4, 0x05, 0x73,
+    0x7e, 0x13, 0xac, 0xde, 0x42, 0x4e, 0x86, 0x6c,
+    0x01, 0x31, 0x56, 0x2a, 0xb2, 0x82, 0x72, 0xdc,
+    0x3f, 0x85, 0xca, 0xbe, 0x85, 0x7b, 0xa1, 0x80,
+    0xe0, 0x55, 0xf4, 0xdf, 0x51, 0xeb, 0xee, 0x4f,
+    0x92, 0x55, 0x43, 0xcf, 0x1f, 0x2d, 0x1d, 0x9c,
+    0x9f, 0xc1, 0x1b, 0x9f, 0x2c, 0x96, 0x92, 0x0c,
+    0x04, 0x2e, 0x59, 0xd9, 0x74, 0x10, 0x6c, 0x16,
+    0x5a, 0x34, 0x2d, 0x2d, 0xcd, 0xa8, 0x04, 0x86,
+    0x69, 0xdf, 0x05, 0x6e, 0x9e, 0xc1, 0x05, 0xdf,
+    0x63, 0x81, 0xb1, 0x6a, 0x80, 0x8d, 0xa6, 0x16,
+    0xfa, 0x8a, 0x35, 0x78, 0x91, 0xc1, 0x83, 0xeb,
+    0x9f, 0xbc, 0x2b, 0xa3, 0x5d, 0x63, 0x37, 0x82,
+    0x20, 0xf8, 0x8e, 0x33, 0x8c, 0x97, 0xa6, 0xae,
+    0xcc, 0x0f, 0x54, 0x12, 0x37, 0xb1, 0xa1, 0xa8,
+    0x0b, 0xd8, 0x48, 0x99, 0x75, 0x5b, 0xb5, 0x3b,
+    0xd0, 0x1a, 0xbf, 0x4a, 0x4e, 0x2d, 0xb5, 0x1f,
+    0x9a, 0x2e, 0xe7, 0xb6, 0x2e, 0xcd, 0x74, 0xaf,
+    0x94, 0x3a, 0x68, 0xef, 0xae, 0x2e, 0x3f, 0x31,
+    0x74, 0x01, 0x0c, 0xf4, 0x5f, 0x00, 0x1a, 0x8a,
+    0x6e, 0x03, 0x09, 0x40, 0x41, 0xa9, 0xea, 0x8f,
+    0xbf, 0x62, 0xa6, 0x8b, 0x7d, 0xa3, 0xef, 0xb5,
+    0x5a, 0x8f, 0x44, 0xc4, 0x82, 0xe3, 0x98, 0xfa,
+    0x9e, 0x70, 0x39, 0xb1, 0x8f, 0xa7, 0x67, 0x3f,
+    0x51, 0xce, 0x8e, 0x6f, 0x70, 0x55, 0x5d, 0xdf,
+    0x9a, 0xb1, 0xb9, 0x3f, 0x86, 0x77, 0x95, 0x06,
+    0x60, 0xa4, 0x80, 0x80, 0x5b, 0x0a, 0x4a, 0x28,
+    0x08, 0xb9, 0xa4, 0x34, 0xca, 0xdb, 0x3f, 0x36,
+    0xe0, 0x98, 0x28, 0x8e, 0x30, 0x37, 0xd1, 0xe7,
+    0xdb, 0x80, 0xce, 0xab, 0x56, 0xb0, 0x96, 0x16,
+    0x25, 0x74, 0x2f, 0x90, 0x2a, 0x6b, 0x44, 0x4a,
+    0xd0, 0x99, 0x1e, 0x36, 0xc4, 0xbe, 0xf9, 0xfe,
+    0x1b, 0x4a, 0x8e, 0x0d, 0x91, 0xe9, 0x4f, 0xba,
+    0x36, 0x2b, 0xe5, 0x42, 0x14, 0xb7, 0x1a, 0x2c,
+    0x27, 0x3f, 0x7f, 0x0c, 0xd0, 0xd0, 0x06, 0xc0,
+    0xc6, 0xe1, 0x78, 0xa8, 0x34, 0x6e, 0x80, 0x55,
+    0x03, 0x1e, 0x40, 0x9b, 0x01, 0xc3, 0x86, 0x0f,
+    0xc6, 0x34, 0x0e, 0x6c, 0xdb, 0x43, 0xb6, 0x21,
+    0x44, 0xa5, 0xc9, 0x3d, 0xb8, 0x2e, 0x21, 0xd9,
+    0xf5, 0x23, 0x8f, 0x75, 0xb0, 0x5c, 0x46, 0x6e,
+    0x1a, 0x8b, 0xd5, 0x66, 0xd4, 0x34, 0x89, 0xec,
+    0xd1, 0x75, 0x14, 0x57, 0x51, 0x44, 0x3a, 0xc5,
+    0x32, 0x20, 0x6f, 0x6d, 0xec, 0xaa, 0x98, 0xd0,
+    0x2b, 0x5c, 0x8e, 0xc6, 0x75, 0x4e, 0xae, 0x74,
+    0x87, 0x56, 0x8e, 0x3d, 0x7e, 0x46, 0x29, 0xb5,
+    0x8f, 0x03, 0xca, 0xf1, 0x21, 0x7b, 0x44, 0x05,
+    0x5a, 0x19, 0x79, 0x53, 0x8c, 0xff, 0x81, 0x4b,
+    0x99, 0x81, 0x46, 0xf1, 0x3a, 0x87, 0x98, 0xdd,
+    0x38, 0x12, 0x04, 0x08, 0x29, 0x39, 0x2c, 0x99,
+    0xef, 0x78, 0x31, 0x94, 0x68, 0x17, 0x40, 0x8c,
+    0x89, 0x20, 0xd3, 0x61, 0xa3, 0xd2, 0x48, 0x7e,
+    0xcf, 0xf1, 0xa0, 0x30, 0x07, 0x7c, 0x9e, 0x60,
+    0x97, 0x75, 0x85, 0xf2, 0xa4, 0x1a, 0x1b, 0x3b,
+    0x33, 0xcf, 0x63, 0x1b, 0xb9, 0x68, 0x64, 0xac,
+    0x4b, 0x7f, 0xc0, 0xa3, 0x54, 0xd9, 0x33, 0x83,
+    0xa7, 0x6e, 0x53, 0x36, 0x0f, 0x94, 0xb0, 0x5f,
+    0x73, 0x3d, 0x01, 0x4c, 0x85, 0x86, 0xde, 0x29,
+    0xcf, 0x00, 0x5e, 0xbf, 0xcd, 0xd0, 0xf7, 0x61,
+    0x19, 0xea, 0x46, 0x95, 0x1c, 0xb5, 0xdd, 0x74,
+    0x1c, 0xbf, 0x87, 0x40, 0x6f, 0x8f, 0x3d, 0xbd,
+    0x1b, 0x4b, 0xbb, 0xb7, 0x25, 0xf6, 0x20, 0xe0,
+    0x6a, 0xe1, 0x8f, 0x39, 0x07, 0xa8, 0xdf, 0x42,
+    0xa3, 0xa4, 0xc1, 0x51, 0x8e, 0xb8, 0x7d, 0x81,
+    0x0a, 0x33, 0x16, 0x8f, 0xca, 0x08, 0xe3, 0x05,
+    0x0a, 0x4c, 0x4d, 0x6f, 0x78, 0xaf, 0x8f, 0x4b,
+    0xed, 0x08, 0x31, 0x44, 0x35, 0x54, 0x66, 0xcc,
+    0x98, 0x09, 0x6e, 0xd3, 0xfa, 0x19, 0xfc, 0x12,
+    0x01, 0x26, 0x53, 0x57, 0x87, 0xf2, 0xc8, 0xfe,
+    0x47, 0x09, 0x37, 0xfa, 0x2e, 0xe9, 0x9b, 0x86,
+    0x6d, 0x32, 0x25, 0x2e, 0x12, 0x15, 0xf6, 0x24,
+    0x6e, 0x7d, 0xed, 0xd1, 0xae, 0x5b, 0xb5, 0x13,
+    0xa9, 0x28, 0x7e, 0xab, 0x04, 0x8c, 0x94, 0xe0,
+    0x59, 0x25, 0x57, 0xa1, 0xc7, 0x2d, 0xbc, 0x81,
+    0x59, 0x3c, 0x61, 0xf9, 0x5e, 0xfb, 0x32, 0x49,
+    0x8d, 0x70, 0x0b, 0x41, 0x65, 0xb6, 0x10, 0x2c,
+    0x64, 0x7d, 0xae, 0xb3, 0x3b, 0xbc, 0x50, 0x1b,
+    0xad, 0xe3, 0x4a, 0x1a, 0x84, 0x41, 0x15, 0x2a,
+    0x87, 0x00, 0x4a, 0x02, 0x67, 0x8e, 0x33, 0x40,
+    0x28, 0xd8, 0x97, 0xd4, 0xbb, 0x72, 0x60, 0xe5,
+    0x8c, 0xa6, 0xbe, 0x94, 0x1a, 0xe1, 0x13, 0xa4,
+    0xac, 0xc8, 0x1d, 0x38, 0xda, 0x07, 0xeb, 0xeb,
+    0xcc, 0x06, 0x13, 0x06, 0x37, 0x09, 0xf6, 0x70,
+    0xdd, 0x4e, 0xa9, 0xdd, 0x3c, 0x05, 0xfb, 0x1c,
+    0x81, 0x62, 0x73, 0xaa, 0x18, 0x4e, 0xb0, 0x50,
+    0xd1, 0xf6, 0xd0, 0x96, 0x7b, 0x68, 0x4e, 0x76,
+    0x54, 0xe3, 0x73, 0x60, 0x0c, 0x11, 0x6e, 0xae,
+    0x2e, 0x55, 0xa6, 0x4d, 0x45, 0xe3, 0x7d, 0x98,
+    0x6c, 0x39, 0xaa, 0x7a, 0xb2, 0x9a, 0x02, 0xeb,
+    0xa6, 0x3e, 0xbe, 0xc3, 0xdb, 0x51, 0xd9, 0xdd,
+    0x78, 0x19, 0xfc, 0xb8, 0xc4, 0x61, 0x6b, 0xe7,
+    0x67, 0xc4, 0xa2, 0x7d, 0x55, 0x32, 0x3a, 0x24,
+    0xea, 0xa3, 0xe0, 0xd4, 0x98, 0x72, 0x25, 0xe6,
+    0x4b, 0x1e, 0xc8, 0x77, 0x86, 0xfa, 0x0b, 0x28,
+    0x10, 0x44, 0x4c, 0x05, 0x7d, 0xe8, 0xe1, 0x8d,
+    0x4b, 0x07, 0x00, 0xe9, 0x90, 0x53, 0xd3, 0x77,
+    0x3d, 0xfa, 0x6c, 0xc8, 0x6c, 0x25, 0xcb, 0x25,
+    0x53, 0xf9, 0x10, 0x7e, 0x60, 0x83, 0x69, 0x1e,
+    0xfa, 0x32, 0x25, 0xfe, 0xa1, 0x96, 0x43, 0x8b,
+    0xd9, 0x30, 0xd2, 0x63, 0x65, 0xcd, 0x41, 0xc9,
+    0x11, 0x52, 0x6d, 0xc8, 0x8e, 0xe2, 0xfe, 0xc6,
+    0x34, 0x93, 0x1e, 0x38, 0x08, 0xa1, 0x84, 0x00,
+    0xed, 0x1e, 0x58, 0x52, 0xbb, 0xa2, 0xb8, 0xcb,
+    0x1a, 0xce, 0x1a, 0xfb, 0x75, 0x8f, 0xbc, 0x48,
+    0xab, 0xa1, 0x3c, 0xf1, 0x5c, 0x10, 0xf6, 0x40,
+    0x27, 0xdd, 0x09, 0x0c, 0xf8, 0x2c, 0x13, 0xd8,
+    0x8a, 0xc0, 0x03, 0x2a, 0xd9, 0x84, 0x39, 0x18,
+    0x57, 0x1f, 0x39, 0xd9, 0xd0, 0x50, 0x7f, 0xfa,
+    0x54, 0x50, 0x5b, 0x54, 0x62, 0xf7, 0x09, 0x6f,
+    0x0e, 0xf2, 0x69, 0x39, 0x80, 0x15, 0xd7, 0x7e,
+    0x41, 0x49, 0xd9, 0x76, 0xdb, 0x81, 0x9a, 0x74,
+    0xe0, 0xde, 0x50, 0x79, 0x85, 0x89, 0x64, 0x55,
+    0xe5, 0x41, 0x77, 0x76, 0x55, 0x65, 0x04, 0x6d,
+    0x56, 0x05, 0x2b, 0xd4, 0xf3, 0x1e, 0x75, 0x58,
+    0x7c, 0x20, 0x76, 0x43, 0x0e, 0xd4, 0x06, 0x70,
+    0x25, 0xba, 0x5f, 0xb0, 0x89, 0xae, 0xe3, 0x50,
+    0xf2, 0xc7, 0x58, 0x11, 0x81, 0x88, 0x7d, 0xaf,
+    0xd1, 0x8c, 0x21, 0x3b, 0x24, 0xfa, 0x51, 0xb0,
+    0x5a, 0x2c, 0x54, 0xea, 0xa2, 0x5f, 0x12, 0x95,
+    0xbb, 0xd0, 0x4b, 0xb2, 0x50, 0x2e, 0x09, 0x5e,
+    0x92, 0x64, 0x09, 0xcf, 0xd1, 0x57, 0x95, 0x28,
+    0xe7, 0xa0, 0x05, 0x40, 0x3f, 0xc3, 0x8f, 0xcf,
+    0xde, 0x5d, 0xbd, 0xbf, 0x8f, 0x66, 0xaa, 0x08,
+    0x0a, 0x71, 0x9f, 0xe4, 0xd2, 0x25, 0xc7, 0xa9,
+    0xa8, 0xc7, 0xf5, 0x34, 0x55, 0xa4, 0x3c, 0x58,
+    0xa8, 0xf5, 0xbe, 0x0f, 0x1b, 0x51, 0x64, 0x5e,
+    0xd3, 0x83, 0xaa, 0x6e, 0x54, 0x37, 0x3a, 0xc6,
+    0x06, 0xbb, 0x0a, 0x1e, 0x5d, 0x95, 0xe6, 0x38,
+    0xb0, 0x5d, 0x77, 0x86, 0xb9, 0xbc, 0x7a, 0x52,
+    0x85, 0x1c, 0xd5, 0xb8, 0xc5, 0x31, 0xa3, 0x2f,
+    0xaa, 0x48, 0x06, 0x4a, 0x92, 0xda, 0x8a, 0x2e,
+    0x92, 0xab, 0x8f, 0x5e, 0x54, 0x33, 0xe5, 0x25,
+    0xb6, 0x35, 0x89, 0x7e, 0x48, 0xdd, 0xfa, 0x01,
+    0x46, 0x68, 0xa6, 0x5d, 0x2e, 0xc1, 0x27, 0xdb,
+    0xee, 0xf7, 0xb1, 0x6a, 0xa4, 0x53, 0x9b, 0xc5,
+    0xc0, 0x5e, 0x12, 0x89, 0x20, 0x9f, 0x4e, 0xb3,
+    0x46, 0x5e, 0xab, 0x7a, 0xc4, 0xd6, 0xae, 0xa9,
+    0xc0, 0x39, 0xec, 0x4f, 0xe2, 0x77, 0xc2, 0x61,
+    0xed, 0x95, 0x6b, 0xfa, 0xa6, 0xe6, 0x90, 0xbc,
+    0xde, 0x83, 0x7a, 0xd7, 0x42, 0x8d, 0x5d, 0x5b,
+    0xd5, 0x43, 0xb5, 0xfd, 0x55, 0x2a, 0xdb, 0xbd,
+    0x46, 0x54, 0x6c, 0xc0, 0x3a, 0x71, 0xb2, 0x69,
+    0x3a, 0x68, 0x24, 0xba, 0x74, 0x05, 0x9c, 0xbd,
+    0xce, 0x8a, 0xc7, 0xbf, 0xd1, 0x76, 0x4f, 0x96,
+    0xd1, 0x81, 0xee, 0xea, 0x88, 0x1a, 0x96, 0xa7,
+    0x09, 0x4c, 0x21, 0xcd, 0x9f, 0xc8, 0xab, 0x8f,
+    0x63, 0x80, 0x6a, 0x7b, 0x8d, 0x63, 0xd9, 0xcb,
+    0x21, 0xcf, 0x55, 0xc7, 0x59, 0x7d, 0xab, 0x06,
+    0x39, 0x7f, 0x33, 0xfa, 0xfa, 0xe1, 0x38, 0x50,
+    0x65, 0x73, 0x74, 0x78, 0x90, 0xa1, 0x97, 0x5f,
+    0x46, 0x25, 0x4c, 0x89, 0x51, 0x6b, 0x9d, 0xf3,
+    0x49, 0xb3, 0x32, 0x88, 0xa2, 0x31, 0xcd, 0xa8,
+    0x79, 0xe3, 0xda, 0x0e, 0xba, 0xbd, 0x62, 0x0a,
+    0x85, 0x54, 0xbd, 0xf7, 0xa7, 0xbc, 0x1b, 0x36,
+    0x1b, 0x0e, 0x41, 0x02, 0x75, 0xf2, 0x20, 0x09,
+    0x05, 0x9f, 0x97, 0x1a, 0xb7, 0x26, 0x49, 0xbe,
+    0x81, 0x2a, 0x8d, 0xbb, 0xa8, 0xc2, 0xb4, 0x1e,
+    0x9f, 0x39, 0x8c, 0xe4, 0x50, 0x9d, 0x7a, 0x4f,
+    0x25, 0xfc, 0xf6, 0x8e, 0xa7, 0x1b, 0x81, 0x29,
+    0x73, 0x3f, 0x4b, 0x38, 0xd1, 0x25, 0x55, 0x24,
+    0x06, 0xf7, 0xa6, 0x12, 0x90, 0xe3, 0x60, 0x45,
+    0x35, 0x03, 0xe9, 0xcc, 0x47, 0x0e, 0x95, 0xfe,
+    0x91, 0xbf, 0x69, 0x2b, 0x59, 0xb8, 0x5a, 0xef,
+    0xa4, 0x10, 0x4c, 0x7d, 0x61, 0x2c, 0xb7, 0xaf,
+    0x27, 0xae, 0xec, 0x4f, 0x98, 0xd3, 0x60, 0xcc,
+    0x09, 0xcb, 0x8e, 0xaa, 0x02, 0xab, 0xcb, 0xc3,
+    0xfb, 0x5b, 0xc0, 0xc2, 0xb0, 0x62, 0x3f, 0xf4,
+    0x2b, 0xbe, 0x4e, 0xeb, 0xf2, 0xac, 0x3e, 0xa4,
+    0x6f, 0xfb, 0x5d, 0x7c, 0x98, 0x42, 0x55, 0x71,
+    0x55, 0x8d, 0x80, 0x3e, 0xb3, 0x1a, 0x46, 0xbe,
+    0x0a, 0x6b, 0xb7, 0xfa, 0xcb, 0x5f, 0xf0, 0xa4,
+    0x77, 0xc1, 0x22, 0x89, 0xd7, 0xeb, 0xe3, 0x42,
+    0xc0, 0x55, 0x71, 0x1c, 0xce, 0xc3, 0x24, 0x98,
+    0x07, 0xab, 0x74, 0xbe, 0x98, 0x87, 0xc1, 0xea,
+    0xf8, 0xbe, 0x9a, 0x7d, 0xfd, 0x1f, 0x74, 0x56,
+    0xbd, 0x23,
+};
+
+// Identify size = 3826 (11326 uncompressed)
+const uint32_t command_identify_size PROGMEM
+    = ARRAY_SIZE(command_identify_data);
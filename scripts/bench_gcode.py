@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+# Benchmark the host G-Code command parser
+#
+# Copyright (C) 2026  Kevin O'Connor <kevin@koconnor.net>
+#
+# This file may be distributed under the terms of the GNU GPLv3 license.
+import sys, os, optparse, time
+sys.path.append(os.path.join(os.path.dirname(os.path.realpath(__file__)),
+                             '..', 'klippy'))
+import gcode, reactor
+import extras.gcode_move
+
+# Minimal printer and toolhead objects - the toolhead just records
+# each requested move.
+class BenchToolhead:
+    def __init__(self):
+        self.moves = []
+    def move(self, newpos, speed):
+        self.moves.append((tuple(newpos), speed))
+    def move_batch(self, moves):
+        for newpos, speed in moves:
+            self.move(newpos, speed)
+    def get_position(self):
+        return [0., 0., 0., 0.]
+
+class BenchPrinter:
+    config_error = Exception
+    command_error = gcode.CommandError
+    def __init__(self):
+        self.reactor = reactor.Reactor()
+        self.event_handlers = {}
+        self.objects = {'toolhead': BenchToolhead()}
+    def get_start_args(self):
+        return {}
+    def get_reactor(self):
+        return self.reactor
+    def register_event_handler(self, event, callback):
+        self.event_handlers.setdefault(event, []).append(callback)
+    def send_event(self, event, *params):
+        return [cb(*params) for cb in self.event_handlers.get(event, [])]
+    def lookup_object(self, name, default=None):
+        return self.objects.get(name, default)
+    def get_printer(self):
+        return self
+
+# Generate a deterministic sequence of typical slicer output
+def gen_lines(count):
+    lines = ["G90", "M83", "G1 Z0.2 F3000"]
+    e = 0.
+    for i in range(count):
+        x = 100. + 50. * ((i * 37) % 101) / 100.
+        y = 100. + 50. * ((i * 53) % 103) / 102.
+        e = .01 + .03 * ((i * 7) % 13) / 12.
+        if i % 50 == 0:
+            lines.append("G1 F%d" % (1200 + 600 * (i % 3),))
+        if i % 20 == 0:
+            lines.append("G0 X%.3f Y%.3f ; travel" % (x, y))
+        else:
+            lines.append("G1 X%.3f Y%.3f E%.5f" % (x, y, e))
+    return lines
+
+def run_bench(lines, use_fast):
+    printer = BenchPrinter()
+    gcode_dispatch = gcode.GCodeDispatch(printer)
+    printer.objects['gcode'] = gcode_dispatch
+    gcode_move = extras.gcode_move.GCodeMove(printer)
+    if not use_fast:
+        gcode_dispatch.fast_move_handlers[:] = [None] * len(
+            gcode_dispatch.fast_move_handlers)
+    printer.send_event("klippy:ready")
+    start = time.process_time()
+    gcode_dispatch._process_commands(lines, need_ack=False)
+    cpu_time = time.process_time() - start
+    return cpu_time, printer.objects['toolhead'].moves
+
+def main():
+    usage = "%prog [options] [gcode_file]"
+    opts = optparse.OptionParser(usage)
+    opts.add_option("-n", "--lines", type="int", dest="lines",
+                    default=200000, help="number of generated g-code lines")
+    options, args = opts.parse_args()
+    if len(args) > 1:
+        opts.error("Incorrect number of arguments")
+    if args:
+        f = open(args[0], 'r')
+        lines = f.read().split('\n')
+        f.close()
+    else:
+        lines = gen_lines(options.lines)
+    res = {}
+    for name, use_fast in [("python", False), ("native", True)]:
+        cpu_time, moves = run_bench(lines, use_fast)
+        res[name] = moves
+        print("%-8s %9d lines %8.3fs %12.0f lines/s %9d moves" % (
+            name, len(lines), cpu_time, len(lines) / cpu_time, len(moves)))
+    if res["python"] != res["native"]:
+        print("ERROR: python and native parsing produced different moves")
+        sys.exit(1)
+
+if __name__ == '__main__':
+    main()
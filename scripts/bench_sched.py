@@ -0,0 +1,227 @@
+#!/usr/bin/env python3
+# Benchmark the micro-controller timer scheduler on the host
+#
+# Copyright (C) 2026  Kevin O'Connor <kevin@koconnor.net>
+#
+# This file may be distributed under the terms of the GNU GPLv3 license.
+import sys, os, optparse, tempfile, shutil, subprocess
+
+SRCDIR = os.path.join(os.path.dirname(os.path.realpath(__file__)), '..', 'src')
+
+# Simulation harness - src/sched.c is compiled into this code using a
+# simulated clock.  Each "stepper" timer reschedules itself with a
+# slightly varying interval, each "pwm" timer toggles between two
+# fixed intervals, and each "sensor" timer periodically schedules a
+# one-shot timer (exercising sched_add_timer).  The host cpu time
+# spent in the scheduler is used to estimate the maximum step rate.
+HARNESS = r"""
+#include <stdio.h> // printf
+#include <stdlib.h> // atoi
+#include <time.h> // clock_gettime
+#include "sched.c"
+
+static uint32_t sim_time;
+
+uint32_t timer_read_time(void) { return sim_time; }
+void timer_kick(void) { }
+uint32_t timer_from_us(uint32_t us) {
+    return us * (CONFIG_CLOCK_FREQ / 1000000);
+}
+uint8_t timer_is_before(uint32_t time1, uint32_t time2) {
+    return (int32_t)(time1 - time2) < 0;
+}
+irqstatus_t irq_save(void) { return 0; }
+void irq_restore(irqstatus_t flag) { }
+void irq_disable(void) { }
+uint8_t ctr_lookup_static_string(const char *str) { return 1; }
+uint_fast8_t stepper_event(struct timer *t) { return SF_DONE; }
+
+#define MAX_TIMERS 200
+
+struct sim_timer {
+    struct timer timer, oneshot;
+    uint32_t interval, interval2, seed;
+};
+static struct sim_timer timers[MAX_TIMERS];
+static uint64_t step_count;
+
+static uint_fast8_t
+stepper_sim_event(struct timer *t)
+{
+    struct sim_timer *s = container_of(t, struct sim_timer, timer);
+    step_count++;
+    s->seed = s->seed * 1103515245 + 12345;
+    t->waketime += s->interval + ((s->seed >> 16) & 0xff);
+    return SF_RESCHEDULE;
+}
+
+static uint_fast8_t
+pwm_sim_event(struct timer *t)
+{
+    struct sim_timer *s = container_of(t, struct sim_timer, timer);
+    uint32_t tmp = s->interval;
+    s->interval = s->interval2;
+    s->interval2 = tmp;
+    t->waketime += tmp;
+    return SF_RESCHEDULE;
+}
+
+static uint_fast8_t
+oneshot_sim_event(struct timer *t)
+{
+    return SF_DONE;
+}
+
+static uint_fast8_t
+sensor_sim_event(struct timer *t)
+{
+    struct sim_timer *s = container_of(t, struct sim_timer, timer);
+    s->oneshot.waketime = t->waketime + s->interval2;
+    sched_add_timer(&s->oneshot);
+    t->waketime += s->interval;
+    return SF_RESCHEDULE;
+}
+
+int
+main(int argc, char **argv)
+{
+    int steppers = atoi(argv[1]), pwms = atoi(argv[2]);
+    int sensors = atoi(argv[3]);
+    uint32_t step_interval = atoi(argv[4]);
+    uint64_t events = atoll(argv[5]);
+    if (steppers + pwms + sensors > MAX_TIMERS)
+        return 1;
+    if (setjmp(shutdown_jmp)) {
+        printf("shutdown\n");
+        return 2;
+    }
+    sim_time = 0;
+    sched_timer_reset();
+    int i, count = 0;
+    uint32_t start = timer_from_us(1000);
+    for (i = 0; i < steppers; i++, count++) {
+        struct sim_timer *s = &timers[count];
+        s->seed = i;
+        s->interval = step_interval + step_interval * i / steppers;
+        s->timer.func = stepper_sim_event;
+        s->timer.waketime = start + i * 7;
+        sched_add_timer(&s->timer);
+    }
+    for (i = 0; i < pwms; i++, count++) {
+        struct sim_timer *s = &timers[count];
+        s->interval = timer_from_us(37 + i * 3);
+        s->interval2 = timer_from_us(1000) - s->interval;
+        s->timer.func = pwm_sim_event;
+        s->timer.waketime = start + i * 13;
+        sched_add_timer(&s->timer);
+    }
+    for (i = 0; i < sensors; i++, count++) {
+        struct sim_timer *s = &timers[count];
+        s->interval = timer_from_us(400 + i * 11);
+        s->interval2 = timer_from_us(50);
+        s->timer.func = sensor_sim_event;
+        s->timer.waketime = start + i * 17;
+        s->oneshot.func = oneshot_sim_event;
+        sched_add_timer(&s->timer);
+    }
+
+    struct timespec ts1, ts2;
+    clock_gettime(CLOCK_MONOTONIC, &ts1);
+    uint64_t n;
+    for (n = 0; n < events; n++) {
+        uint32_t next = sched_timer_dispatch();
+        if (timer_is_before(next, sim_time)) {
+            printf("timer dispatched out of order\n");
+            return 3;
+        }
+        sim_time = next;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &ts2);
+    double cpu_time = ((ts2.tv_sec - ts1.tv_sec)
+                       + (ts2.tv_nsec - ts1.tv_nsec) * .000000001);
+    double sim_seconds = (double)sim_time / CONFIG_CLOCK_FREQ;
+    printf("%.9f %llu %.9f\n", cpu_time, (unsigned long long)step_count
+           , sim_seconds);
+    return 0;
+}
+"""
+
+AUTOCONF = """
+#define CONFIG_CLOCK_FREQ 100000000
+#define CONFIG_MACH_AVR 0
+#define CONFIG_INLINE_STEPPER_HACK 0
+#define CONFIG_WANT_SCHED_TIMER_HEAP %d
+#define CONFIG_SCHED_TIMER_HEAP_SIZE %d
+"""
+
+# Build the simulation harness with the given scheduler configuration
+def build_harness(tmpdir, use_heap):
+    incdir = os.path.join(tmpdir, "heap%d" % (use_heap,))
+    os.mkdir(incdir)
+    f = open(os.path.join(incdir, "autoconf.h"), "w")
+    f.write(AUTOCONF % (use_heap, 255))
+    f.close()
+    os.symlink(os.path.join(SRCDIR, "generic"), os.path.join(incdir, "board"))
+    srcname = os.path.join(incdir, "bench_sched.c")
+    f = open(srcname, "w")
+    f.write(HARNESS)
+    f.close()
+    dest = os.path.join(incdir, "bench_sched")
+    cmd = ["gcc", "-Wall", "-O2", "-std=gnu11", "-ffunction-sections",
+           "-fdata-sections", "-Wl,--gc-sections", "-I", incdir,
+           "-I", SRCDIR, "-o", dest, srcname]
+    subprocess.check_call(cmd)
+    return dest
+
+def run_harness(prog, steppers, pwms, sensors, interval, events):
+    args = [prog] + [str(v) for v in [steppers, pwms, sensors,
+                                      interval, events]]
+    out = subprocess.check_output(args, universal_newlines=True)
+    cpu_time, steps, sim_time = out.split()
+    return float(cpu_time), int(steps), float(sim_time)
+
+def main():
+    usage = "%prog [options]"
+    opts = optparse.OptionParser(usage)
+    opts.add_option("-s", "--steppers", type="string", dest="steppers",
+                    default="1,3,6,9,12,16",
+                    help="comma separated list of stepper counts to test")
+    opts.add_option("-p", "--pwms", type="int", dest="pwms", default=4,
+                    help="number of software pwm timers")
+    opts.add_option("-b", "--sensors", type="int", dest="sensors",
+                    default=2, help="number of sensor polling timers")
+    opts.add_option("-i", "--interval", type="int", dest="interval",
+                    default=2000, help="nominal step interval (in ticks)")
+    opts.add_option("-n", "--events", type="int", dest="events",
+                    default=5000000, help="number of timer events to run")
+    options, args = opts.parse_args()
+    if args:
+        opts.error("Incorrect number of arguments")
+    stepper_counts = [int(v) for v in options.steppers.split(',')]
+    tmpdir = tempfile.mkdtemp()
+    try:
+        progs = [("list", build_harness(tmpdir, 0)),
+                 ("heap", build_harness(tmpdir, 1))]
+        print("%8s %8s %14s %14s" % ("steppers", "timers",
+                                     "list steps/s", "heap steps/s"))
+        for steppers in stepper_counts:
+            timers = steppers + options.pwms + 2 * options.sensors
+            res = []
+            sim_times = []
+            for name, prog in progs:
+                cpu_time, steps, sim_time = run_harness(
+                    prog, steppers, options.pwms, options.sensors,
+                    options.interval, options.events)
+                # Estimate max step rate from the host time per step
+                res.append(steps / cpu_time)
+                sim_times.append(sim_time)
+            if sim_times[0] != sim_times[1]:
+                print("ERROR: list and heap timer dispatch do not match")
+                sys.exit(1)
+            print("%8d %8d %13.0fK %13.0fK" % (
+                steppers, timers, res[0] / 1000., res[1] / 1000.))
+    finally:
+        shutil.rmtree(tmpdir)
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,43 @@
+#!/usr/bin/env python3
+# Benchmark the host step compression code using recorded step times
+#
+# Copyright (C) 2026  Kevin O'Connor <kevin@koconnor.net>
+#
+# This file may be distributed under the terms of the GNU GPLv3 license.
+import sys, os, optparse, logging
+sys.path.append(os.path.join(os.path.dirname(os.path.realpath(__file__)),
+                             '..', 'klippy'))
+import chelper
+
+def main():
+    usage = "%prog [options] <parsedump output file>"
+    opts = optparse.OptionParser(usage)
+    opts.add_option("-f", "--mcu-freq", type="float", dest="mcu_freq",
+                    default=16000000., help="micro-controller clock frequency")
+    opts.add_option("-e", "--max-error", type="float", dest="max_error",
+                    default=.000025, help="maximum step error (in seconds)")
+    opts.add_option("-t", "--flush-time", type="float", dest="flush_time",
+                    default=.050, help="time between stepcompress flushes")
+    opts.add_option("-r", "--repeat", type="int", dest="repeat", default=1,
+                    help="number of times to replay each step stream")
+    opts.add_option("-i", "--incremental", action="store_true",
+                    help="use incremental step compression")
+    opts.add_option("-c", "--check", action="store_true",
+                    help="verify the generated step times")
+    options, args = opts.parse_args()
+    if len(args) != 1:
+        opts.error("Incorrect number of arguments")
+    logging.basicConfig(level=logging.INFO)
+    bench = chelper.check_build_bench_stepcompress()
+    cmd = [bench, '-f', str(options.mcu_freq), '-e', str(options.max_error),
+           '-t', str(options.flush_time), '-r', str(options.repeat)]
+    if options.incremental:
+        cmd.append('-i')
+    if options.check:
+        cmd.append('-c')
+    cmd.append(args[0])
+    sys.stdout.flush()
+    os.execv(bench, cmd)
+
+if __name__ == '__main__':
+    main()
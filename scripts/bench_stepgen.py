@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+# Benchmark host step generation on cartesian style kinematics
+#
+# Copyright (C) 2026  Kevin O'Connor <kevin@koconnor.net>
+#
+# This file may be distributed under the terms of the GNU GPLv3 license.
+import sys, os, optparse, math, time
+sys.path.append(os.path.join(os.path.dirname(os.path.realpath(__file__)),
+                             '..', 'klippy'))
+import chelper
+
+MCU_FREQ = 16000000.
+FLUSH_TIME = .050
+
+# Stepper coefficients (as "a_x, a_y, a_z") for each kinematic type
+KINEMATICS = {
+    'cartesian': [('x', (1., 0., 0.)), ('y', (0., 1., 0.)),
+                  ('z', (0., 0., 1.))],
+    'corexy': [('+', (1., 1., 0.)), ('-', (1., -1., 0.))],
+}
+
+# Fill a trapq with a deterministic sequence of zig-zag moves
+def fill_trapq(ffi_lib, tq, count, velocity, accel):
+    print_time = .100
+    pos = [0., 0., 0.]
+    for i in range(count):
+        angle = i * 2.39996
+        dist = 5. + 45. * ((i * 7) % 11) / 10.
+        axes_r = [math.cos(angle), math.sin(angle), .01 * (i % 3 - 1)]
+        norm = math.sqrt(sum([r*r for r in axes_r]))
+        axes_r = [r / norm for r in axes_r]
+        accel_d = .5 * velocity**2 / accel
+        if 2. * accel_d > dist:
+            cruise_v = math.sqrt(dist * accel)
+            accel_t = cruise_v / accel
+            cruise_t = 0.
+        else:
+            cruise_v = velocity
+            accel_t = velocity / accel
+            cruise_t = (dist - 2. * accel_d) / velocity
+        ffi_lib.trapq_append(tq, print_time, accel_t, cruise_t, accel_t,
+                             pos[0], pos[1], pos[2],
+                             axes_r[0], axes_r[1], axes_r[2],
+                             0., cruise_v, accel)
+        pos = [p + r * dist for p, r in zip(pos, axes_r)]
+        print_time += 2. * accel_t + cruise_t
+    return print_time
+
+def run_bench(kin, use_iterative, options):
+    ffi_main, ffi_lib = chelper.get_ffi()
+    ssm = ffi_lib.steppersyncmgr_alloc()
+    ss = ffi_lib.steppersyncmgr_alloc_steppersync(ssm)
+    tq = ffi_lib.trapq_alloc()
+    steppers = []
+    for oid, (axis, coeffs) in enumerate(KINEMATICS[kin]):
+        se = ffi_lib.steppersync_alloc_syncemitter(ss, axis.encode(), True)
+        sc = ffi_lib.syncemitter_get_stepcompress(se)
+        ffi_lib.stepcompress_fill(sc, oid, int(.000025 * MCU_FREQ), 1, 2)
+        if use_iterative:
+            sk = ffi_lib.generic_cartesian_stepper_alloc(*coeffs)
+        elif kin == 'corexy':
+            sk = ffi_lib.corexy_stepper_alloc(axis.encode())
+        else:
+            sk = ffi_lib.cartesian_stepper_alloc(axis.encode())
+        ffi_lib.itersolve_set_trapq(sk, tq, options.step_dist)
+        ffi_lib.syncemitter_set_stepper_kinematics(se, sk)
+        steppers.append(sc)
+    fd = os.open(os.devnull, os.O_RDWR)
+    sq = ffi_lib.serialqueue_alloc(fd, b'f', 0, b'bench')
+    ffi_lib.steppersync_setup_movequeue(ss, sq, 1000000)
+    ffi_lib.steppersync_set_time(ss, 0., MCU_FREQ)
+    end_time = fill_trapq(ffi_lib, tq, options.moves, options.velocity,
+                          options.accel)
+    flush_time = 0.
+    start = time.process_time()
+    while flush_time < end_time:
+        flush_time = min(flush_time + FLUSH_TIME, end_time)
+        ret = ffi_lib.steppersyncmgr_gen_steps(ssm, flush_time, flush_time,
+                                               flush_time - 1.)
+        if ret:
+            raise Exception("Internal error in step generation")
+    elapsed = time.process_time() - start
+    positions = [ffi_lib.stepcompress_find_past_position(sc, 1<<62)
+                 for sc in steppers]
+    ffi_lib.serialqueue_exit(sq)
+    ffi_lib.serialqueue_free(sq)
+    os.close(fd)
+    return elapsed, positions
+
+def main():
+    usage = "%prog [options]"
+    opts = optparse.OptionParser(usage)
+    opts.add_option("-k", "--kinematics", type="choice", dest="kinematics",
+                    choices=sorted(KINEMATICS), default="corexy",
+                    help="kinematics to simulate")
+    opts.add_option("-n", "--moves", type="int", dest="moves", default=5000,
+                    help="number of moves to generate")
+    opts.add_option("-v", "--velocity", type="float", dest="velocity",
+                    default=300., help="maximum move velocity")
+    opts.add_option("-a", "--accel", type="float", dest="accel",
+                    default=5000., help="move acceleration")
+    opts.add_option("-s", "--step-dist", type="float", dest="step_dist",
+                    default=.0125, help="stepper step distance")
+    options, args = opts.parse_args()
+    if args:
+        opts.error("Incorrect number of arguments")
+    results = {}
+    for name, use_iterative in [("iterative", True), ("analytic", False)]:
+        elapsed, positions = run_bench(options.kinematics, use_iterative,
+                                       options)
+        results[name] = positions
+        print("%-9s %.3fs positions=%s" % (name, elapsed, positions))
+    if results["iterative"] != results["analytic"]:
+        print("ERROR: Final stepper positions do not match")
+        sys.exit(1)
+
+if __name__ == '__main__':
+    main()
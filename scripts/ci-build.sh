@@ -74,6 +74,34 @@ start_test klippy "Test klippy import (Python2)"
 $PYTHON2 klippy/klippy.py --import-test
 finish_test klippy "Test klippy import (Python2)"
 
+start_test klippy "Test crc16 implementations"
+$PYTHON scripts/test_crc16.py
+finish_test klippy "Test crc16 implementations"
+
+start_test klippy "Test step compression"
+$PYTHON scripts/test_stepcompress.py --asan
+finish_test klippy "Test step compression"
+
+start_test klippy "Test step generation"
+$PYTHON scripts/test_stepgen.py
+finish_test klippy "Test step generation"
+
+start_test klippy "Test look-ahead planner"
+$PYTHON scripts/test_lookahead.py
+finish_test klippy "Test look-ahead planner"
+
+start_test klippy "Test G-Code move tokenizer"
+$PYTHON scripts/test_gcodeparse.py
+finish_test klippy "Test G-Code move tokenizer"
+
+start_test klippy "Test message parser"
+$PYTHON scripts/test_msgparser.py
+finish_test klippy "Test message parser"
+
+start_test klippy "Test bulk sensor ring buffer"
+$PYTHON scripts/test_bulkqueue.py
+finish_test klippy "Test bulk sensor ring buffer"
+
 start_test klippy "Test invoke klippy (Python3)"
 $PYTHON scripts/test_klippy.py -d ${DICTDIR} test/klippy/*.test
 finish_test klippy "Test invoke klippy (Python3)"
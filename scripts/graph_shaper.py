@@ -48,9 +48,10 @@ def shift_pulses(shaper):
 
 # Shaper selection
 def get_shaper(shaper_name, shaper_freq, damping_ratio):
-    for s in shaper_defs.INPUT_SHAPERS:
+    for s in shaper_defs.INPUT_SHAPERS + shaper_defs.INPUT_SMOOTHERS:
         if shaper_name.lower() == s.name:
-            return s.init_func(shaper_freq, damping_ratio)
+            return shaper_defs.get_shaper_pulses(s, shaper_freq,
+                                                 damping_ratio)
     return shaper_defs.get_none_shaper()
 
 
@@ -214,7 +215,8 @@ def main():
         opts.error("Incorrect number of arguments")
 
     if options.shaper.lower() not in [
-            s.name for s in shaper_defs.INPUT_SHAPERS]:
+            s.name for s in (shaper_defs.INPUT_SHAPERS
+                             + shaper_defs.INPUT_SMOOTHERS)]:
         opts.error("Invalid --shaper=%s specified" % options.shaper)
 
     if options.test_damping_ratios:
@@ -0,0 +1,216 @@
+#!/usr/bin/env python3
+# Check the sensor_bulk_data ring buffer (bulkqueue.c) used by BulkDataBuffer
+#
+# Copyright (C) 2026  Kevin O'Connor <kevin@koconnor.net>
+#
+# This file may be distributed under the terms of the GNU GPLv3 license.
+import sys, os, optparse, socket, struct
+sys.path.append(os.path.join(os.path.dirname(os.path.realpath(__file__)),
+                             '..', 'klippy'))
+import chelper, msgproto
+from extras.bulk_sensor import BulkDataBuffer
+
+BULK_MSGTAG = 80
+OTHER_MSGTAG = 81
+BULK_OID = 3
+
+# Stand-in for the mcu object used by BulkDataBuffer
+class FakeCommand:
+    def get_command_tag(self):
+        return BULK_MSGTAG
+class FakeMCU:
+    def __init__(self, sq):
+        self.sq = sq
+    def lookup_command(self, msgformat):
+        return FakeCommand()
+    def get_serialqueue(self):
+        return self.sq
+
+# Act as the mcu side of a serialqueue (via a socketpair)
+class FakeSerial:
+    def __init__(self):
+        self.ffi_main, self.ffi_lib = chelper.get_ffi()
+        self.mcu_sock, host_sock = socket.socketpair()
+        self.host_sock = host_sock
+        self.sq = self.ffi_main.gc(
+            self.ffi_lib.serialqueue_alloc(host_sock.fileno(), b'u', 0,
+                                           b"test_bulkqueue"),
+            self.ffi_lib.serialqueue_free)
+        self.pqm = self.ffi_main.new('struct pull_queue_message *')
+        self.sync_count = 0
+    def close(self):
+        self.ffi_lib.serialqueue_exit(self.sq)
+        self.mcu_sock.close()
+        self.host_sock.close()
+    def send_msg(self, cmd):
+        # The host expects the mcu to use sequence 1 until it sends data
+        seq = msgproto.MESSAGE_DEST | 1
+        out = [msgproto.MESSAGE_MIN + len(cmd), seq] + cmd
+        out += msgproto.crc16_ccitt(out) + [msgproto.MESSAGE_SYNC]
+        self.mcu_sock.sendall(bytes(bytearray(out)))
+    def send_bulk(self, sequence, data, oid=BULK_OID):
+        cmd = []
+        for v in [BULK_MSGTAG, oid, sequence]:
+            msgproto.PT_uint32().encode(cmd, v)
+        cmd.append(len(data))
+        cmd.extend(bytearray(data))
+        self.send_msg(cmd)
+    def sync(self):
+        # Messages are processed in order, so once a non-bulk message
+        # is received all prior bulk messages have been handled.
+        # Return any other messages found on the receive queue.
+        self.sync_count += 1
+        cmd = []
+        for v in [OTHER_MSGTAG, self.sync_count]:
+            msgproto.PT_uint32().encode(cmd, v)
+        self.send_msg(cmd)
+        other = []
+        while 1:
+            self.ffi_lib.serialqueue_pull(self.sq, self.pqm)
+            msg = list(self.pqm.msg[0:self.pqm.len])
+            payload = msg[msgproto.MESSAGE_HEADER_SIZE:
+                          -msgproto.MESSAGE_TRAILER_SIZE]
+            if payload == cmd:
+                return other
+            other.append(msg)
+
+def gen_data(sequence):
+    return bytes(bytearray([(sequence * 7 + i) & 0xff
+                            for i in range(sequence % 40 + 1)]))
+
+# Check the contents of blocks obtained with peek_blocks()
+def check_blocks(bdb, count, view, first_sequence):
+    block_size, data_offset = bdb.get_block_layout()
+    for i in range(count):
+        block = view[i*block_size:(i+1)*block_size]
+        sequence, data_len = struct.unpack_from("<HB", block)
+        expected = gen_data(first_sequence + i)
+        data = block[data_offset:data_offset+data_len].tobytes()
+        if sequence != first_sequence + i or data != expected:
+            raise Exception("Block %d mismatch (sequence %d, expected %d)"
+                            % (i, sequence, first_sequence + i))
+
+def expect(desc, got, expected):
+    if got != expected:
+        raise Exception("%s: got %s, expected %s" % (desc, got, expected))
+
+def check_wraparound(fs, bdb, block_count):
+    # Partially fill the buffer and release it
+    seq = 0
+    for i in range(block_count - 3):
+        fs.send_bulk(seq + i, gen_data(seq + i))
+    expect("other messages", fs.sync(), [])
+    count, view = bdb.peek_blocks()
+    expect("initial count", count, block_count - 3)
+    check_blocks(bdb, count, view, seq)
+    view.release()
+    bdb.release_blocks(count)
+    seq += count
+    # Fill past the end - peek only reports the contiguous blocks
+    for i in range(block_count):
+        fs.send_bulk(seq + i, gen_data(seq + i))
+    fs.sync()
+    count, view = bdb.peek_blocks()
+    expect("count before wrap", count, 3)
+    check_blocks(bdb, count, view, seq)
+    view.release()
+    bdb.release_blocks(count)
+    seq += count
+    count, view = bdb.peek_blocks()
+    expect("count after wrap", count, block_count - 3)
+    check_blocks(bdb, count, view, seq)
+    view.release()
+    bdb.release_blocks(count)
+    expect("empty peek", bdb.peek_blocks(), (0, None))
+    expect("dropped", bdb.get_dropped(), 0)
+
+def check_overflow(fs, bdb, block_count):
+    # Messages that arrive while the buffer is full are dropped
+    for i in range(block_count + 5):
+        fs.send_bulk(i, gen_data(i))
+    fs.sync()
+    expect("dropped", bdb.get_dropped(), 5)
+    total = 0
+    while 1:
+        count, view = bdb.peek_blocks()
+        if not count:
+            break
+        check_blocks(bdb, count, view, total)
+        view.release()
+        bdb.release_blocks(count)
+        total += count
+    expect("stored blocks", total, block_count)
+    # Space is available again once blocks are released
+    fs.send_bulk(100, gen_data(100))
+    fs.sync()
+    count, view = bdb.peek_blocks()
+    expect("count after release", count, 1)
+    check_blocks(bdb, count, view, 100)
+    view.release()
+    # Clearing discards stored blocks and resets the dropped counter
+    bdb.clear_queue()
+    expect("count after clear", bdb.peek_blocks(), (0, None))
+    expect("dropped after clear", bdb.get_dropped(), 0)
+
+def check_view_lifetime(fs, bdb, block_count):
+    # Blocks obtained with peek_blocks() must not be modified by new
+    # messages until they are released (even if the buffer fills up)
+    for i in range(4):
+        fs.send_bulk(i, gen_data(i))
+    fs.sync()
+    count, view = bdb.peek_blocks()
+    expect("count", count, 4)
+    for i in range(block_count):
+        fs.send_bulk(200 + i, gen_data(200 + i))
+    fs.sync()
+    check_blocks(bdb, count, view, 0)
+    expect("dropped", bdb.get_dropped(), 4)
+    # Partially releasing blocks keeps the remaining blocks valid
+    bdb.release_blocks(2)
+    fs.send_bulk(300, gen_data(300))
+    fs.sync()
+    check_blocks(bdb, 2, view[2*bdb.get_block_layout()[0]:], 2)
+    view.release()
+    bdb.clear_queue()
+
+def check_other_messages(fs, bdb, block_count):
+    # Only matching messages are stored (and they are not also placed
+    # on the normal receive queue)
+    fs.send_bulk(1, gen_data(1))
+    fs.send_bulk(2, gen_data(2), oid=BULK_OID + 1)
+    other = fs.sync()
+    expect("other message count", len(other), 1)
+    count, view = bdb.peek_blocks()
+    expect("count", count, 1)
+    check_blocks(bdb, count, view, 1)
+    view.release()
+    bdb.clear_queue()
+
+TESTS = [
+    ("wraparound", check_wraparound),
+    ("overflow", check_overflow),
+    ("view lifetime", check_view_lifetime),
+    ("other messages", check_other_messages),
+]
+
+def main():
+    usage = "%prog [options]"
+    opts = optparse.OptionParser(usage)
+    opts.add_option("-b", "--blocks", type="int", dest="blocks", default=16,
+                    help="number of blocks in the ring buffer")
+    options, args = opts.parse_args()
+    if args:
+        opts.error("Incorrect number of arguments")
+    block_count = options.blocks
+    for name, func in TESTS:
+        fs = FakeSerial()
+        try:
+            bdb = BulkDataBuffer(FakeMCU(fs.sq), BULK_OID, block_count)
+            func(fs, bdb, block_count)
+            del bdb
+        finally:
+            fs.close()
+        print("%-16s ok" % (name,))
+
+if __name__ == '__main__':
+    main()
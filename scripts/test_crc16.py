@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+# Verify that all crc16_ccitt implementations produce identical results
+#
+# Copyright (C) 2026  Kevin O'Connor <kevin@koconnor.net>
+#
+# This file may be distributed under the terms of the GNU GPLv3 license.
+import sys, os, optparse, random, tempfile, shutil, subprocess, ctypes
+sys.path.append(os.path.join(os.path.dirname(os.path.realpath(__file__)),
+                             '..', 'klippy'))
+import msgproto, chelper
+
+SRCDIR = os.path.join(os.path.dirname(os.path.realpath(__file__)), '..', 'src')
+
+# Build src/generic/crc16_ccitt.c as a host shared library
+def build_mcu_crc16(tmpdir, use_table):
+    incdir = os.path.join(tmpdir, "table%d" % (use_table,))
+    os.mkdir(incdir)
+    f = open(os.path.join(incdir, "autoconf.h"), "w")
+    f.write("#define CONFIG_WANT_CRC16_TABLE %d\n" % (use_table,))
+    f.close()
+    dest = os.path.join(incdir, "crc16.so")
+    cmd = ["gcc", "-Wall", "-O2", "-shared", "-fPIC", "-I", incdir,
+           "-I", os.path.join(SRCDIR, "generic"), "-o", dest,
+           os.path.join(SRCDIR, "generic", "crc16_ccitt.c")]
+    subprocess.check_call(cmd)
+    lib = ctypes.CDLL(dest)
+    lib.crc16_ccitt.restype = ctypes.c_uint16
+    lib.crc16_ccitt.argtypes = [ctypes.c_char_p, ctypes.c_uint]
+    return lib.crc16_ccitt
+
+def gen_buffers(count):
+    # All one and two byte buffers followed by random message sized buffers
+    for i in range(256):
+        yield bytearray([i])
+        for j in range(256):
+            yield bytearray([i, j])
+    rnd = random.Random(42)
+    for i in range(count):
+        length = rnd.randrange(msgproto.MESSAGE_MAX + 1)
+        yield bytearray([rnd.randrange(256) for j in range(length)])
+
+def main():
+    usage = "%prog [options]"
+    opts = optparse.OptionParser(usage)
+    opts.add_option("-n", "--count", type="int", dest="count", default=20000,
+                    help="number of random buffers to check")
+    options, args = opts.parse_args()
+    if args:
+        opts.error("Incorrect number of arguments")
+    ffi_main, ffi_lib = chelper.get_ffi()
+    tmpdir = tempfile.mkdtemp()
+    try:
+        impls = [("mcu_bitwise", build_mcu_crc16(tmpdir, 0)),
+                 ("mcu_table", build_mcu_crc16(tmpdir, 1))]
+        checked = 0
+        for buf in gen_buffers(options.count):
+            expected = msgproto.crc16_ccitt(buf)
+            expected = (expected[0] << 8) | expected[1]
+            results = [("host", ffi_lib.msgblock_crc16_ccitt(bytes(buf),
+                                                             len(buf)))]
+            results += [(name, func(bytes(buf), len(buf)))
+                        for name, func in impls]
+            for name, crc in results:
+                if crc != expected:
+                    print("ERROR: %s crc %04x != %04x for %s"
+                          % (name, crc, expected, list(buf)))
+                    sys.exit(1)
+            checked += 1
+    finally:
+        shutil.rmtree(tmpdir)
+    print("Checked %d buffers - all crc16 implementations match" % (checked,))
+
+if __name__ == '__main__':
+    main()
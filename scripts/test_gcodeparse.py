@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+# Check that the C move tokenizer matches the python G-Code parser
+#
+# Copyright (C) 2026  Kevin O'Connor <kevin@koconnor.net>
+#
+# This file may be distributed under the terms of the GNU GPLv3 license.
+import sys, os, optparse, logging
+sys.path.append(os.path.join(os.path.dirname(os.path.realpath(__file__)),
+                             '..', 'klippy'))
+import chelper, gcode, extras.gcode_move
+from bench_gcode import BenchPrinter
+
+# Test lines and whether the C tokenizer should accept them (lines
+# that are not accepted must be handled by the python parser)
+TEST_LINES = [
+    ("G1 X1 Y2", True), ("G1X1Y2", True), ("G1 X1Y2E.5F1200", True),
+    ("g1 x1 y2 e3", True), ("G1 x1 Y2", True), ("  G1 X1\t Y2  ", True),
+    ("G1 X1 ; comment", True), ("G1 X1;comment", True), ("G1 ; X5", True),
+    ("G1 X 1 Y2", True), ("G1 X-1.5 Y+2. E.25", True), ("G1", True),
+    ("G0 X3 Y4 F600", True), ("G1 X1 X2", True), ("G1 X1e3", True),
+    ("G1 X1E3", True), ("G1 F0", True), ("G1 F-100", True),
+    ("G1 Z.", False), ("G1 X", False), ("G1 X Y2", False),
+    ("G1 X1 Y", False), ("G1 E-", False), ("G1 X1.2.3", False),
+    ("G1 X1 2", False), ("G1 X1*34", False), ("G1 X1 *34", False),
+    ("N1 G1 X1", False), ("N12 G1 X1 Y2*57", False), ("G1 X_1", False),
+    ("G01 X1", False), ("G00 X1 Y2", False), ("G10", False),
+    ("G10 X1", False), ("G1.0 X1", False), ("G 1 X1", False),
+    ("G1 X0x10", True), ("G1 Xinf", False), ("G1 X1\xe9", False),
+]
+
+# G-Code state changes to run before each test line
+TEST_STATES = [
+    [], ["G91"], ["M83"], ["G92 X10 Y-5 E3"],
+    ["M220 S50", "M221 S90", "G1 F3000"],
+]
+
+class TestPrinter(BenchPrinter):
+    def invoke_shutdown(self, msg):
+        raise Exception("Shutdown: %s" % (msg,))
+
+# Run a sequence of lines and report the final g-code state, the
+# responses, and the requested moves
+def run_lines(lines, use_fast):
+    printer = TestPrinter()
+    gcode_dispatch = gcode.GCodeDispatch(printer)
+    printer.objects['gcode'] = gcode_dispatch
+    gcode_move = extras.gcode_move.GCodeMove(printer)
+    if not use_fast:
+        gcode_dispatch.fast_move_handlers[:] = [None] * len(
+            gcode_dispatch.fast_move_handlers)
+    printer.send_event("klippy:ready")
+    responses = []
+    gcode_dispatch.register_output_handler(responses.append)
+    for line in lines:
+        try:
+            gcode_dispatch._process_commands([line], need_ack=True)
+        except Exception as e:
+            responses.append("Exception: %s" % (str(e),))
+    return (tuple(gcode_move.last_position), gcode_move.speed, responses,
+            printer.objects['toolhead'].moves)
+
+def main():
+    usage = "%prog [options]"
+    opts = optparse.OptionParser(usage)
+    opts.add_option("-v", action="store_true", dest="verbose",
+                    help="report the result of each test line")
+    options, args = opts.parse_args()
+    if args:
+        opts.error("Incorrect number of arguments")
+    # Errors are checked via the g-code responses
+    logging.disable(logging.WARNING)
+    ffi_main, ffi_lib = chelper.get_ffi()
+    move_fields = ffi_main.new('struct gcode_move_fields *')
+    errors = 0
+    for line, is_fast in TEST_LINES:
+        gnum = ffi_lib.gcodeparse_move(line.encode(), move_fields)
+        if (gnum >= 0) != is_fast:
+            print("ERROR: line %s: tokenizer returned %d" % (repr(line), gnum))
+            errors += 1
+        for state in TEST_STATES:
+            lines = state + [line, "G1 X7"]
+            python_res = run_lines(lines, False)
+            native_res = run_lines(lines, True)
+            if python_res != native_res:
+                print("ERROR: line %s (after %s):\n  python=%s\n  native=%s"
+                      % (repr(line), state, python_res, native_res))
+                errors += 1
+            elif options.verbose:
+                print("%-20s %s" % (repr(line), python_res))
+    if errors:
+        sys.exit(1)
+    print("%d test lines match the python parser" % (len(TEST_LINES),))
+
+if __name__ == '__main__':
+    main()
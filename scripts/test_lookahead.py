@@ -0,0 +1,262 @@
+#!/usr/bin/env python3
+# Compare the C look-ahead planner with a python reference version
+#
+# Copyright (C) 2026  Kevin O'Connor <kevin@koconnor.net>
+#
+# This file may be distributed under the terms of the GNU GPLv3 license.
+import sys, os, optparse, random, math
+sys.path.append(os.path.join(os.path.dirname(os.path.realpath(__file__)),
+                             '..', 'klippy'))
+import toolhead
+
+# Maximum relative difference between the calculated move velocities
+# and times (the C code may use fused multiply-add instructions)
+MAX_REL_DIFF = .000000001
+
+
+######################################################################
+# Python look-ahead reference (the original toolhead.py implementation)
+######################################################################
+
+class RefMove:
+    def __init__(self, toolhead, start_pos, end_pos, speed):
+        self.toolhead = toolhead
+        self.start_pos = tuple(start_pos)
+        self.end_pos = tuple(end_pos)
+        self.accel = toolhead.max_accel
+        self.junction_deviation = toolhead.junction_deviation
+        velocity = min(speed, toolhead.max_velocity)
+        self.is_kinematic_move = True
+        self.axes_d = axes_d = [ep - sp for sp, ep in zip(start_pos, end_pos)]
+        self.move_d = move_d = math.sqrt(sum([d*d for d in axes_d[:3]]))
+        if move_d < .000000001:
+            # Extrude only move
+            self.end_pos = ((start_pos[0], start_pos[1], start_pos[2])
+                            + self.end_pos[3:])
+            axes_d[0] = axes_d[1] = axes_d[2] = 0.
+            self.move_d = move_d = max([abs(ad) for ad in axes_d[3:]])
+            inv_move_d = 0.
+            if move_d:
+                inv_move_d = 1. / move_d
+            self.accel = 99999999.9
+            velocity = speed
+            self.is_kinematic_move = False
+        else:
+            inv_move_d = 1. / move_d
+        self.axes_r = [d * inv_move_d for d in axes_d]
+        self.min_move_t = move_d / velocity
+        self.max_start_v2 = 0.
+        self.max_cruise_v2 = velocity**2
+        self.delta_v2 = 2.0 * move_d * self.accel
+        self.next_junction_v2 = 999999999.9
+        self.max_mcr_start_v2 = 0.
+        self.mcr_delta_v2 = 2.0 * move_d * toolhead.mcr_pseudo_accel
+    def limit_speed(self, speed, accel):
+        speed2 = speed**2
+        if speed2 < self.max_cruise_v2:
+            self.max_cruise_v2 = speed2
+            self.min_move_t = self.move_d / speed
+        self.accel = min(self.accel, accel)
+        self.delta_v2 = 2.0 * self.move_d * self.accel
+        self.mcr_delta_v2 = min(self.mcr_delta_v2, self.delta_v2)
+    def limit_next_junction_speed(self, speed):
+        self.next_junction_v2 = min(self.next_junction_v2, speed**2)
+    def calc_junction(self, prev_move):
+        if not self.is_kinematic_move or not prev_move.is_kinematic_move:
+            return
+        ea_v2 = [ea.calc_junction(prev_move, self, e_index+3)
+                 for e_index, ea in enumerate(self.toolhead.extra_axes)]
+        max_start_v2 = min([self.max_cruise_v2,
+                            prev_move.max_cruise_v2, prev_move.next_junction_v2,
+                            prev_move.max_start_v2 + prev_move.delta_v2]
+                           + ea_v2)
+        axes_r = self.axes_r
+        prev_axes_r = prev_move.axes_r
+        junction_cos_theta = -(axes_r[0] * prev_axes_r[0]
+                               + axes_r[1] * prev_axes_r[1]
+                               + axes_r[2] * prev_axes_r[2])
+        sin_theta_d2 = math.sqrt(max(0.5*(1.0-junction_cos_theta), 0.))
+        cos_theta_d2 = math.sqrt(max(0.5*(1.0+junction_cos_theta), 0.))
+        one_minus_sin_theta_d2 = 1. - sin_theta_d2
+        if one_minus_sin_theta_d2 > 0. and cos_theta_d2 > 0.:
+            R_jd = sin_theta_d2 / one_minus_sin_theta_d2
+            move_jd_v2 = R_jd * self.junction_deviation * self.accel
+            pmove_jd_v2 = R_jd * prev_move.junction_deviation * prev_move.accel
+            quarter_tan_theta_d2 = .25 * sin_theta_d2 / cos_theta_d2
+            move_centripetal_v2 = self.delta_v2 * quarter_tan_theta_d2
+            pmove_centripetal_v2 = prev_move.delta_v2 * quarter_tan_theta_d2
+            max_start_v2 = min(max_start_v2, move_jd_v2, pmove_jd_v2,
+                               move_centripetal_v2, pmove_centripetal_v2)
+        self.max_start_v2 = max_start_v2
+        self.max_mcr_start_v2 = min(
+            max_start_v2, prev_move.max_mcr_start_v2 + prev_move.mcr_delta_v2)
+    def set_junction(self, start_v2, cruise_v2, end_v2):
+        half_inv_accel = .5 / self.accel
+        accel_d = (cruise_v2 - start_v2) * half_inv_accel
+        decel_d = (cruise_v2 - end_v2) * half_inv_accel
+        cruise_d = self.move_d - accel_d - decel_d
+        self.start_v = start_v = math.sqrt(start_v2)
+        self.cruise_v = cruise_v = math.sqrt(cruise_v2)
+        self.end_v = end_v = math.sqrt(end_v2)
+        self.accel_t = accel_d / ((start_v + cruise_v) * 0.5)
+        self.cruise_t = cruise_d / cruise_v
+        self.decel_t = decel_d / ((end_v + cruise_v) * 0.5)
+
+class RefLookAheadQueue:
+    def __init__(self):
+        self.queue = []
+        self.junction_flush = toolhead.LOOKAHEAD_FLUSH_TIME
+    def limit_next_junction_speed(self, speed):
+        if self.queue:
+            self.queue[-1].limit_next_junction_speed(speed)
+    def flush(self, lazy=False):
+        self.junction_flush = toolhead.LOOKAHEAD_FLUSH_TIME
+        update_flush_count = lazy
+        queue = self.queue
+        flush_count = len(queue)
+        junction_info = [None] * flush_count
+        next_start_v2 = next_mcr_start_v2 = peak_cruise_v2 = 0.
+        pending_cv2_assign = 0
+        for i in range(flush_count-1, -1, -1):
+            move = queue[i]
+            reachable_start_v2 = next_start_v2 + move.delta_v2
+            start_v2 = min(move.max_start_v2, reachable_start_v2)
+            cruise_v2 = None
+            pending_cv2_assign += 1
+            reach_mcr_start_v2 = next_mcr_start_v2 + move.mcr_delta_v2
+            mcr_start_v2 = min(move.max_mcr_start_v2, reach_mcr_start_v2)
+            if mcr_start_v2 < reach_mcr_start_v2:
+                if (mcr_start_v2 + move.mcr_delta_v2 > next_mcr_start_v2
+                    or pending_cv2_assign > 1):
+                    if update_flush_count and peak_cruise_v2:
+                        flush_count = i + pending_cv2_assign
+                        update_flush_count = False
+                    peak_cruise_v2 = (mcr_start_v2 + reach_mcr_start_v2) * .5
+                cruise_v2 = min((start_v2 + reachable_start_v2) * .5
+                                , move.max_cruise_v2, peak_cruise_v2)
+                pending_cv2_assign = 0
+            junction_info[i] = (move, start_v2, cruise_v2, next_start_v2)
+            next_start_v2 = start_v2
+            next_mcr_start_v2 = mcr_start_v2
+        if update_flush_count or not flush_count:
+            return []
+        prev_cruise_v2 = 0.
+        for i in range(flush_count):
+            move, start_v2, cruise_v2, next_start_v2 = junction_info[i]
+            if cruise_v2 is None:
+                cruise_v2 = min(prev_cruise_v2, start_v2)
+            move.set_junction(min(start_v2, cruise_v2), cruise_v2
+                              , min(next_start_v2, cruise_v2))
+            prev_cruise_v2 = cruise_v2
+        res = queue[:flush_count]
+        del queue[:flush_count]
+        return res
+    def add_move(self, move):
+        self.queue.append(move)
+        if len(self.queue) == 1:
+            return
+        move.calc_junction(self.queue[-2])
+        self.junction_flush -= move.min_move_t
+        return self.junction_flush <= 0.
+
+
+######################################################################
+# Planner comparison
+######################################################################
+
+# Extruder style extra axis junction limit
+class FakeExtraAxis:
+    def calc_junction(self, prev_move, move, e_index):
+        diff_r = move.axes_r[e_index] - prev_move.axes_r[e_index]
+        if diff_r:
+            return (1.5 / abs(diff_r))**2
+        return move.max_cruise_v2
+
+class FakeToolhead:
+    max_accel = 3000.
+    max_velocity = 300.
+    junction_deviation = .013
+    mcr_pseudo_accel = 1500.
+    extra_axes = [FakeExtraAxis()]
+
+# Generate a random list of move requests
+def gen_moves(seed, count):
+    rnd = random.Random(seed)
+    pos = [0., 0., 0., 0.]
+    moves = []
+    for i in range(count):
+        newpos = list(pos)
+        if rnd.random() < .05:
+            # Extrude only move
+            newpos[3] += rnd.uniform(-2., 2.)
+        else:
+            if rnd.random() < .9:
+                newpos[0] += rnd.uniform(-3., 3.)
+            newpos[1] += rnd.uniform(-3., 3.)
+            if rnd.random() < .1:
+                newpos[2] += rnd.uniform(0., .2)
+            newpos[3] += rnd.uniform(0., .1)
+        speed = rnd.choice([50., 150., 300., 500.])
+        limit_speed = rnd.random() < .03
+        limit_junction = rnd.random() < .02
+        flush = rnd.random() < .1
+        moves.append((pos, newpos, speed, limit_speed, limit_junction, flush))
+        pos = newpos
+    return moves
+
+# Run a list of move requests through a planner and return the
+# calculated velocities and times of the flushed moves
+def run_planner(move_class, queue_class, moves):
+    th = FakeToolhead()
+    lookahead = queue_class()
+    res = []
+    def note_flushed(flushed):
+        for m in flushed:
+            res.append((m.start_v, m.cruise_v, m.end_v,
+                        m.accel_t, m.cruise_t, m.decel_t))
+    for start_pos, end_pos, speed, limit_speed, limit_junction, flush in moves:
+        move = move_class(th, start_pos, end_pos, speed)
+        if not move.move_d:
+            continue
+        if limit_speed:
+            move.limit_speed(speed * .3, 1000.)
+        want_flush = lookahead.add_move(move)
+        if limit_junction:
+            lookahead.limit_next_junction_speed(speed * .1)
+        if flush or want_flush:
+            note_flushed(lookahead.flush(lazy=not flush))
+    note_flushed(lookahead.flush())
+    return res
+
+def is_close(a, b):
+    return abs(a - b) <= MAX_REL_DIFF * max(abs(a), abs(b), 1.)
+
+def main():
+    usage = "%prog [options]"
+    opts = optparse.OptionParser(usage)
+    opts.add_option("-s", "--seeds", type="int", dest="seeds", default=20,
+                    help="number of random move sequences")
+    opts.add_option("-n", "--moves", type="int", dest="moves", default=3000,
+                    help="number of moves in each sequence")
+    options, args = opts.parse_args()
+    if args:
+        opts.error("Incorrect number of arguments")
+    total = 0
+    for seed in range(options.seeds):
+        moves = gen_moves(seed, options.moves)
+        ref = run_planner(RefMove, RefLookAheadQueue, moves)
+        res = run_planner(toolhead.Move, toolhead.LookAheadQueue, moves)
+        if len(ref) != len(res):
+            print("ERROR: seed %d: %d vs %d flushed moves"
+                  % (seed, len(ref), len(res)))
+            sys.exit(1)
+        for i, (r, m) in enumerate(zip(ref, res)):
+            if not all([is_close(a, b) for a, b in zip(r, m)]):
+                print("ERROR: seed %d move %d: reference=%s planner=%s"
+                      % (seed, i, r, m))
+                sys.exit(1)
+        total += len(ref)
+    print("%d moves match the reference look-ahead planner" % (total,))
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+# Check that the C message parser matches the python message parser
+#
+# Copyright (C) 2026  Kevin O'Connor <kevin@koconnor.net>
+#
+# This file may be distributed under the terms of the GNU GPLv3 license.
+import sys, os, optparse, random, json
+sys.path.append(os.path.join(os.path.dirname(os.path.realpath(__file__)),
+                             '..', 'klippy'))
+import chelper, msgproto
+
+# Data dictionary with messages using every parameter type.  The
+# message ids cover one and two byte encodings, negative ids, and ids
+# that the C parser does not handle (so python parsing is used).
+TEST_DICTIONARY = {
+    "commands": {
+        "set_value oid=%c value=%i": 2,
+    },
+    "responses": {
+        "identify_response offset=%u data=%.*s": 0,
+        "all_ints oid=%c u=%u i=%i hu=%hu hi=%hi": 3,
+        "no_params": 4,
+        "strings oid=%c s=%s": 95,
+        "progmem_buffer data=%.*s count=%u": 96,
+        "buffer data=%*s offset=%hu": 127,
+        "two_buffers a=%*s b=%*s": 128,
+        "enums pin=%u other_pin=%u mode=%c": 1000,
+        "negative_id value=%i": -5,
+        "large_id value=%u": 2000,
+        "many_params a=%c b=%c c=%c d=%c e=%c f=%c g=%c h=%c"
+        " i=%c j=%c k=%c l=%c m=%c n=%c o=%c p=%c": 300,
+        "too_many_params a=%c b=%c c=%c d=%c e=%c f=%c g=%c h=%c"
+        " i=%c j=%c k=%c l=%c m=%c n=%c o=%c p=%c q=%c": 301,
+    },
+    "output": {
+        "Output %u %i %hu %hi %c": 200,
+        "Output string %s and buffer %*s": 201,
+        "Output %.*s only": 202,
+    },
+    "enumerations": {
+        "pin": {"PA0": [0, 16], "PB3": 40},
+        "mode": {"off": 0, "on": 1, "auto": 7},
+    },
+    "config": {},
+}
+
+# Values at the boundaries of the vlq encoding (see msgproto.py)
+VLQ_BOUNDARIES = [0x60, -0x20, 0x3000, -0x1000, 0x180000, -0x80000,
+                  0xc000000, -0x4000000]
+
+def gen_int(rnd, pt):
+    if isinstance(pt, msgproto.Enumeration):
+        # Include values that are not in the enumeration
+        if rnd.random() < .2:
+            return rnd.randrange(0, 300)
+        return pt.enums[rnd.choice(sorted(pt.enums.keys()))]
+    maxv = {msgproto.PT_byte: 0xff, msgproto.PT_uint16: 0xffff,
+            msgproto.PT_int16: 0x7fff}.get(type(pt), 0xffffffff)
+    minv = {msgproto.PT_int16: -0x8000,
+            msgproto.PT_int32: -0x80000000}.get(type(pt), 0)
+    r = rnd.random()
+    if r < .4:
+        v = rnd.choice(VLQ_BOUNDARIES) + rnd.choice([-1, 0])
+    elif r < .5:
+        v = rnd.choice([minv, maxv])
+    else:
+        v = rnd.randrange(minv, maxv + 1)
+    return min(max(v, minv), maxv)
+
+def gen_message(rnd, mp, msgid):
+    param_types = mp.messages_by_id[msgid].param_types
+    # Split the available payload space among the string parameters
+    fixed = sum([5 for pt in param_types if not pt.is_dynamic_string])
+    space = msgproto.MESSAGE_PAYLOAD_MAX - fixed - 2
+    cmd = []
+    mp.msgid_parser.encode(cmd, msgid)
+    for pt in param_types:
+        if pt.is_dynamic_string:
+            l = rnd.randrange(0, max(1, space // 2))
+            space -= l + 1
+            pt.encode(cmd, [rnd.randrange(256) for i in range(l)])
+        elif isinstance(pt, msgproto.Enumeration):
+            # Encode the raw value (which may not be a known enum)
+            pt.pt.encode(cmd, gen_int(rnd, pt))
+        else:
+            pt.encode(cmd, gen_int(rnd, pt))
+    return cmd
+
+def build_block(cmd):
+    out = [msgproto.MESSAGE_MIN + len(cmd), msgproto.MESSAGE_DEST] + cmd
+    return out + msgproto.crc16_ccitt(out) + [msgproto.MESSAGE_SYNC]
+
+# Damage a message (to check that malformed messages are rejected)
+def corrupt(rnd, cmd):
+    cmd = list(cmd)
+    r = rnd.random()
+    if r < .3 and cmd:
+        del cmd[rnd.randrange(len(cmd)):]
+    elif r < .6:
+        cmd.insert(rnd.randrange(len(cmd) + 1), rnd.randrange(256))
+    elif cmd:
+        cmd[rnd.randrange(len(cmd))] = rnd.randrange(256)
+    return cmd
+
+class ParserCheck:
+    def __init__(self):
+        self.ffi_main, self.ffi_lib = chelper.get_ffi()
+        self.mp = msgproto.MessageParser(native=True)
+        self.mp.process_identify(json.dumps(TEST_DICTIONARY),
+                                 decompress=False)
+        self.cparser = self.mp.get_native_parser()
+        self.rec = self.ffi_main.new('struct msgparser_record *')
+        self.native_count = self.fallback_count = self.reject_count = 0
+    def check(self, cmd):
+        s = build_block(cmd)
+        if len(s) > msgproto.MESSAGE_MAX:
+            return
+        ret = self.ffi_lib.msgparser_parse(self.cparser, s, len(s), self.rec)
+        if ret:
+            self.rec.param_count = -1
+        try:
+            expected = self.mp.parse(s)
+        except Exception as e:
+            expected = e
+        try:
+            got = self.mp.parse_record(s, self.rec)
+        except Exception as e:
+            got = e
+        if isinstance(expected, Exception):
+            if not ret:
+                raise Exception("C parser accepted %s (python: %s)"
+                                % (s, expected))
+            self.reject_count += 1
+            return
+        if got != expected:
+            raise Exception("Parse mismatch for %s:\n c: %s\n py: %s"
+                            % (s, got, expected))
+        if not ret:
+            self.native_count += 1
+        else:
+            self.fallback_count += 1
+
+def main():
+    usage = "%prog [options]"
+    opts = optparse.OptionParser(usage)
+    opts.add_option("-s", "--seed", type="int", dest="seed", default=1,
+                    help="random seed")
+    opts.add_option("-n", "--count", type="int", dest="count", default=20000,
+                    help="number of messages to check")
+    options, args = opts.parse_args()
+    if args:
+        opts.error("Incorrect number of arguments")
+    rnd = random.Random(options.seed)
+    pc = ParserCheck()
+    msgids = sorted(pc.mp.messages_by_id.keys())
+    for i in range(options.count):
+        cmd = gen_message(rnd, pc.mp, rnd.choice(msgids))
+        pc.check(cmd)
+        pc.check(corrupt(rnd, cmd))
+    print("%d native parses, %d python fallbacks, %d rejected messages"
+          " - ok" % (pc.native_count, pc.fallback_count, pc.reject_count))
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,187 @@
+#!/usr/bin/env python3
+# Verify that both step compression modes schedule every step correctly
+#
+# Copyright (C) 2026  Kevin O'Connor <kevin@koconnor.net>
+#
+# This file may be distributed under the terms of the GNU GPLv3 license.
+import sys, os, optparse, random, math, tempfile, shutil, subprocess
+sys.path.append(os.path.join(os.path.dirname(os.path.realpath(__file__)),
+                             '..', 'klippy'))
+import chelper
+
+MCU_FREQ = 16000000.
+CHELPER_DIR = os.path.join(os.path.dirname(os.path.realpath(__file__)),
+                           '..', 'klippy', 'chelper')
+
+# Build the benchmark tool with the address sanitizer enabled (so that
+# out of bounds accesses in stepcompress.c are reported)
+def build_asan_bench(tmpdir):
+    dest = os.path.join(tmpdir, "bench_stepcompress")
+    cmd = ["gcc", "-Wall", "-g", "-O1", "-fsanitize=address",
+           "-fno-omit-frame-pointer", "-o", dest]
+    cmd += [os.path.join(CHELPER_DIR, f) for f in chelper.BENCH_SOURCE_FILES]
+    cmd.append("-lm")
+    subprocess.check_call(cmd)
+    return dest
+
+# Write a step stream in the format produced by parsedump.py
+class StreamWriter:
+    def __init__(self):
+        self.lines = []
+        self.last_clock = {}
+        self.last_dir = {}
+    def step(self, oid, clock, sdir):
+        last_clock = self.last_clock.get(oid, 0)
+        clock = max(int(clock), last_clock + 1)
+        if self.last_dir.get(oid) != sdir:
+            self.lines.append("set_next_step_dir oid=%d dir=%d" % (oid, sdir))
+            self.last_dir[oid] = sdir
+        self.lines.append("queue_step oid=%d interval=%d count=1 add=0"
+                          % (oid, clock - last_clock))
+        self.last_clock[oid] = clock
+        return clock
+    def reset(self, oid, clock):
+        self.lines.append("reset_step_clock oid=%d clock=%d" % (oid, clock))
+        self.last_clock[oid] = clock
+    def get_clock(self, oid):
+        return self.last_clock.get(oid, 0)
+    def write(self, filename):
+        f = open(filename, "w")
+        f.write("\n".join(self.lines) + "\n")
+        f.close()
+
+# Generate the steps of a series of trapezoidal moves
+def gen_moves(sw, rnd, oid, count, step_dist):
+    print_time = sw.get_clock(oid) / MCU_FREQ + .100
+    sdir = 0
+    for i in range(count):
+        if rnd.random() < .3:
+            # Reverse direction (after a pause to avoid step filtering)
+            sdir = not sdir
+            print_time += .002
+        dist = rnd.uniform(.05, 50.)
+        accel = rnd.uniform(500., 20000.)
+        cruise_v = rnd.uniform(5., 500.)
+        accel_d = min(.5 * cruise_v**2 / accel, .5 * dist)
+        cruise_v = math.sqrt(2. * accel_d * accel)
+        cruise_d = dist - 2. * accel_d
+        steps = int(dist / step_dist)
+        for s in range(1, steps + 1):
+            pos = s * step_dist
+            if pos < accel_d:
+                t = math.sqrt(2. * pos / accel)
+            elif pos < accel_d + cruise_d:
+                t = cruise_v / accel + (pos - accel_d) / cruise_v
+            else:
+                rem = max(0., dist - pos)
+                t = (2. * cruise_v / accel + cruise_d / cruise_v
+                     - math.sqrt(2. * rem / accel))
+            sw.step(oid, (print_time + t) * MCU_FREQ, sdir)
+        print_time = sw.get_clock(oid) / MCU_FREQ + rnd.uniform(0., .010)
+
+# Generate steps with irregular (hard to compress) intervals
+def gen_jitter(sw, rnd, oid, count):
+    clock = sw.get_clock(oid) + 1000
+    interval = 2000.
+    for i in range(count):
+        interval = min(max(interval + rnd.uniform(-150., 150.), 200.), 20000.)
+        clock += interval + rnd.uniform(-300., 300.)
+        clock = sw.step(oid, clock, 1)
+
+# Generate short bursts of steps separated by long pauses (some
+# longer than the maximum clock delta of a queue_step command)
+def gen_sparse(sw, rnd, oid, count):
+    clock = sw.get_clock(oid) + 1000
+    for i in range(count):
+        clock += rnd.choice([.5, 10., 55., 70.]) * MCU_FREQ
+        for j in range(rnd.randrange(1, 200)):
+            clock = sw.step(oid, clock + rnd.uniform(300., 5000.), i & 1)
+
+# Generate moves that are separated by step clock resets
+def gen_resets(sw, rnd, oid, count):
+    for i in range(count):
+        sw.reset(oid, sw.get_clock(oid) + int(rnd.uniform(.1, 5.) * MCU_FREQ))
+        gen_moves(sw, rnd, oid, 3, .0125)
+
+# Fill the internal step queue and then add a step that is more than
+# the maximum clock delta past the last transmitted step.  Only some
+# of the queued steps are flushed before that step is added.
+QUEUE_START_SIZE = 1024
+CLOCK_DIFF_MAX = 3<<28
+def gen_far_full(sw, rnd, oid, count):
+    for i in range(count):
+        start_clock = clock = sw.get_clock(oid) + 1000
+        for j in range(QUEUE_START_SIZE * (i + 1)):
+            clock = sw.step(oid, clock + rnd.uniform(200., 8000.), 0)
+        far_clock = start_clock + CLOCK_DIFF_MAX + (clock - start_clock) // 2
+        sw.step(oid, far_clock, 0)
+        sw.step(oid, far_clock + 1000, 0)
+        sw.reset(oid, sw.get_clock(oid) + 1000)
+
+TEST_STREAMS = [
+    ("moves", [], lambda sw, rnd: (gen_moves(sw, rnd, 0, 100, .0125),
+                                   gen_moves(sw, rnd, 1, 100, .0025))),
+    ("jitter", [], lambda sw, rnd: gen_jitter(sw, rnd, 2, 200000)),
+    ("sparse", [], lambda sw, rnd: gen_sparse(sw, rnd, 3, 40)),
+    ("resets", [], lambda sw, rnd: gen_resets(sw, rnd, 4, 50)),
+    ("farfull", ['-t', '100'], lambda sw, rnd: gen_far_full(sw, rnd, 5, 3)),
+]
+
+# Extract the total step and queue_step message counts from the output
+# of bench_stepcompress
+def parse_totals(output):
+    for line in output.split('\n'):
+        if line.startswith('total: '):
+            parts = dict(p.split('=', 1) for p in line.split()[1:])
+            return int(parts['steps']), int(parts['queue_step'])
+    return 0, 0
+
+def main():
+    usage = "%prog [options]"
+    opts = optparse.OptionParser(usage)
+    opts.add_option("-s", "--seed", type="int", dest="seed", default=42,
+                    help="random seed for the generated step streams")
+    opts.add_option("-a", "--asan", action="store_true",
+                    help="build the tool with the address sanitizer")
+    options, args = opts.parse_args()
+    if args:
+        opts.error("Incorrect number of arguments")
+    tmpdir = tempfile.mkdtemp()
+    try:
+        if options.asan:
+            bench = build_asan_bench(tmpdir)
+        else:
+            bench = chelper.check_build_bench_stepcompress()
+        failed = False
+        for name, bench_args, gen in TEST_STREAMS:
+            sw = StreamWriter()
+            gen(sw, random.Random(options.seed))
+            filename = os.path.join(tmpdir, name + ".txt")
+            sw.write(filename)
+            # Both modes must schedule every step within max_error of
+            # the requested time ('-c'), and so also within max_error
+            # of each other.  Incremental mode must not need more
+            # queue_step messages than the default mode.
+            msgs = {}
+            for mode, mode_args in [("default", []), ("incremental", ['-i'])]:
+                cmd = [bench, '-c'] + bench_args + mode_args + [filename]
+                output = subprocess.check_output(cmd).decode()
+                steps, msgs[mode] = parse_totals(output)
+                print("%-8s %-11s %8d steps %7d queue_step - ok"
+                      % (name, mode, steps, msgs[mode]))
+            if msgs["incremental"] > msgs["default"]:
+                print("ERROR: %s incremental mode used more queue_step"
+                      " messages (%d) than default mode (%d)"
+                      % (name, msgs["incremental"], msgs["default"]))
+                failed = True
+    except subprocess.CalledProcessError as e:
+        print(e.output.decode())
+        print("ERROR: step compression check failed")
+        sys.exit(1)
+    finally:
+        shutil.rmtree(tmpdir)
+    if failed:
+        sys.exit(1)
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,254 @@
+#!/usr/bin/env python3
+# Check that alternative step time calculations generate the same steps
+#
+# Copyright (C) 2026  Kevin O'Connor <kevin@koconnor.net>
+#
+# This file may be distributed under the terms of the GNU GPLv3 license.
+import sys, os, optparse, random, math
+sys.path.append(os.path.join(os.path.dirname(os.path.realpath(__file__)),
+                             '..', 'klippy'))
+import chelper
+from extras import shaper_defs
+
+MCU_FREQ = 16000000.
+FLUSH_TIME = .050
+STEP_DIST = .05
+# Maximum difference (in seconds) between the step times of the two
+# variants.  The iterative solver stops once it is within a nanometer
+# (or a nanosecond) of the step position, which near a standstill
+# corresponds to about sqrt(2 * 1nm / accel) seconds.
+MAX_STEP_DIFF = .000002
+
+# Add a random trapezoidal move to a trapq and return its duration
+def append_move(ffi_lib, tq, rnd, print_time, pos, axes_r, dist,
+                max_v=300.):
+    accel = rnd.uniform(500., 10000.)
+    start_v = rnd.choice([0., rnd.uniform(0., max_v / 6.)])
+    cruise_v = rnd.uniform(start_v + 1., max_v)
+    end_v = rnd.choice([0., rnd.uniform(0., start_v)])
+    accel_d = (cruise_v**2 - start_v**2) * .5 / accel
+    decel_d = (cruise_v**2 - end_v**2) * .5 / accel
+    if accel_d + decel_d > dist:
+        cruise_v = math.sqrt(.5 * (start_v**2 + end_v**2) + accel * dist)
+        accel_d = (cruise_v**2 - start_v**2) * .5 / accel
+        decel_d = dist - accel_d
+    accel_t = (cruise_v - start_v) / accel
+    decel_t = (cruise_v - end_v) / accel
+    cruise_t = max(0., dist - accel_d - decel_d) / cruise_v
+    ffi_lib.trapq_append(tq, print_time, accel_t, cruise_t, decel_t,
+                         pos[0], pos[1], pos[2],
+                         axes_r[0], axes_r[1], axes_r[2],
+                         start_v, cruise_v, accel)
+    return accel_t + cruise_t + decel_t
+
+# Fill a trapq with random moves (that stay within a 200mm cube)
+def fill_trapq(ffi_lib, tq, rnd, count):
+    print_time = .100
+    pos = [100., 100., 100.]
+    for i in range(count):
+        dest = [p + rnd.uniform(-10., 10.) for p in pos[:2]]
+        dest.append(pos[2] + rnd.choice([0., 0., 0., rnd.uniform(-2., 2.)]))
+        dest = [min(max(d, 0.), 200.) for d in dest]
+        axes_d = [d - p for d, p in zip(dest, pos)]
+        dist = math.sqrt(sum([d*d for d in axes_d]))
+        if dist < .001:
+            continue
+        axes_r = [d / dist for d in axes_d]
+        print_time += append_move(ffi_lib, tq, rnd, print_time, pos,
+                                  axes_r, dist)
+        pos = dest
+        print_time += rnd.choice([0., .010])
+    return print_time
+
+# Fill a trapq with random extruder moves.  Some moves are replaced
+# with bursts of hundreds of very short moves, so that the pressure
+# advance smoothing window contains more moves than fit in the
+# integral cache of kin_extruder.c.
+def fill_extruder_trapq(ffi_lib, tq, rnd, count):
+    print_time = .100
+    pos = 100.
+    for i in range(count):
+        if rnd.random() < .02:
+            velocity = rnd.uniform(1., 10.)
+            for j in range(rnd.randrange(300, 400)):
+                move_t = rnd.uniform(.00008, .00012)
+                ffi_lib.trapq_append(tq, print_time, 0., move_t, 0.,
+                                     pos, 0., 0., 1., 1., 0.,
+                                     velocity, velocity, 0.)
+                pos += velocity * move_t
+                print_time += move_t
+            continue
+        # Retracts (negative moves) do not use pressure advance
+        dist = rnd.uniform(.01, 2.)
+        axes_r = rnd.choice([(1., 1., 0.), (1., 1., 0.), (-1., 0., 0.)])
+        print_time += append_move(ffi_lib, tq, rnd, print_time,
+                                  (pos, 0., 0.), axes_r, dist, max_v=50.)
+        pos += axes_r[0] * dist
+        print_time += rnd.choice([0., 0., .010])
+    return print_time
+
+# Stepper allocation function, stepper names, step distance, and move
+# generator for each kinematic type
+KINEMATICS = {
+    'cartesian': ('cartesian_stepper_alloc', ['x', 'y', 'z'], STEP_DIST,
+                  fill_trapq),
+    'corexy': ('corexy_stepper_alloc', ['+', '-'], STEP_DIST, fill_trapq),
+    'extruder': ('extruder_stepper_alloc', ['e'], .01,
+                 fill_extruder_trapq),
+}
+
+def alloc_stepper(ffi_main, ffi_lib, alloc_func, axis):
+    if alloc_func == 'extruder_stepper_alloc':
+        return ffi_main.gc(ffi_lib.extruder_stepper_alloc(),
+                           ffi_lib.extruder_stepper_free)
+    return ffi_main.gc(getattr(ffi_lib, alloc_func)(axis.encode()),
+                       ffi_lib.free)
+
+# Select the analytic or iterative step time solver
+def setup_analytic(ffi_main, ffi_lib, sk, enable):
+    ffi_lib.itersolve_set_analytic(sk, enable)
+    return sk
+
+# Wrap the stepper kinematics with an input shaper that calculates the
+# shaped position with piecewise segments or with the convolution
+SHAPERS = {'x': ('mzv', 45.), 'y': ('2hump_ei', 39.), 'z': ('ei', 60.)}
+def setup_piecewise(ffi_main, ffi_lib, sk, enable):
+    is_sk = ffi_main.gc(ffi_lib.input_shaper_alloc(), ffi_lib.free)
+    ffi_lib.input_shaper_set_segments(is_sk, enable)
+    if ffi_lib.input_shaper_set_sk(is_sk, sk) < 0:
+        return sk
+    shapers = {s.name: s for s in shaper_defs.INPUT_SHAPERS}
+    for axis, (shaper_type, freq) in sorted(SHAPERS.items()):
+        A, T = shaper_defs.get_shaper_pulses(
+            shapers[shaper_type], freq, shaper_defs.DEFAULT_DAMPING_RATIO)
+        ffi_lib.input_shaper_set_shaper_params(is_sk, axis.encode(),
+                                               len(A), A, T)
+    return is_sk
+
+# Enable or disable the pressure advance integral cache (and change
+# the pressure advance value every half second)
+PA_SMOOTH_TIME = .040
+PA_VALUES = [.05, .1, 0., .02, .2]
+def setup_pa_cache(ffi_main, ffi_lib, sk, enable):
+    ffi_lib.extruder_set_integral_cache(sk, enable)
+    for i in range(200):
+        ffi_lib.extruder_set_pressure_advance(
+            sk, .100 + .5 * i, PA_VALUES[i % len(PA_VALUES)], PA_SMOOTH_TIME)
+    return sk
+
+# Each check compares the steps generated with the setup function
+# enabled against the steps generated with it disabled
+CHECKS = {
+    'analytic': ("analytic", "iterative", setup_analytic,
+                 ['cartesian', 'corexy']),
+    'piecewise': ("piecewise", "convolution", setup_piecewise,
+                  ['cartesian', 'corexy']),
+    'pa_cache': ("cached", "direct", setup_pa_cache, ['extruder']),
+}
+
+# Generate the steps of a random move sequence and return the step
+# times (in mcu clock ticks) of each stepper as a list of (clock, dir)
+def gen_steps(kin, seed, count, setup, enable):
+    ffi_main, ffi_lib = chelper.get_ffi()
+    alloc_func, axes, step_dist, fill_func = KINEMATICS[kin]
+    ssm = ffi_main.gc(ffi_lib.steppersyncmgr_alloc(),
+                      ffi_lib.steppersyncmgr_free)
+    ss = ffi_lib.steppersyncmgr_alloc_steppersync(ssm)
+    tq = ffi_main.gc(ffi_lib.trapq_alloc(), ffi_lib.trapq_free)
+    steppers = []
+    for oid, axis in enumerate(axes):
+        se = ffi_lib.steppersync_alloc_syncemitter(ss, axis.encode(), True)
+        sc = ffi_lib.syncemitter_get_stepcompress(se)
+        # Store every step time exactly (no compression error)
+        ffi_lib.stepcompress_fill(sc, oid, 0, 1, 2)
+        orig_sk = alloc_stepper(ffi_main, ffi_lib, alloc_func, axis)
+        sk = setup(ffi_main, ffi_lib, orig_sk, enable)
+        ffi_lib.itersolve_set_position(sk, 100., 100., 100.)
+        ffi_lib.itersolve_set_trapq(sk, tq, step_dist)
+        ffi_lib.syncemitter_set_stepper_kinematics(se, sk)
+        steppers.append((sc, sk, orig_sk))
+    fd = os.open(os.devnull, os.O_RDWR)
+    sq = ffi_lib.serialqueue_alloc(fd, b'f', 0, b'test')
+    ffi_lib.steppersync_setup_movequeue(ss, sq, 1000000)
+    ffi_lib.steppersync_set_time(ss, 0., MCU_FREQ)
+    end_time = fill_func(ffi_lib, tq, random.Random(seed), count)
+    flush_time = 0.
+    while flush_time < end_time:
+        flush_time = min(flush_time + FLUSH_TIME, end_time)
+        ret = ffi_lib.steppersyncmgr_gen_steps(ssm, flush_time, flush_time,
+                                               0.)
+        if ret:
+            raise Exception("Internal error in step generation")
+    # Extract the step times from the step history
+    results = []
+    for sc, sk, orig_sk in steppers:
+        max_hist = 1 << 20
+        hist = ffi_main.new('struct pull_history_steps[]', max_hist)
+        hcount = ffi_lib.stepcompress_extract_old(sc, hist, max_hist,
+                                                  0, 1 << 62)
+        steps = []
+        for i in range(hcount - 1, -1, -1):
+            h = hist[i]
+            sdir = h.step_count > 0
+            for k in range(abs(h.step_count)):
+                clock = h.first_clock + k * h.interval + h.add * k*(k-1)//2
+                steps.append((clock, sdir))
+        results.append(steps)
+    ffi_lib.serialqueue_exit(sq)
+    ffi_lib.serialqueue_free(sq)
+    os.close(fd)
+    return results
+
+def check(check_name, kin, seed, count):
+    name_on, name_off, setup, kinematics = CHECKS[check_name]
+    steps_on = gen_steps(kin, seed, count, setup, True)
+    steps_off = gen_steps(kin, seed, count, setup, False)
+    max_diff = 0
+    total = 0
+    for axis, a_steps, b_steps in zip(KINEMATICS[kin][1], steps_on,
+                                      steps_off):
+        if len(a_steps) != len(b_steps):
+            raise Exception("%s seed %d stepper '%s': %d vs %d steps" % (
+                kin, seed, axis, len(a_steps), len(b_steps)))
+        for n, ((a_clock, a_dir), (b_clock, b_dir)) in enumerate(
+                zip(a_steps, b_steps)):
+            diff = abs(a_clock - b_clock)
+            if a_dir != b_dir or diff > MAX_STEP_DIFF * MCU_FREQ:
+                raise Exception(
+                    "%s seed %d stepper '%s' step %d: %s=%d/%d %s=%d/%d"
+                    % (kin, seed, axis, n, name_on, a_clock, a_dir,
+                       name_off, b_clock, b_dir))
+            max_diff = max(max_diff, diff)
+        total += len(a_steps)
+    return total, max_diff
+
+def main():
+    usage = "%prog [options]"
+    opts = optparse.OptionParser(usage)
+    opts.add_option("-s", "--seeds", type="int", dest="seeds", default=10,
+                    help="number of random move sequences per kinematics")
+    opts.add_option("-n", "--moves", type="int", dest="moves", default=300,
+                    help="number of moves in each sequence")
+    opts.add_option("-c", "--check", type="choice", dest="check",
+                    choices=sorted(CHECKS), action="append",
+                    help="run only the given check (%s)"
+                    % (", ".join(sorted(CHECKS)),))
+    options, args = opts.parse_args()
+    if args:
+        opts.error("Incorrect number of arguments")
+    for check_name in options.check or sorted(CHECKS):
+        for kin in CHECKS[check_name][3]:
+            total = max_diff = 0
+            try:
+                for seed in range(options.seeds):
+                    steps, diff = check(check_name, kin, seed, options.moves)
+                    total += steps
+                    max_diff = max(max_diff, diff)
+            except Exception as e:
+                print("ERROR: %s: %s" % (check_name, str(e)))
+                sys.exit(1)
+            print("%-9s %-9s %8d steps - max step time difference %d ticks"
+                  " - ok" % (check_name, kin, total, max_diff))
+
+if __name__ == '__main__':
+    main()
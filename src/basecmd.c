@@ -252,6 +252,12 @@ DECL_COMMAND_FLAGS(command_get_config, HF_IN_SHUTDOWN, "get_config");
 void
 command_finalize_config(uint32_t *args)
 {
+    // Each configured object may schedule a timer
+    uint8_t i, count = 0;
+    for (i = 0; i < oid_count; i++)
+        if (oids[i].type)
+            count++;
+    sched_check_timer_count(count);
     move_finalize();
     config_crc = args[0];
 }
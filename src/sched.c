@@ -23,6 +23,17 @@ static struct {
     uint8_t shutdown_status, shutdown_reason;
 } SchedStatus = {.timer_list = &periodic_timer, .last_insert = &periodic_timer};
 
+#if CONFIG_WANT_SCHED_TIMER_HEAP
+#define TIMER_HEAP_SIZE CONFIG_SCHED_TIMER_HEAP_SIZE
+#else
+#define TIMER_HEAP_SIZE 1
+#endif
+
+static struct {
+    struct timer *timers[TIMER_HEAP_SIZE];
+    unsigned int count, reserved;
+} TimerHeap;
+
 
 /****************************************************************
  * Timers
@@ -81,6 +92,122 @@ insert_timer(struct timer *pos, struct timer *t, uint32_t waketime)
     prev->next = t;
 }
 
+// When CONFIG_WANT_SCHED_TIMER_HEAP is enabled, all pending timers
+// (other than the timer at SchedStatus.timer_list) are stored in a
+// binary min-heap ordered by waketime instead of on a sorted list.
+// This bounds the cost of adding and rescheduling a timer to
+// O(log n), which helps when many timers are active.  Note that the
+// sentinel_timer is not stored in the heap (its waketime is not
+// ordered relative to timers scheduled before periodic_timer).
+
+// Move timer 't' towards the leaves of the heap starting at 'pos'
+static void
+heap_sift_down(unsigned int pos, struct timer *t)
+{
+    struct timer **timers = TimerHeap.timers;
+    unsigned int count = TimerHeap.count;
+    uint32_t waketime = t->waketime;
+    for (;;) {
+        unsigned int child = pos * 2 + 1;
+        if (child >= count)
+            break;
+        struct timer *c = timers[child];
+        if (child + 1 < count
+            && timer_is_before(timers[child + 1]->waketime, c->waketime))
+            c = timers[++child];
+        if (!timer_is_before(c->waketime, waketime))
+            break;
+        timers[pos] = c;
+        pos = child;
+    }
+    timers[pos] = t;
+}
+
+// Move timer 't' towards the root of the heap starting at 'pos'
+static unsigned int
+heap_sift_up(unsigned int pos, struct timer *t)
+{
+    struct timer **timers = TimerHeap.timers;
+    uint32_t waketime = t->waketime;
+    while (pos) {
+        unsigned int parent = (pos - 1) / 2;
+        struct timer *p = timers[parent];
+        if (!timer_is_before(waketime, p->waketime))
+            break;
+        timers[pos] = p;
+        pos = parent;
+    }
+    timers[pos] = t;
+    return pos;
+}
+
+// Add a timer to the heap
+static void
+heap_insert(struct timer *t)
+{
+    unsigned int count = TimerHeap.count;
+    if (count >= ARRAY_SIZE(TimerHeap.timers)) {
+        try_shutdown("Too many timers");
+        return;
+    }
+    TimerHeap.count = count + 1;
+    heap_sift_up(count, t);
+}
+
+// Note timers (beyond the one timer of each oid) that a configured
+// object may schedule
+void
+sched_reserve_timers(uint_fast8_t count)
+{
+    TimerHeap.reserved += count;
+}
+
+// Number of timers that are not owned by an oid (periodic_timer and
+// the board wrap timer)
+#define HEAP_STATIC_TIMERS 2
+
+// Verify at config time that all the timers of the configured
+// objects fit in the heap (so that heap_insert() can not fail later)
+void
+sched_check_timer_count(uint_fast8_t oid_count)
+{
+    if (!CONFIG_WANT_SCHED_TIMER_HEAP)
+        return;
+    unsigned int max_timers = (oid_count + TimerHeap.reserved
+                               + HEAP_STATIC_TIMERS);
+    if (max_timers > TIMER_HEAP_SIZE)
+        shutdown("Too many timers for SCHED_TIMER_HEAP_SIZE");
+}
+
+// Remove and return the timer with the earliest waketime
+static struct timer *
+heap_pop(void)
+{
+    struct timer *first = TimerHeap.timers[0];
+    unsigned int count = --TimerHeap.count;
+    heap_sift_down(0, TimerHeap.timers[count]);
+    return first;
+}
+
+// Remove a timer from the heap (if present)
+static void
+heap_remove(struct timer *del)
+{
+    struct timer **timers = TimerHeap.timers;
+    unsigned int pos, count = TimerHeap.count;
+    for (pos = 0; pos < count; pos++)
+        if (timers[pos] == del)
+            break;
+    if (pos >= count)
+        return;
+    struct timer *last = timers[--count];
+    TimerHeap.count = count;
+    if (pos >= count)
+        return;
+    if (heap_sift_up(pos, last) == pos)
+        heap_sift_down(pos, last);
+}
+
 // Schedule a function call at a supplied time.
 void
 sched_add_timer(struct timer *add)
@@ -92,14 +219,22 @@ sched_add_timer(struct timer *add)
         // This timer is before all other scheduled timers
         if (timer_is_before(waketime, timer_read_time()))
             try_shutdown("Timer too close");
-        if (tl == &deleted_timer)
-            add->next = deleted_timer.next;
-        else
-            add->next = tl;
+        if (CONFIG_WANT_SCHED_TIMER_HEAP) {
+            if (tl != &deleted_timer)
+                heap_insert(tl);
+            heap_insert(add);
+        } else {
+            if (tl == &deleted_timer)
+                add->next = deleted_timer.next;
+            else
+                add->next = tl;
+            deleted_timer.next = add;
+        }
         deleted_timer.waketime = waketime;
-        deleted_timer.next = add;
         SchedStatus.timer_list = &deleted_timer;
         timer_kick();
+    } else if (CONFIG_WANT_SCHED_TIMER_HEAP) {
+        heap_insert(add);
     } else {
         insert_timer(tl, add, waketime);
     }
@@ -127,6 +262,8 @@ sched_del_timer(struct timer *del)
         deleted_timer.waketime = del->waketime;
         deleted_timer.next = del->next;
         SchedStatus.timer_list = &deleted_timer;
+    } else if (CONFIG_WANT_SCHED_TIMER_HEAP) {
+        heap_remove(del);
     } else {
         // Find and remove from timer list (if present)
         struct timer *pos;
@@ -160,6 +297,19 @@ sched_timer_dispatch(void)
 
     // Update timer_list (rescheduling current timer if necessary)
     unsigned int next_waketime = updated_waketime;
+    if (CONFIG_WANT_SCHED_TIMER_HEAP) {
+        struct timer *next = TimerHeap.timers[0];
+        if (unlikely(res == SF_DONE)) {
+            next_waketime = next->waketime;
+            SchedStatus.timer_list = heap_pop();
+        } else if (TimerHeap.count
+                   && !timer_is_before(updated_waketime, next->waketime)) {
+            next_waketime = next->waketime;
+            SchedStatus.timer_list = next;
+            heap_sift_down(0, t);
+        }
+        return next_waketime;
+    }
     if (unlikely(res == SF_DONE)) {
         next_waketime = t->next->waketime;
         SchedStatus.timer_list = t->next;
@@ -186,6 +336,10 @@ sched_timer_reset(void)
     deleted_timer.waketime = periodic_timer.waketime;
     deleted_timer.next = SchedStatus.last_insert = &periodic_timer;
     periodic_timer.next = &sentinel_timer;
+    if (CONFIG_WANT_SCHED_TIMER_HEAP) {
+        TimerHeap.timers[0] = &periodic_timer;
+        TimerHeap.count = 1;
+    }
     timer_kick();
 }
 
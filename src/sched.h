@@ -30,6 +30,8 @@ void sched_add_timer(struct timer*);
 void sched_del_timer(struct timer *del);
 unsigned int sched_timer_dispatch(void);
 void sched_timer_reset(void);
+void sched_reserve_timers(uint_fast8_t count);
+void sched_check_timer_count(uint_fast8_t oid_count);
 void sched_wake_tasks(void);
 uint8_t sched_check_set_tasks_busy(void);
 void sched_wake_task(struct task_wake *w);
@@ -73,6 +73,7 @@ command_config_trsync(uint32_t *args)
     struct trsync *ts = oid_alloc(args[0], command_config_trsync, sizeof(*ts));
     ts->report_time.func = trsync_report_event;
     ts->expire_time.func = trsync_expire_event;
+    sched_reserve_timers(1);
 }
 DECL_COMMAND(command_config_trsync, "config_trsync oid=%c");
 
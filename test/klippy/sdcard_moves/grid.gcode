@@ -0,0 +1,38 @@
+; Moves across the bed for the g-code cache move transform tests
+G90
+M83
+G1 Z0.3 F600
+G1 X10 Y10 F6000
+G1 X180.0 Y10.0 E8.5000
+G1 Y25.0 E0.7500
+G1 X10.0 Y25.0 E8.5000
+G1 Y40.0 E0.7500
+G1 X180.0 Y40.0 E8.5000
+G1 Y55.0 E0.7500
+G1 X10.0 Y55.0 E8.5000
+G1 Y70.0 E0.7500
+G1 X180.0 Y70.0 E8.5000
+G1 Y85.0 E0.7500
+G1 X10.0 Y85.0 E8.5000
+G1 Y100.0 E0.7500
+G91
+G1 Z0.2
+G90
+G1 Z1.0 F600
+G1 F6000
+G1 X180.0 Y100.0 E8.5000
+G1 Y115.0 E0.7500
+G1 X10.0 Y115.0 E8.5000
+G1 Y130.0 E0.7500
+G1 X180.0 Y130.0 E8.5000
+G1 Y145.0 E0.7500
+G1 X10.0 Y145.0 E8.5000
+G1 Y160.0 E0.7500
+G1 X180.0 Y160.0 E8.5000
+G1 Y175.0 E0.7500
+G1 X10.0 Y175.0 E8.5000
+G1 Y190.0 E0.7500
+G0 X100 Y100 Z5
+G1 X20 Y180 F3000
+G1 X180 Y20 Z8
+; Done